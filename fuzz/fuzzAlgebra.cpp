@@ -0,0 +1,403 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "fuzzAlgebra.hh"
+#include "interval/check.hh"
+#include "interval/interval_algebra.hh"
+#include "interval/interval_def.hh"
+#include "interval/reference_functions.hh"
+
+// libFuzzer entry point: the input bytes are decoded into two interval
+// arguments, every method of interval_algebra is called on them and the results
+// of the methods are compared with the numerical reference functions on
+// sample points of the arguments. A violation of a method without a baseline
+// aborts, hangs are detected by the -timeout option of the fuzzer.
+
+namespace itv {
+
+unsigned long gFuzzInputs = 0;
+unsigned long gFuzzViolations[kFuzzMethods] = {};
+
+//------------------------------------------------------------------------------------------
+// decoding of the input bytes
+
+class fuzz_input {
+    const uint8_t* fData;
+    size_t         fSize;
+    size_t         fPos{0};
+
+   public:
+    fuzz_input(const uint8_t* data, size_t size) : fData(data), fSize(size) {}
+
+    uint8_t byte() { return (fPos < fSize) ? fData[fPos++] : 0; }
+
+    uint64_t bits()
+    {
+        uint64_t b = 0;
+        for (int i = 0; i < 8; i++) b = (b << 8) | byte();
+        return b;
+    }
+
+    // a number, with a bias toward the special values
+    double number()
+    {
+        uint8_t c = byte();
+        switch (c % 12) {
+            case 0: return NAN;
+            case 1: return HUGE_VAL;
+            case 2: return -HUGE_VAL;
+            case 3: return ((c & 16) != 0) ? -0.0 : 0.0;
+            case 4: {  // subnormal
+                uint64_t b = bits() & 0x800FFFFFFFFFFFFFULL;
+                double   d;
+                std::memcpy(&d, &b, sizeof(d));
+                return d;
+            }
+            case 5: return ((c & 16) != 0) ? -DBL_MAX : DBL_MAX;
+            case 6: return ((c & 16) != 0) ? -DBL_MIN : DBL_MIN;
+            case 7: return double(int8_t(byte()));   // small integer
+            case 8: return double(int32_t(bits()));  // large integer
+            case 9: return double(int8_t(byte())) / 16.0;
+            default: {  // any double
+                uint64_t b = bits();
+                double   d;
+                std::memcpy(&d, &b, sizeof(d));
+                return d;
+            }
+        }
+    }
+
+    // an interval, possibly empty or unbounded, with a possibly negative lsb
+    interval itv()
+    {
+        double  a   = number();
+        double  b   = number();
+        int     lsb = int8_t(byte()) / 4;
+        return {a, b, lsb};
+    }
+
+    // a fraction in [0,1]
+    double fraction() { return byte() / 255.0; }
+};
+
+//------------------------------------------------------------------------------------------
+// numerical references, from reference_functions.hh and the standard library
+
+// the pole 0^y of y < 0 is +inf or -inf depending on the side of 0 and the parity of y, it is skipped
+static double myPow(double x, double y)
+{
+    return ((x == 0) && (y < 0)) ? NAN : std::pow(x, y);
+}
+
+struct unary_method {
+    const char* name;
+    ufun        f;
+    umth        m;
+    unsigned    baseline;  ///< violations allowed per million inputs, 0: soundness is asserted
+};
+
+struct binary_method {
+    const char* name;
+    bfun        f;
+    bmth        m;
+    unsigned    baseline;
+};
+
+// The methods with a baseline have known issues found by this harness or by
+// VerifyInterval (range reduction of huge arguments, quantization of the
+// arguments restricted to a domain, huge and fractional exponents of Pow when
+// x can be negative), their violations are counted until they are fixed. The
+// baselines are about 1.25 times the rates measured on the random inputs of the
+// replay driver, which fails when a rate grows past them: lower them when a
+// method improves.
+static const unary_method gUnary[] = {
+    {"Abs", fabs, &interval_algebra::Abs, 0},
+    {"Acos", acos, &interval_algebra::Acos, 0},
+    {"Acosh", acosh, &interval_algebra::Acosh, 0},
+    {"Asin", asin, &interval_algebra::Asin, 0},
+    {"Asinh", asinh, &interval_algebra::Asinh, 0},
+    {"Atan", atan, &interval_algebra::Atan, 0},
+    {"Atanh", atanh, &interval_algebra::Atanh, 1600},
+    {"Ceil", ceil, &interval_algebra::Ceil, 0},
+    {"Cos", cos, &interval_algebra::Cos, 4000},
+    {"Cosh", cosh, &interval_algebra::Cosh, 0},
+    {"Exp", exp, &interval_algebra::Exp, 0},
+    {"FloatCast", myId, &interval_algebra::FloatCast, 0},
+    {"Floor", floor, &interval_algebra::Floor, 0},
+    {"IntCast", myIntCast, &interval_algebra::IntCast, 0},
+    {"Inv", myInv, &interval_algebra::Inv, 0},
+    {"Log", log, &interval_algebra::Log, 0},
+    {"Log10", log10, &interval_algebra::Log10, 0},
+    {"Neg", myNeg, &interval_algebra::Neg, 0},
+    {"Not", myNot, &interval_algebra::Not, 0},
+    {"Rint", rint, &interval_algebra::Rint, 0},
+    {"Sin", sin, &interval_algebra::Sin, 4000},
+    {"Sinh", sinh, &interval_algebra::Sinh, 0},
+    {"Sqrt", sqrt, &interval_algebra::Sqrt, 0},
+    {"Tan", tan, &interval_algebra::Tan, 5800},
+    {"Tanh", tanh, &interval_algebra::Tanh, 0},
+};
+
+static const binary_method gBinary[] = {
+    {"Add", myAdd, &interval_algebra::Add, 0},
+    {"And", myAnd, &interval_algebra::And, 0},
+    {"Div", myDiv, &interval_algebra::Div, 0},
+    {"Eq", myEq, &interval_algebra::Eq, 0},
+    {"Ge", myGe, &interval_algebra::Ge, 0},
+    {"Gt", myGt, &interval_algebra::Gt, 0},
+    {"Le", myLe, &interval_algebra::Le, 0},
+    {"Lsh", myLsh, &interval_algebra::Lsh, 0},
+    {"Lt", myLt, &interval_algebra::Lt, 0},
+    {"Max", myMax, &interval_algebra::Max, 0},
+    {"Min", myMin, &interval_algebra::Min, 0},
+    {"Mod", fmod, &interval_algebra::Mod, 12500},
+    {"Mul", myMul, &interval_algebra::Mul, 0},
+    {"Ne", myNe, &interval_algebra::Ne, 0},
+    {"Or", myOr, &interval_algebra::Or, 0},
+    {"Pow", myPow, &interval_algebra::Pow, 20000},
+    {"Rsh", myRsh, &interval_algebra::Rsh, 0},
+    {"Sub", mySub, &interval_algebra::Sub, 0},
+    {"Xor", myXor, &interval_algebra::Xor, 0},
+};
+
+// the methods with more arguments, a table or a sample format, checked by fuzzOther(), their soundness is asserted
+enum other_method { kSelect2, kSelect3, kRdTbl, kWrTbl, kSoundfile, kOtherMethods };
+
+static const char* const gOther[kOtherMethods] = {"Select2", "Select3", "RdTbl", "WrTbl", "Soundfile"};
+
+constexpr int kUnaryMethods  = sizeof(gUnary) / sizeof(gUnary[0]);
+constexpr int kBinaryMethods = sizeof(gBinary) / sizeof(gBinary[0]);
+static_assert(kUnaryMethods + kBinaryMethods + kOtherMethods == kFuzzMethods,
+              "kFuzzMethods must count all the checked methods");
+
+const char* fuzzMethodName(int i)
+{
+    constexpr int U = kUnaryMethods, B = kBinaryMethods;
+    return (i < U) ? gUnary[i].name : (i < U + B) ? gBinary[i - U].name : gOther[i - U - B];
+}
+
+unsigned fuzzBaseline(int i)
+{
+    constexpr int U = kUnaryMethods, B = kBinaryMethods;
+    return (i < U) ? gUnary[i].baseline : (i < U + B) ? gBinary[i - U].baseline : 0;
+}
+
+//------------------------------------------------------------------------------------------
+// soundness checks
+
+// a point of x, at position t in [0,1]
+static double point(const interval& x, double t)
+{
+    if (t <= 0) return x.lo();
+    if (t >= 1) return x.hi();
+    double v = x.lo() + t * (x.hi() - x.lo());
+    return std::isnan(v) ? std::clamp(0.0, x.lo(), x.hi()) : std::clamp(v, x.lo(), x.hi());  // NAN for ]-inf,+inf[
+}
+
+// the point with the sign of the interval when it is 0, as Inv and Div take the limit on the side of x: 1/x is
+// +inf on [0,hi] and -inf on [lo,0]
+static double sample(const interval& x, double t)
+{
+    double v = point(x, t);
+    if (v != 0) return v;
+    if (x.lo() >= 0) return 0.0;
+    if (x.hi() <= 0) return -0.0;
+    return v;
+}
+
+// the result z of the numerical function must be in Z, within a few lsb of Z or ulp of z
+static bool contains(const interval& Z, double z)
+{
+    if (std::isnan(z)) return true;  // undefined value, nothing to contain
+    if (Z.isEmpty()) return false;
+    if (Z.lo() == interval().lo() && Z.hi() == interval().hi()) return true;  // the full range, any value
+    if (std::isinf(z)) return Z.has(z);
+    double tol = 4 * std::max(std::ldexp(1.0, Z.lsb()), std::fabs(z) * DBL_EPSILON);
+    return (Z.lo() - tol <= z) && (z <= Z.hi() + tol);
+}
+
+static void violation(int index, const std::string& what, unsigned baseline)
+{
+    gFuzzViolations[index]++;
+    if (baseline == 0) {
+        std::cerr << "UNSOUND " << what << std::endl;
+        std::abort();
+    }
+}
+
+static void fuzzUnary(int index, const unary_method& u, const interval& x, const double* t, int n)
+{
+    interval_algebra A;
+    interval         z = (A.*u.m)(x);
+    if (x.isEmpty()) return;
+    for (int i = 0; i < n; i++) {
+        double v = sample(x, t[i]);
+        double r = u.f(v);
+        if (!contains(z, r)) {
+            std::ostringstream ss;
+            ss << u.name << "(" << x << ") = " << z << " misses " << u.name << "(" << v << ") = " << r;
+            violation(index, ss.str(), u.baseline);
+            return;
+        }
+    }
+}
+
+static void fuzzBinary(int index, const binary_method& b, const interval& x, const interval& y, const double* t,
+                       int n)
+{
+    interval_algebra A;
+    interval         z = (A.*b.m)(x, y);
+    if (x.isEmpty() || y.isEmpty()) return;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            double v = sample(x, t[i]);
+            double w = sample(y, t[j]);
+            double r = b.f(v, w);
+            if (!contains(z, r)) {
+                std::ostringstream ss;
+                ss << b.name << "(" << x << "," << y << ") = " << z << " misses " << b.name << "(" << v << "," << w
+                   << ") = " << r;
+                violation(index, ss.str(), b.baseline);
+                return;
+            }
+        }
+    }
+}
+
+// the results r of the reference on the sample points of the arguments must be in z
+static bool fuzzOther(other_method m, const interval& z, const std::vector<interval>& args,
+                      const std::vector<double>& r)
+{
+    for (double v : r) {
+        if (!contains(z, v)) {
+            std::ostringstream ss;
+            ss << gOther[m] << "(";
+            for (size_t i = 0; i < args.size(); i++) ss << ((i > 0) ? "," : "") << args[i];
+            ss << ") = " << z << " misses " << v;
+            violation(kUnaryMethods + kBinaryMethods + m, ss.str(), 0);
+            return false;
+        }
+    }
+    return true;
+}
+
+// select2(s,a,b) is a when int(s) == 0, b otherwise, select3(s,a,b,c) is c when int(s) isn't 0 or 1
+static double select(double s, double a, double b, double c)
+{
+    int i = saturatedIntCast(s);
+    return (i == 0) ? a : ((i == 1) ? b : c);
+}
+
+// Select2(x,y,z), Select3(x,y,z,y), a table of the points of y and z read at x, a table of 4 values
+// initialized with y and written with z at x, and the samples of bits of a soundfile read at x
+static void fuzzOthers(const interval& x, const interval& y, const interval& z, int bits, const double* t, int n)
+{
+    interval_algebra A;
+    interval         s2 = A.Select2(x, y, z);
+    interval         s3 = A.Select3(x, y, z, y);
+    interval         w  = A.WrTbl(interval(4, 4, 0), y, x, z);
+    interval         sf = A.Soundfile(x, bits);
+    if (x.isEmpty() || y.isEmpty() || z.isEmpty()) return;
+
+    std::vector<double> values;
+    std::vector<float>  floats;
+    for (int i = 0; i < n; i++) {
+        double s = sample(x, t[i]);
+        for (int j = 0; j < n; j++) {
+            double a = sample(y, t[j]), b = sample(z, t[(i + j) % n]);
+            if (!fuzzOther(kSelect2, s2, {x, y, z}, {select(s, a, b, b)}) ||
+                !fuzzOther(kSelect3, s3, {x, y, z, y}, {select(s, a, b, a)}) ||
+                !fuzzOther(kWrTbl, w, {interval(4, 4, 0), y, x, z}, {a, b})) {
+                return;
+            }
+        }
+        values.push_back(sample(y, t[i]));
+        values.push_back(sample(z, t[i]));
+    }
+    for (double v : values) floats.push_back(float(v));
+    interval td = A.RdTbl(A.tableContent(values.data(), values.size()), x);
+    interval tf = A.RdTbl(A.tableContent(floats.data(), floats.size()), x);
+    for (size_t i = 0; i < values.size(); i++) {
+        if (!fuzzOther(kRdTbl, td, {y, z, x}, {values[i]}) || !fuzzOther(kRdTbl, tf, {y, z, x}, {floats[i]})) return;
+    }
+
+    // some integer samples of b bits, normalized, or any finite float or double
+    std::vector<double> samples;
+    for (int i = 0; i < n; i++) {
+        if ((bits >= 2) && (bits <= 31)) {
+            double m = std::ldexp(1.0, bits - 1);
+            samples.push_back((std::floor(t[i] * (2 * m - 1)) - m) / m);
+        } else if ((bits == 32) && std::isfinite(float(values[i]))) {
+            samples.push_back(float(values[i]));
+        } else if ((bits == 64) && std::isfinite(values[i])) {
+            samples.push_back(values[i]);
+        }
+    }
+    fuzzOther(kSoundfile, sf, {x, interval(bits)}, samples);
+}
+
+void fuzzAlgebra(const uint8_t* data, size_t size)
+{
+    fuzz_input       in(data, size);
+    interval_algebra A;
+    gFuzzInputs++;
+
+    interval x = in.itv();
+    interval y = in.itv();
+    double   t[4]{0.0, 1.0, in.fraction(), in.fraction()};
+
+    // methods without numerical reference, they must just terminate
+    A.Label("fuzz");
+    A.IntNum(saturatedIntCast(x.lo()));
+    A.FloatNum(x.hi());
+    A.Button(x);
+    A.Checkbox(x);
+    A.HSlider(x, x, x, y, y);
+    A.VSlider(x, x, x, y, y);
+    A.NumEntry(x, x, x, y, y);
+    A.Atan2(x, y);
+    A.Delay(x, y);
+    A.Mem(x);
+    A.Remainder(x);
+    A.Mod(x, y.lo());
+
+    for (int i = 0; i < kUnaryMethods; i++) fuzzUnary(i, gUnary[i], x, t, 4);
+    for (int i = 0; i < kBinaryMethods; i++) fuzzBinary(kUnaryMethods + i, gBinary[i], x, y, t, 4);
+
+    // the arguments of the other methods are decoded after, the inputs of the methods above are unchanged
+    constexpr int formats[]{8, 16, 24, 32, 64};
+    interval      z    = in.itv();
+    int           f    = in.byte() % 6;
+    int           bits = (f < 5) ? formats[f] : 2 + in.byte() % 30;
+    fuzzOthers(x, y, z, bits, t, 4);
+}
+
+}  // namespace itv
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    itv::fuzzAlgebra(data, size);
+    return 0;
+}
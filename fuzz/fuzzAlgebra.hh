@@ -0,0 +1,39 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace itv {
+
+// number of methods checked against a numerical reference
+constexpr int kFuzzMethods = 49;
+
+// number of inputs run and of soundness violations found for each checked method
+extern unsigned long gFuzzInputs;
+extern unsigned long gFuzzViolations[kFuzzMethods];
+
+const char* fuzzMethodName(int i);
+
+// number of violations of a method allowed per million inputs, 0 when its soundness is asserted
+unsigned fuzzBaseline(int i);
+
+// decode the bytes into interval arguments and run all the methods of interval_algebra on them
+void fuzzAlgebra(const uint8_t* data, size_t size);
+
+}  // namespace itv
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
@@ -0,0 +1,96 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "fuzzAlgebra.hh"
+
+// Driver used when the compiler doesn't provide libFuzzer: it replays the
+// corpus files and directories given as arguments, then runs random inputs
+// until -runs=N inputs or -max_total_time=S seconds are reached. The options
+// of libFuzzer it doesn't know are ignored, so the fuzz target works the same
+// with both drivers. The number of violations of the methods whose soundness
+// isn't asserted is reported at the end, and the driver fails when it exceeds
+// the baseline of the method: the inputs are reproducible, it is a regression.
+
+static void replayFile(const std::filesystem::path& p)
+{
+    std::ifstream        f(p, std::ios::binary);
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    LLVMFuzzerTestOneInput(data.data(), data.size());
+}
+
+int main(int argc, char* argv[])
+{
+    long     runs    = -1;
+    long     seconds = 0;
+    unsigned files   = 0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("-runs=", 0) == 0) {
+            runs = std::atol(arg.c_str() + 6);
+        } else if (arg.rfind("-max_total_time=", 0) == 0) {
+            seconds = std::atol(arg.c_str() + 16);
+        } else if (arg[0] == '-') {
+            continue;  // libFuzzer option
+        } else if (std::filesystem::is_directory(arg)) {
+            for (const auto& e : std::filesystem::directory_iterator(arg)) {
+                if (e.is_regular_file()) {
+                    replayFile(e.path());
+                    files++;
+                }
+            }
+        } else if (std::filesystem::exists(arg)) {
+            replayFile(arg);
+            files++;
+        }
+    }
+    std::cout << "replayed " << files << " files" << std::endl;
+
+    if (runs < 0) runs = (seconds > 0) ? -1 : 0;
+    std::mt19937_64      rng(0);
+    std::vector<uint8_t> data;
+    auto                 start = std::chrono::steady_clock::now();
+    long                 n     = 0;
+    for (; (runs < 0) || (n < runs); n++) {
+        if ((seconds > 0) && (std::chrono::steady_clock::now() - start > std::chrono::seconds(seconds))) break;
+        data.resize(rng() % 64);
+        for (auto& b : data) b = uint8_t(rng());
+        LLVMFuzzerTestOneInput(data.data(), data.size());
+    }
+    std::cout << "ran " << n << " random inputs" << std::endl;
+
+    int status = 0;
+    for (int i = 0; i < itv::kFuzzMethods; i++) {
+        unsigned long v = itv::gFuzzViolations[i];
+        if (v == 0) continue;
+        double allowed = double(itv::fuzzBaseline(i)) * double(itv::gFuzzInputs) / 1e6;
+        std::cout << itv::fuzzMethodName(i) << ": " << v << " violations, " << allowed << " allowed";
+        if (double(v) > allowed) {
+            std::cout << " REGRESSION";
+            status = 1;
+        }
+        std::cout << std::endl;
+    }
+    return status;
+}
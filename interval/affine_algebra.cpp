@@ -0,0 +1,530 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include "affine_algebra.hh"
+#include "affine_form.hh"
+#include "check.hh"
+
+namespace itv {
+
+// relative slack added to the new terms to cover the rounding errors
+static constexpr double kSlack = 4 * DBL_EPSILON;
+
+//------------------------------------------------------------------------------------------
+// construction of the results
+
+// keep the fMaxTerms-1 largest terms of x and condense the others into a fresh symbol
+affine_form affine_algebra::condense(affine_form x) const
+{
+    if (x.terms().size() <= fMaxTerms) return x;
+    std::vector<noise_term> terms = x.terms();
+    std::nth_element(terms.begin(), terms.begin() + long(fMaxTerms - 1), terms.end(),
+                     [](const noise_term& a, const noise_term& b) { return std::fabs(a.coef) > std::fabs(b.coef); });
+    double rest = 0;
+    for (size_t i = fMaxTerms - 1; i < terms.size(); i++) rest += std::fabs(terms[i].coef);
+    terms.resize(fMaxTerms - 1);
+    std::sort(terms.begin(), terms.end(), [](const noise_term& a, const noise_term& b) { return a.symbol < b.symbol; });
+    terms.push_back({newNoiseSymbol(), rest * (1 + kSlack)});  // the newest symbol is the largest
+    return {x.center(), terms};
+}
+
+// a.x + b.y + c, with a fresh term of radius delta (plus the rounding errors)
+static affine_form combine(double a, const affine_form& x, double b, const affine_form& y, double c, double delta)
+{
+    const auto&             tx = x.terms();
+    const auto&             ty = y.terms();
+    std::vector<noise_term> terms;
+    terms.reserve(tx.size() + ty.size() + 1);
+
+    double center = a * x.center() + b * y.center() + c;
+    double error  = delta + kSlack * std::fabs(center);
+    size_t i = 0, j = 0;
+    while ((i < tx.size()) || (j < ty.size())) {
+        noise_term t{};
+        if ((j == ty.size()) || ((i < tx.size()) && (tx[i].symbol < ty[j].symbol))) {
+            t = {tx[i].symbol, a * tx[i].coef};
+            i++;
+        } else if ((i == tx.size()) || (ty[j].symbol < tx[i].symbol)) {
+            t = {ty[j].symbol, b * ty[j].coef};
+            j++;
+        } else {
+            t = {tx[i].symbol, a * tx[i].coef + b * ty[j].coef};
+            i++;
+            j++;
+        }
+        error += kSlack * std::fabs(t.coef);
+        if (t.coef != 0) terms.push_back(t);
+    }
+    if (error != 0) terms.push_back({newNoiseSymbol(), error});
+    return {center, terms};
+}
+
+// alpha.x + zeta + delta.e for a fresh symbol e
+affine_form affine_algebra::linear(const affine_form& x, double alpha, double zeta, double delta) const
+{
+    return condense(combine(alpha, x, 0, affine_form(0), zeta, delta));
+}
+
+affine_form affine_algebra::apply(umth m, const affine_form& x) const
+{
+    return affine_form::fromInterval((fAlgebra.*m)(x.toInterval()));
+}
+
+affine_form affine_algebra::apply(bmth m, const affine_form& x, const affine_form& y) const
+{
+    return affine_form::fromInterval((fAlgebra.*m)(x.toInterval(), y.toInterval()));
+}
+
+/**
+ * @brief The min-range approximation of a convex or concave monotonic function f on [a,b]:
+ * alpha is the derivative of f of smallest magnitude on [a,b], so that f(x) - alpha.x is
+ * monotonic and its range is [zeta-delta, zeta+delta].
+ */
+template <typename F>
+static void minRange(F f, double a, double b, double alpha, double& zeta, double& delta)
+{
+    double da = f(a) - alpha * a;
+    double db = f(b) - alpha * b;
+    zeta      = da + (db - da) / 2;
+    delta     = std::fabs(db - da) / 2 + kSlack * (std::fabs(da) + std::fabs(db));
+}
+
+//------------------------------------------------------------------------------------------
+// affine methods
+
+affine_form affine_algebra::IntNum(int x) const
+{
+    return affine_form(x);
+}
+
+affine_form affine_algebra::FloatNum(double x) const
+{
+    return affine_form(x);
+}
+
+affine_form affine_algebra::Add(const affine_form& x, const affine_form& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return affine_form(NAN);
+    if (!x.isBounded() || !y.isBounded()) return apply(&interval_algebra::Add, x, y);
+    return condense(combine(1, x, 1, y, 0, 0));
+}
+
+affine_form affine_algebra::Sub(const affine_form& x, const affine_form& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return affine_form(NAN);
+    if (!x.isBounded() || !y.isBounded()) return apply(&interval_algebra::Sub, x, y);
+    return condense(combine(1, x, -1, y, 0, 0));
+}
+
+affine_form affine_algebra::Neg(const affine_form& x) const
+{
+    if (x.isEmpty()) return x;
+    if (!x.isBounded()) return apply(&interval_algebra::Neg, x);
+    std::vector<noise_term> terms = x.terms();
+    for (auto& t : terms) t.coef = -t.coef;
+    return {-x.center(), terms};
+}
+
+affine_form affine_algebra::Mul(const affine_form& x, const affine_form& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return affine_form(NAN);
+    if (!x.isBounded() || !y.isBounded()) return apply(&interval_algebra::Mul, x, y);
+    // (x0 + X)(y0 + Y) = x0.y0 + y0.X + x0.Y + X.Y, where |X.Y| <= rad(x).rad(y)
+    affine_form r = combine(y.center(), x, x.center(), y, -x.center() * y.center(), x.radius() * y.radius());
+    return condense(r);
+}
+
+affine_form affine_algebra::Inv(const affine_form& x) const
+{
+    interval X = x.toInterval();
+    if (!x.isBounded() || X.hasZero()) return apply(&interval_algebra::Inv, x);
+    double a = X.lo(), b = X.hi();
+    double alpha = (a > 0) ? -1 / (b * b) : -1 / (a * a);  // smallest |1/x^2| on [a,b]
+    double zeta, delta;
+    minRange([](double v) { return 1 / v; }, a, b, alpha, zeta, delta);
+    return linear(x, alpha, zeta, delta);
+}
+
+affine_form affine_algebra::Div(const affine_form& x, const affine_form& y) const
+{
+    return Mul(x, Inv(y));
+}
+
+affine_form affine_algebra::Sqrt(const affine_form& x) const
+{
+    interval X = x.toInterval();
+    if (!x.isBounded() || (X.lo() < 0) || (X.hi() == 0)) return apply(&interval_algebra::Sqrt, x);
+    double zeta, delta;
+    double alpha = 1 / (2 * std::sqrt(X.hi()));
+    minRange([](double v) { return std::sqrt(v); }, X.lo(), X.hi(), alpha, zeta, delta);
+    return linear(x, alpha, zeta, delta);
+}
+
+affine_form affine_algebra::Exp(const affine_form& x) const
+{
+    interval X = x.toInterval();
+    if (!x.isBounded() || (X.hi() > 700)) return apply(&interval_algebra::Exp, x);
+    double zeta, delta;
+    double alpha = std::exp(X.lo());
+    minRange([](double v) { return std::exp(v); }, X.lo(), X.hi(), alpha, zeta, delta);
+    return linear(x, alpha, zeta, delta);
+}
+
+affine_form affine_algebra::Log(const affine_form& x) const
+{
+    interval X = x.toInterval();
+    if (!x.isBounded() || (X.lo() <= 0)) return apply(&interval_algebra::Log, x);
+    double zeta, delta;
+    double alpha = 1 / X.hi();
+    minRange([](double v) { return std::log(v); }, X.lo(), X.hi(), alpha, zeta, delta);
+    return linear(x, alpha, zeta, delta);
+}
+
+//------------------------------------------------------------------------------------------
+// methods computed on the ranges of the arguments
+
+affine_form affine_algebra::Label(const std::string& x) const
+{
+    return affine_form::fromInterval(fAlgebra.Label(x));
+}
+
+affine_form affine_algebra::Button(const affine_form& name) const
+{
+    return apply(&interval_algebra::Button, name);
+}
+
+affine_form affine_algebra::Checkbox(const affine_form& name) const
+{
+    return apply(&interval_algebra::Checkbox, name);
+}
+
+affine_form affine_algebra::VSlider(const affine_form& name, const affine_form& init, const affine_form& lo,
+                                    const affine_form& hi, const affine_form& step) const
+{
+    return affine_form::fromInterval(
+        fAlgebra.VSlider(name.toInterval(), init.toInterval(), lo.toInterval(), hi.toInterval(), step.toInterval()));
+}
+
+affine_form affine_algebra::HSlider(const affine_form& name, const affine_form& init, const affine_form& lo,
+                                    const affine_form& hi, const affine_form& step) const
+{
+    return affine_form::fromInterval(
+        fAlgebra.HSlider(name.toInterval(), init.toInterval(), lo.toInterval(), hi.toInterval(), step.toInterval()));
+}
+
+affine_form affine_algebra::NumEntry(const affine_form& name, const affine_form& init, const affine_form& lo,
+                                     const affine_form& hi, const affine_form& step) const
+{
+    return affine_form::fromInterval(
+        fAlgebra.NumEntry(name.toInterval(), init.toInterval(), lo.toInterval(), hi.toInterval(), step.toInterval()));
+}
+
+affine_form affine_algebra::Abs(const affine_form& x) const
+{
+    return apply(&interval_algebra::Abs, x);
+}
+
+affine_form affine_algebra::Mod(const affine_form& x, const affine_form& y) const
+{
+    return apply(static_cast<bmth>(&interval_algebra::Mod), x, y);
+}
+
+affine_form affine_algebra::Acos(const affine_form& x) const
+{
+    return apply(&interval_algebra::Acos, x);
+}
+
+affine_form affine_algebra::Acosh(const affine_form& x) const
+{
+    return apply(&interval_algebra::Acosh, x);
+}
+
+affine_form affine_algebra::And(const affine_form& x, const affine_form& y) const
+{
+    return apply(&interval_algebra::And, x, y);
+}
+
+affine_form affine_algebra::Asin(const affine_form& x) const
+{
+    return apply(&interval_algebra::Asin, x);
+}
+
+affine_form affine_algebra::Asinh(const affine_form& x) const
+{
+    return apply(&interval_algebra::Asinh, x);
+}
+
+affine_form affine_algebra::Atan(const affine_form& x) const
+{
+    return apply(&interval_algebra::Atan, x);
+}
+
+affine_form affine_algebra::Atan2(const affine_form& x, const affine_form& y) const
+{
+    return apply(&interval_algebra::Atan2, x, y);
+}
+
+affine_form affine_algebra::Atanh(const affine_form& x) const
+{
+    return apply(&interval_algebra::Atanh, x);
+}
+
+affine_form affine_algebra::Ceil(const affine_form& x) const
+{
+    return apply(&interval_algebra::Ceil, x);
+}
+
+affine_form affine_algebra::Cos(const affine_form& x) const
+{
+    return apply(&interval_algebra::Cos, x);
+}
+
+affine_form affine_algebra::Cosh(const affine_form& x) const
+{
+    return apply(&interval_algebra::Cosh, x);
+}
+
+affine_form affine_algebra::Delay(const affine_form& x, const affine_form& y) const
+{
+    return apply(&interval_algebra::Delay, x, y);
+}
+
+affine_form affine_algebra::Eq(const affine_form& x, const affine_form& y) const
+{
+    return apply(&interval_algebra::Eq, x, y);
+}
+
+affine_form affine_algebra::FloatCast(const affine_form& x) const
+{
+    return apply(&interval_algebra::FloatCast, x);
+}
+
+affine_form affine_algebra::Floor(const affine_form& x) const
+{
+    return apply(&interval_algebra::Floor, x);
+}
+
+affine_form affine_algebra::Ge(const affine_form& x, const affine_form& y) const
+{
+    return apply(&interval_algebra::Ge, x, y);
+}
+
+affine_form affine_algebra::Gt(const affine_form& x, const affine_form& y) const
+{
+    return apply(&interval_algebra::Gt, x, y);
+}
+
+affine_form affine_algebra::IntCast(const affine_form& x) const
+{
+    return apply(&interval_algebra::IntCast, x);
+}
+
+affine_form affine_algebra::Le(const affine_form& x, const affine_form& y) const
+{
+    return apply(&interval_algebra::Le, x, y);
+}
+
+affine_form affine_algebra::Log10(const affine_form& x) const
+{
+    return apply(&interval_algebra::Log10, x);
+}
+
+affine_form affine_algebra::Lsh(const affine_form& x, const affine_form& y) const
+{
+    return apply(&interval_algebra::Lsh, x, y);
+}
+
+affine_form affine_algebra::Lt(const affine_form& x, const affine_form& y) const
+{
+    return apply(&interval_algebra::Lt, x, y);
+}
+
+affine_form affine_algebra::Max(const affine_form& x, const affine_form& y) const
+{
+    return apply(&interval_algebra::Max, x, y);
+}
+
+affine_form affine_algebra::Mem(const affine_form& x) const
+{
+    return apply(&interval_algebra::Mem, x);
+}
+
+affine_form affine_algebra::Min(const affine_form& x, const affine_form& y) const
+{
+    return apply(&interval_algebra::Min, x, y);
+}
+
+affine_form affine_algebra::Ne(const affine_form& x, const affine_form& y) const
+{
+    return apply(&interval_algebra::Ne, x, y);
+}
+
+affine_form affine_algebra::Not(const affine_form& x) const
+{
+    return apply(&interval_algebra::Not, x);
+}
+
+affine_form affine_algebra::Or(const affine_form& x, const affine_form& y) const
+{
+    return apply(&interval_algebra::Or, x, y);
+}
+
+affine_form affine_algebra::Pow(const affine_form& x, const affine_form& y) const
+{
+    return apply(&interval_algebra::Pow, x, y);
+}
+
+// the values read at different indices are independent, the summary of the table gets a fresh symbol
+affine_form affine_algebra::RdTbl(const affine_form& tbl, const affine_form& index) const
+{
+    return apply(&interval_algebra::RdTbl, tbl, index);
+}
+
+affine_form affine_algebra::Remainder(const affine_form& x) const
+{
+    return apply(&interval_algebra::Remainder, x);
+}
+
+affine_form affine_algebra::Rint(const affine_form& x) const
+{
+    return apply(&interval_algebra::Rint, x);
+}
+
+affine_form affine_algebra::Rsh(const affine_form& x, const affine_form& y) const
+{
+    return apply(&interval_algebra::Rsh, x, y);
+}
+
+// a single reachable branch is kept with its noise symbols, several ones are gathered in their hull
+static affine_form select(unsigned b, std::initializer_list<const affine_form*> branches)
+{
+    interval r(NAN, NAN);
+    int      n = 0, last = 0;
+    for (int i = 0; i < int(branches.size()); i++) {
+        if ((b & (1U << i)) == 0) continue;
+        r    = reunion(r, branches.begin()[i]->toInterval());
+        last = i;
+        n++;
+    }
+    return (n == 1) ? *branches.begin()[last] : affine_form::fromInterval(r);
+}
+
+affine_form affine_algebra::Select2(const affine_form& s, const affine_form& x, const affine_form& y) const
+{
+    return select(fAlgebra.selectBranches(s.toInterval(), 2), {&x, &y});
+}
+
+affine_form affine_algebra::Select3(const affine_form& s, const affine_form& x, const affine_form& y,
+                                    const affine_form& z) const
+{
+    return select(fAlgebra.selectBranches(s.toInterval(), 3), {&x, &y, &z});
+}
+
+affine_form affine_algebra::Sin(const affine_form& x) const
+{
+    return apply(&interval_algebra::Sin, x);
+}
+
+affine_form affine_algebra::Sinh(const affine_form& x) const
+{
+    return apply(&interval_algebra::Sinh, x);
+}
+
+affine_form affine_algebra::Tan(const affine_form& x) const
+{
+    return apply(&interval_algebra::Tan, x);
+}
+
+affine_form affine_algebra::Tanh(const affine_form& x) const
+{
+    return apply(&interval_algebra::Tanh, x);
+}
+
+affine_form affine_algebra::WrTbl(const affine_form& n, const affine_form& init,
+                                  const affine_form& index, const affine_form& value) const
+{
+    return affine_form::fromInterval(
+        fAlgebra.WrTbl(n.toInterval(), init.toInterval(), index.toInterval(), value.toInterval()));
+}
+
+affine_form affine_algebra::Xor(const affine_form& x, const affine_form& y) const
+{
+    return apply(&interval_algebra::Xor, x, y);
+}
+
+//------------------------------------------------------------------------------------------
+// tests
+
+void testAffine()
+{
+    affine_algebra   A;
+    interval_algebra I;
+    affine_form      x = affine_form::fromInterval(interval(0, 1));
+
+    interval    u = x.toInterval();
+    check("test affine fromInterval", u.has(0) && u.has(1) && (u.size() < 1 + 1e-6), true);
+    check("test affine Sub x-x", A.Sub(x, x).toInterval().size() < 1e-12, true);
+
+    // x*(1-x) is [0,1/4] on [0,1], intervals give [0,1]
+    interval p = A.Mul(x, A.Sub(A.FloatNum(1), x)).toInterval();
+    interval q = I.Mul(interval(0, 1), I.Sub(interval(1), interval(0, 1)));
+    testout() << "x*(1-x): affine " << p << ", interval " << q << '\n';
+    check("test affine Mul contains", (p.lo() <= 0) && (p.hi() >= 0.25), true);
+    check("test affine Mul tighter", p.size() < q.size(), true);
+
+    // a chain of 1st order filters y = 0.5*x + 0.5*y' keeps the correlations of x
+    affine_form y = x;
+    for (int i = 0; i < 10; i++) y = A.Add(A.Mul(A.FloatNum(0.5), x), A.Mul(A.FloatNum(0.5), y));
+    check("test affine chain", y.toInterval().size() < 1 + 1e-6, true);
+
+    // the term budget bounds the size of the forms
+    affine_algebra B(4);
+    affine_form    s = B.FloatNum(0);
+    for (int i = 0; i < 40; i++) s = B.Add(s, affine_form::fromInterval(interval(-1, 1)));
+    check("test affine budget", s.terms().size() <= 4, true);
+    check("test affine budget sound", s.toInterval().has(-40) && s.toInterval().has(40), true);
+
+    // min-range approximations contain the function
+    interval e = A.Exp(affine_form::fromInterval(interval(0, 1))).toInterval();
+    check("test affine Exp", (e.lo() <= 1) && (e.hi() >= std::exp(1.0)), true);
+    interval v = A.Inv(affine_form::fromInterval(interval(1, 2))).toInterval();
+    check("test affine Inv", (v.lo() <= 0.5) && (v.hi() >= 1), true);
+    interval l = A.Log(affine_form::fromInterval(interval(1, 10))).toInterval();
+    check("test affine Log", (l.lo() <= 0) && (l.hi() >= std::log(10.0)), true);
+
+    // the other methods go through the intervals, as precise as interval_algebra
+    check("test affine Sin", A.Sin(x).toInterval().hi() >= I.Sin(interval(0, 1)).hi(), true);
+    affine_form w = affine_form::fromInterval(interval(0, HUGE_VAL));
+    check("test affine unbounded", A.Add(w, x).toInterval().isUnbounded(), true);
+
+    // a single reachable branch keeps its noise symbols
+    check("test affine Select2", A.Sub(A.Select2(A.FloatNum(0), x, A.FloatNum(5)), x).toInterval().size() < 1e-12,
+          true);
+    affine_form sel = A.Select3(affine_form::fromInterval(interval(0, 2, 0)), x, A.FloatNum(5), A.FloatNum(7));
+    check("test affine Select3", sel.toInterval().has(7), true);
+
+    // two reads of a table are independent values
+    affine_form tbl = A.WrTbl(A.FloatNum(8), A.FloatNum(0), affine_form::fromInterval(interval(0, 7, 0)), x);
+    affine_form idx = affine_form::fromInterval(interval(0, 7, 0));
+    check("test affine RdTbl", A.Sub(A.RdTbl(tbl, idx), A.RdTbl(tbl, idx)).toInterval().has(1), true);
+}
+
+}  // namespace itv
@@ -0,0 +1,118 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <string>
+
+#include "affine_form.hh"
+#include "check.hh"
+#include "faust_algebra.hh"
+#include "interval_algebra.hh"
+
+namespace itv {
+
+// The faust algebra on affine forms. The affine operations (Add, Sub, Neg) are
+// exact, Mul adds a fresh term for its quadratic part, and Inv, Div, Sqrt, Exp
+// and Log use the min-range linear approximation of the function on the range
+// of their argument. The other methods are computed by interval_algebra on the
+// ranges of their arguments, their results have a fresh symbol.
+//
+// Every result has at most maxTerms terms: the smallest ones are condensed
+// into a fresh symbol, which bounds the memory used by a form.
+class affine_algebra : public faust_algebra<affine_form> {
+   private:
+    interval_algebra fAlgebra;
+    size_t           fMaxTerms;  ///< term budget of a form
+
+   public:
+    explicit affine_algebra(size_t maxTerms = 16) : fMaxTerms(std::max<size_t>(maxTerms, 1)) {}
+
+    size_t maxTerms() const { return fMaxTerms; }
+
+    affine_form Label(const std::string& x) const;
+    affine_form IntNum(int x) const;
+    affine_form FloatNum(double x) const;
+    affine_form Button(const affine_form& name) const;
+    affine_form Checkbox(const affine_form& name) const;
+    affine_form VSlider(const affine_form& name, const affine_form& init, const affine_form& lo,
+                        const affine_form& hi, const affine_form& step) const;
+    affine_form HSlider(const affine_form& name, const affine_form& init, const affine_form& lo,
+                        const affine_form& hi, const affine_form& step) const;
+    affine_form NumEntry(const affine_form& name, const affine_form& init, const affine_form& lo,
+                         const affine_form& hi, const affine_form& step) const;
+    affine_form Abs(const affine_form& x) const;
+    affine_form Add(const affine_form& x, const affine_form& y) const;
+    affine_form Sub(const affine_form& x, const affine_form& y) const;
+    affine_form Mul(const affine_form& x, const affine_form& y) const;
+    affine_form Div(const affine_form& x, const affine_form& y) const;
+    affine_form Inv(const affine_form& x) const;
+    affine_form Neg(const affine_form& x) const;
+    affine_form Mod(const affine_form& x, const affine_form& y) const;
+    affine_form Acos(const affine_form& x) const;
+    affine_form Acosh(const affine_form& x) const;
+    affine_form And(const affine_form& x, const affine_form& y) const;
+    affine_form Asin(const affine_form& x) const;
+    affine_form Asinh(const affine_form& x) const;
+    affine_form Atan(const affine_form& x) const;
+    affine_form Atan2(const affine_form& x, const affine_form& y) const;
+    affine_form Atanh(const affine_form& x) const;
+    affine_form Ceil(const affine_form& x) const;
+    affine_form Cos(const affine_form& x) const;
+    affine_form Cosh(const affine_form& x) const;
+    affine_form Delay(const affine_form& x, const affine_form& y) const;
+    affine_form Eq(const affine_form& x, const affine_form& y) const;
+    affine_form Exp(const affine_form& x) const;
+    affine_form FloatCast(const affine_form& x) const;
+    affine_form Floor(const affine_form& x) const;
+    affine_form Ge(const affine_form& x, const affine_form& y) const;
+    affine_form Gt(const affine_form& x, const affine_form& y) const;
+    affine_form IntCast(const affine_form& x) const;
+    affine_form Le(const affine_form& x, const affine_form& y) const;
+    affine_form Log(const affine_form& x) const;
+    affine_form Log10(const affine_form& x) const;
+    affine_form Lsh(const affine_form& x, const affine_form& y) const;
+    affine_form Lt(const affine_form& x, const affine_form& y) const;
+    affine_form Max(const affine_form& x, const affine_form& y) const;
+    affine_form Mem(const affine_form& x) const;
+    affine_form Min(const affine_form& x, const affine_form& y) const;
+    affine_form Ne(const affine_form& x, const affine_form& y) const;
+    affine_form Not(const affine_form& x) const;
+    affine_form Or(const affine_form& x, const affine_form& y) const;
+    affine_form Pow(const affine_form& x, const affine_form& y) const;
+    affine_form RdTbl(const affine_form& tbl, const affine_form& index) const;
+    affine_form Remainder(const affine_form& x) const;
+    affine_form Rint(const affine_form& x) const;
+    affine_form Rsh(const affine_form& x, const affine_form& y) const;
+    affine_form Select2(const affine_form& s, const affine_form& x, const affine_form& y) const;
+    affine_form Select3(const affine_form& s, const affine_form& x, const affine_form& y, const affine_form& z) const;
+    affine_form Sin(const affine_form& x) const;
+    affine_form Sinh(const affine_form& x) const;
+    affine_form Sqrt(const affine_form& x) const;
+    affine_form Tan(const affine_form& x) const;
+    affine_form Tanh(const affine_form& x) const;
+    affine_form WrTbl(const affine_form& n, const affine_form& init,
+                      const affine_form& index, const affine_form& value) const;
+    affine_form Xor(const affine_form& x, const affine_form& y) const;
+
+   private:
+    affine_form condense(affine_form x) const;
+    affine_form linear(const affine_form& x, double alpha, double zeta, double delta) const;
+    affine_form apply(umth m, const affine_form& x) const;
+    affine_form apply(bmth m, const affine_form& x, const affine_form& y) const;
+};
+
+void testAffine();
+
+}  // namespace itv
@@ -0,0 +1,116 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "interval_def.hh"
+
+// ***************************************************************************
+//
+//     An affine_form is a central value plus a linear combination of noise
+//     symbols e_i ranging independently over [-1,1]:
+//
+//         x = x0 + x1.e1 + ... + xn.en
+//
+//     Two forms sharing a noise symbol are correlated, so that x - x is 0 and
+//     x*(1-x) is tighter than with intervals. The number of terms is bounded by
+//     the term budget of affine_algebra, the smallest terms are condensed into
+//     a fresh symbol beyond it. An empty form has a NAN center, a form with an
+//     infinite center or coefficient is unbounded.
+//
+//****************************************************************************
+namespace itv {
+
+struct noise_term {
+    uint64_t symbol;  ///< identifier of the noise symbol
+    double   coef;    ///< its coefficient
+};
+
+// a noise symbol never used before, shared by all the forms of all the threads
+inline uint64_t newNoiseSymbol()
+{
+    static std::atomic<uint64_t> next{0};
+    return next++;
+}
+
+class affine_form {
+   private:
+    double                  fCenter{0};
+    std::vector<noise_term> fTerms;  ///< sorted by symbol, with non zero coefficients
+
+   public:
+    affine_form() = default;
+
+    explicit affine_form(double c) : fCenter(c) {}
+
+    affine_form(double c, std::vector<noise_term> terms) : fCenter(c), fTerms(std::move(terms)) {}
+
+    // the form c + r.e of a fresh symbol e, covering the interval x
+    static affine_form fromInterval(const interval& x)
+    {
+        if (x.isEmpty()) return affine_form(NAN);
+        if (x.isUnbounded()) return {0, {{newNoiseSymbol(), HUGE_VAL}}};
+        double c = x.lo() + (x.hi() - x.lo()) / 2;
+        double r = std::max(c - x.lo(), x.hi() - c);  // c is rounded, cover both bounds
+        if (r == 0) return affine_form(c);
+        return {c, {{newNoiseSymbol(), r}}};
+    }
+
+    double                         center() const { return fCenter; }
+    const std::vector<noise_term>& terms() const { return fTerms; }
+
+    bool isEmpty() const { return std::isnan(fCenter); }
+    bool isconst() const { return !isEmpty() && fTerms.empty(); }
+
+    // sum of the absolute values of the coefficients, rounded up
+    double radius() const
+    {
+        double r = 0;
+        for (const auto& t : fTerms) r += std::fabs(t.coef);
+        return r * (1 + fTerms.size() * DBL_EPSILON);
+    }
+
+    bool isBounded() const { return !isEmpty() && std::isfinite(fCenter) && std::isfinite(radius()); }
+
+    // the interval [c-r, c+r], rounded outward. The constructor of interval truncates the
+    // bounds to its lsb, the high bound is moved up by one lsb if it was lowered.
+    interval toInterval() const
+    {
+        if (isEmpty()) return {NAN, NAN};
+        if (!isBounded()) return {-HUGE_VAL, HUGE_VAL};
+        double r = radius();
+        if (r == 0) return interval(fCenter);
+        double   hi = std::nextafter(fCenter + r, HUGE_VAL);
+        interval x(std::nextafter(fCenter - r, -HUGE_VAL), hi);
+        return (x.hi() < hi) ? interval(x.lo(), hi + std::ldexp(1.0, x.lsb())) : x;
+    }
+};
+
+inline std::ostream& operator<<(std::ostream& dst, const affine_form& x)
+{
+    if (x.isEmpty()) return dst << "affine_form()";
+    dst << "affine_form(" << x.center();
+    for (const auto& t : x.terms()) dst << (t.coef < 0 ? " - " : " + ") << std::fabs(t.coef) << ".e" << t.symbol;
+    return dst << ')';
+}
+
+}  // namespace itv
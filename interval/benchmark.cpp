@@ -0,0 +1,236 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <cmath>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+#include "benchmark.hh"
+#include "check.hh"
+#include "interval_algebra.hh"
+#include "interval_def.hh"
+#include "outward_interval_algebra.hh"
+
+namespace itv {
+
+static constexpr int kTimingRounds = 20;  // each input interval is evaluated kTimingRounds times for the timing
+
+// a sink preventing the compiler from removing the timed calls
+static volatile double gSink = 0;
+
+static interval randomInterval(std::default_random_engine& generator, const interval& D)
+{
+    std::uniform_real_distribution rd(D.lo(), D.hi());
+    double                         a = rd(generator);
+    double                         b = rd(generator);
+    return {std::min(a, b), std::max(a, b)};
+}
+
+// estimated true image of f on X, from its bounds and M random points, empty if f is undefined on them
+template <typename F>
+static interval estimate(std::default_random_engine& generator, const interval& X, int M, F f)
+{
+    std::uniform_real_distribution rx(X.lo(), X.hi());
+    double                         lo = HUGE_VAL;
+    double                         hi = -HUGE_VAL;
+    auto                           add = [&](double y) {
+        if (!std::isnan(y)) {
+            lo = std::min(lo, y);
+            hi = std::max(hi, y);
+        }
+    };
+    add(f(X.lo()));
+    add(f(X.hi()));
+    for (int m = 0; m < M; m++) add(f(rx(generator)));
+    return (lo <= hi) ? interval(lo, hi) : interval(NAN, NAN);
+}
+
+// accumulate the tightness of a computed result Z against an estimated image Y
+static void tightness(bench_result& r, double& logsum, int& n, const interval& Z, const interval& Y)
+{
+    if (Y.isEmpty() || Y.isUnbounded() || Z.isEmpty()) return;
+    if (Z.isUnbounded()) {
+        r.unbounded++;
+        return;
+    }
+    // one lsb of Z on both widths, so that exact points have a ratio of 1
+    double u     = std::ldexp(1.0, Z.lsb());
+    double ratio = (Z.size() + u) / (Y.size() + u);
+    logsum += std::log(ratio);
+    n++;
+    r.worst = std::max(r.worst, ratio);
+}
+
+template <typename T>
+static double timeCalls(const std::vector<T>& inputs, const std::function<interval(const T&)>& call)
+{
+    double sum   = 0;
+    auto   start = std::chrono::steady_clock::now();
+    for (int k = 0; k < kTimingRounds; k++) {
+        for (const auto& x : inputs) sum += call(x).hi();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    gSink     = sum;
+    return std::chrono::duration<double, std::nano>(stop - start).count() / (double(kTimingRounds) * inputs.size());
+}
+
+template <typename Algebra, typename Method>
+static bench_result benchUnary(const char* title, const char* input, const char* mode, ufun f, Method m,
+                               const interval& D, int E, int M)
+{
+    std::default_random_engine generator(0);  // the same inputs for every run, to compare the runs
+    Algebra                    A;
+    bench_result               r{title, input, mode};
+    std::vector<interval>      inputs;
+
+    for (int e = 0; e < E; e++) inputs.push_back(randomInterval(generator, D));
+
+    double logsum = 0;
+    int    n      = 0;
+    for (const auto& X : inputs) tightness(r, logsum, n, (A.*m)(X), estimate(generator, X, M, f));
+
+    r.samples = E;
+    r.ratio   = (n > 0) ? std::exp(logsum / n) : 1;
+    r.nsPerOp = timeCalls<interval>(inputs, [&](const interval& X) { return (A.*m)(X); });
+    return r;
+}
+
+template <typename Algebra, typename Method>
+static bench_result benchBinary(const char* title, const char* input, const char* mode, bfun f, Method m,
+                                const interval& Dx, const interval& Dy, int E, int M)
+{
+    using pair = std::pair<interval, interval>;
+
+    std::default_random_engine generator(0);
+    Algebra                    A;
+    bench_result               r{title, input, mode};
+    std::vector<pair>          inputs;
+
+    for (int e = 0; e < E; e++) {
+        interval X = randomInterval(generator, Dx);
+        interval Y = randomInterval(generator, Dy);
+        inputs.emplace_back(X, Y);
+    }
+
+    double logsum = 0;
+    int    n      = 0;
+    for (const auto& [X, Y] : inputs) {
+        // estimate the image on the corners and on M random points of X x Y
+        std::uniform_real_distribution rx(X.lo(), X.hi());
+        std::uniform_real_distribution ry(Y.lo(), Y.hi());
+        double                         lo = HUGE_VAL;
+        double                         hi = -HUGE_VAL;
+        auto                           add = [&](double z) {
+            if (!std::isnan(z)) {
+                lo = std::min(lo, z);
+                hi = std::max(hi, z);
+            }
+        };
+        add(f(X.lo(), Y.lo()));
+        add(f(X.lo(), Y.hi()));
+        add(f(X.hi(), Y.lo()));
+        add(f(X.hi(), Y.hi()));
+        for (int k = 0; k < M; k++) add(f(rx(generator), ry(generator)));
+        interval Z = (lo <= hi) ? interval(lo, hi) : interval(NAN, NAN);
+        tightness(r, logsum, n, (A.*m)(X, Y), Z);
+    }
+
+    r.samples = E;
+    r.ratio   = (n > 0) ? std::exp(logsum / n) : 1;
+    r.nsPerOp = timeCalls<pair>(inputs, [&](const pair& p) { return (A.*m)(p.first, p.second); });
+    return r;
+}
+
+bench_result benchUnaryMethod(const char* title, const char* input, ufun f, umth m, const interval& D, int E, int M)
+{
+    return benchUnary<interval_algebra>(title, input, "fast", f, m, D, E, M);
+}
+
+bench_result benchBinaryMethod(const char* title, const char* input, bfun f, bmth m, const interval& Dx,
+                               const interval& Dy, int E, int M)
+{
+    return benchBinary<interval_algebra>(title, input, "fast", f, m, Dx, Dy, E, M);
+}
+
+bench_result benchUnaryMethod(const char* title, const char* input, ufun f, oumth m, const interval& D, int E, int M)
+{
+    return benchUnary<outward_interval_algebra>(title, input, "outward", f, m, D, E, M);
+}
+
+bench_result benchBinaryMethod(const char* title, const char* input, bfun f, obmth m, const interval& Dx,
+                               const interval& Dy, int E, int M)
+{
+    return benchBinary<outward_interval_algebra>(title, input, "outward", f, m, Dx, Dy, E, M);
+}
+
+void printBenchHeader(std::ostream& dst, bool csv)
+{
+    if (csv) {
+        dst << "primitive,input,mode,ns/op,ratio,worst,unbounded,samples\n";
+    } else {
+        dst << std::left << std::setw(12) << "primitive" << std::setw(22) << "input" << std::setw(9) << "mode"
+            << std::right << std::setw(10) << "ns/op" << std::setw(10) << "ratio" << std::setw(12) << "worst"
+            << std::setw(11) << "unbounded" << '\n';
+    }
+}
+
+void printBenchResult(std::ostream& dst, const bench_result& r, bool csv)
+{
+    if (csv) {
+        dst << r.primitive << ',' << r.input << ',' << r.mode << ',' << r.nsPerOp << ',' << r.ratio << ','
+            << r.worst << ',' << r.unbounded << ',' << r.samples << '\n';
+    } else {
+        dst << std::left << std::setw(12) << r.primitive << std::setw(22) << r.input << std::setw(9) << r.mode
+            << std::right << std::fixed << std::setprecision(1) << std::setw(10) << r.nsPerOp << ' '
+            << std::setprecision(3) << std::setw(9) << r.ratio << ' ' << std::defaultfloat << std::setprecision(4)
+            << std::setw(11) << r.worst << std::setw(11) << r.unbounded << '\n';
+    }
+}
+
+//------------------------------------------------------------------------------------------
+// tests
+
+static double myDiv(double x, double y)
+{
+    return x / y;
+}
+
+void testBenchmark()
+{
+    // monotonic methods are exact
+    bench_result e = benchUnaryMethod("exp", "[-10,10]", exp, &interval_algebra::Exp, interval(-10, 10), 100, 10);
+    printBenchResult(testout(), e, false);
+    check("test benchmark Exp ratio", e.ratio < 1.001, true);
+    check("test benchmark Exp samples", e.samples == 100, true);
+
+    // Div is computed as Mul(x, Inv(y)), never tighter than the sampled image
+    bench_result d = benchBinaryMethod("div", "[-1,1]/[1,2]", myDiv, &interval_algebra::Div, interval(-1, 1),
+                                       interval(1, 2), 100, 100);
+    printBenchResult(testout(), d, false);
+    check("test benchmark Div ratio", d.ratio >= 0.999, true);
+    check("test benchmark Div unbounded", d.unbounded == 0, true);
+
+    // the sound mode measured on the same inputs
+    bench_result o =
+        benchUnaryMethod("exp", "[-10,10]", exp, &outward_interval_algebra::Exp, interval(-10, 10), 100, 10);
+    printBenchResult(testout(), o, false);
+    check("test benchmark outward mode", o.mode == "outward", true);
+    check("test benchmark outward ratio", (o.ratio >= e.ratio) && (o.ratio < 1.001), true);
+}
+
+}  // namespace itv
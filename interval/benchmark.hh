@@ -0,0 +1,68 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <iostream>
+#include <string>
+
+#include "check.hh"
+#include "interval_def.hh"
+#include "outward_interval_algebra.hh"
+
+namespace itv {
+
+//==============================================================================
+// Precision versus throughput benchmark of the primitives.
+//
+// For a primitive and a class of inputs (a domain D), E random intervals are
+// drawn in D. Each one is evaluated by the interval method, and its true image
+// is estimated from the numerical function at the two bounds and M random points,
+// which is exact for monotonic functions. The tightness of the method is the
+// ratio of the computed width to the estimated width (1 is optimal, below 1 the
+// method misses part of the image), reported next to the time per call of the method.
+// The methods of outward_interval_algebra are measured the same way, to compare
+// the cost of the sound mode with the fast mode on the same inputs.
+//==============================================================================
+
+struct bench_result {
+    std::string primitive;
+    std::string input;       ///< name of the input class
+    std::string mode;        ///< fast (interval_algebra) or outward (outward_interval_algebra)
+    double      nsPerOp{0};  ///< average duration of a call to the method
+    double      ratio{1};    ///< geometric mean of computed width / estimated width, for bounded results
+    double      worst{1};    ///< worst ratio, for bounded results
+    int         unbounded{0};  ///< number of unbounded results for a bounded estimated image
+    int         samples{0};    ///< number of input intervals
+};
+
+bench_result benchUnaryMethod(const char* title, const char* input, ufun f, umth m, const interval& D, int E = 1000,
+                              int M = 100);
+
+bench_result benchBinaryMethod(const char* title, const char* input, bfun f, bmth m, const interval& Dx,
+                               const interval& Dy, int E = 1000, int M = 100);
+
+bench_result benchUnaryMethod(const char* title, const char* input, ufun f, oumth m, const interval& D, int E = 1000,
+                              int M = 100);
+
+bench_result benchBinaryMethod(const char* title, const char* input, bfun f, obmth m, const interval& Dx,
+                               const interval& Dy, int E = 1000, int M = 100);
+
+// one line of a text table, or a csv line
+void printBenchHeader(std::ostream& dst, bool csv);
+void printBenchResult(std::ostream& dst, const bench_result& r, bool csv);
+
+void testBenchmark();
+
+}  // namespace itv
@@ -12,14 +12,39 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
 #include <iostream>
+#include <mutex>
 #include <random>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "check.hh"
 #include "interval_algebra.hh"
 
+//==============================================================================
+// state of the running test, local to the thread running it
+
+static thread_local std::ostream* gTestOut      = nullptr;  // buffered output, std::cout when nullptr
+static thread_local unsigned long gTestChecks   = 0;        // number of checks
+static thread_local unsigned long gTestFailures = 0;        // number of failed checks
+
+std::ostream& testout()
+{
+    return (gTestOut != nullptr) ? *gTestOut : std::cout;
+}
+
+static void report(bool ok)
+{
+    gTestChecks++;
+    if (!ok) gTestFailures++;
+}
+
 /**
  * @brief check we have the expected interval
  *
@@ -28,12 +53,15 @@
  */
 void check(const std::string& expected, const itv::interval& exp)
 {
-    std::stringstream ss;
+    static thread_local std::ostringstream ss;
+    ss.str("");
     ss << exp;
-    if (ss.str().compare(expected) == 0) {
-        std::cout << "OK: " << expected << std::endl;
+    bool ok = (ss.str() == expected);
+    report(ok);
+    if (ok) {
+        testout() << "OK: " << expected << '\n';
     } else {
-        std::cout << "ERR:  We got " << ss.str() << " instead of " << expected << std::endl;
+        testout() << "ERR:  We got " << ss.str() << " instead of " << expected << '\n';
     }
 }
 
@@ -46,10 +74,11 @@ void check(const std::string& expected, const itv::interval& exp)
  */
 void check(const std::string& testname, const itv::interval& exp, const itv::interval& res)
 {
+    report(exp == res);
     if (exp == res) {
-        std::cout << "OK: " << testname << " " << exp << std::endl;
+        testout() << "OK: " << testname << " " << exp << '\n';
     } else {
-        std::cout << "ERR:" << testname << " FAILED. We got " << exp << " instead of " << res << std::endl;
+        testout() << "ERR:" << testname << " FAILED. We got " << exp << " instead of " << res << '\n';
     }
 }
 
@@ -62,11 +91,93 @@ void check(const std::string& testname, const itv::interval& exp, const itv::int
  */
 void check(const std::string& testname, bool exp, bool res)
 {
+    report(exp == res);
     if (exp == res) {
-        std::cout << "OK: " << testname << std::endl;
+        testout() << "OK: " << testname << '\n';
     } else {
-        std::cout << "ERR:" << testname << " FAILED. We got " << exp << " instead of " << res << std::endl;
+        testout() << "ERR:" << testname << " FAILED. We got " << exp << " instead of " << res << '\n';
+    }
+}
+
+//==============================================================================
+// registry of tests
+
+struct test_entry {
+    std::string           name;
+    std::function<void()> test;
+    std::ostringstream    log;
+    unsigned long         checks{0};
+    unsigned long         failures{0};
+    double                ms{0};
+};
+
+static std::vector<test_entry>& registry()
+{
+    static std::vector<test_entry> tests;
+    return tests;
+}
+
+void registerTest(const std::string& name, const std::function<void()>& test)
+{
+    test_entry e;
+    e.name = name;
+    e.test = test;
+    registry().push_back(std::move(e));
+}
+
+static void runTest(test_entry& e)
+{
+    gTestOut      = &e.log;
+    gTestChecks   = 0;
+    gTestFailures = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    e.test();
+    auto stop = std::chrono::steady_clock::now();
+
+    e.ms       = std::chrono::duration<double, std::milli>(stop - start).count();
+    e.checks   = gTestChecks;
+    e.failures = gTestFailures;
+    gTestOut   = nullptr;
+}
+
+int runTests(unsigned int threads, bool verbose)
+{
+    std::vector<test_entry>& tests = registry();
+    if (threads == 0) threads = std::max(1U, std::thread::hardware_concurrency());
+    threads = std::min<unsigned int>(threads, std::max<size_t>(tests.size(), 1));
+
+    // the threads take the next test to run until there is none left
+    std::atomic<size_t>      next{0};
+    std::vector<std::thread> workers;
+    auto                     work = [&]() {
+        for (size_t i = next++; i < tests.size(); i = next++) runTest(tests[i]);
+    };
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int t = 1; t < threads; t++) workers.emplace_back(work);
+    work();
+    for (auto& w : workers) w.join();
+    double total = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    int    failed  = 0;
+    size_t width   = 4;
+    for (const auto& e : tests) {
+        width = std::max(width, e.name.size());
+        if (e.failures > 0) failed++;
+        if (verbose || (e.failures > 0)) std::cout << "=== " << e.name << '\n' << e.log.str();
     }
+
+    std::cout << '\n' << std::left << std::setw(int(width)) << "test" << "  status  checks  failures  time (ms)\n";
+    for (const auto& e : tests) {
+        std::cout << std::left << std::setw(int(width)) << e.name << "  " << std::setw(6)
+                  << ((e.failures > 0) ? "FAIL" : "OK") << "  " << std::right << std::setw(6) << e.checks << "  "
+                  << std::setw(8) << e.failures << "  " << std::setw(9) << std::fixed << std::setprecision(3) << e.ms
+                  << '\n';
+    }
+    std::cout << std::defaultfloat << '\n'
+              << tests.size() - size_t(failed) << "/" << tests.size() << " tests passed in " << total << " ms on "
+              << threads << " threads" << std::endl;
+    return failed;
 }
 
 /**
@@ -125,9 +236,9 @@ itv::interval testfun(int N, bfun f, const itv::interval& x, const itv::interval
 void analyzemod(itv::interval x, itv::interval y)
 {
     itv::interval_algebra A;
-    std::cout << "simulated fmod(" << x << "," << y << ") = " << testfun(10000, fmod, x, y) << std::endl;
-    std::cout << "computed  fmod(" << x << "," << y << ") = " << A.Mod(x, y) << std::endl;
-    std::cout << std::endl;
+    testout() << "simulated fmod(" << x << "," << y << ") = " << testfun(10000, fmod, x, y) << '\n';
+    testout() << "computed  fmod(" << x << "," << y << ") = " << A.Mod(x, y) << '\n';
+    testout() << '\n';
 }
 
 void analyzeUnaryFunction(int E, int M, const char* title, const itv::interval& D, ufun f)
@@ -136,7 +247,7 @@ void analyzeUnaryFunction(int E, int M, const char* title, const itv::interval&
     std::default_random_engine     generator(R());
     std::uniform_real_distribution rd(D.lo(), D.hi());
 
-    std::cout << "Analysis of " << title << " in domain " << D << std::endl;
+    testout() << "Analysis of " << title << " in domain " << D << '\n';
 
     for (int e = 0; e < E; e++) {  // E experiments
 
@@ -161,9 +272,9 @@ void analyzeUnaryFunction(int E, int M, const char* title, const itv::interval&
         }
         itv::interval Y(y0, y1);
 
-        std::cout << e << ": " << title << "(" << X << ") = " << Y << std::endl;
+        testout() << e << ": " << title << "(" << X << ") = " << Y << '\n';
     }
-    std::cout << std::endl;
+    testout() << '\n';
 }
 
 void analyzeUnaryMethod(int E, int M, const char* title, const itv::interval& D, ufun f, umth mp)
@@ -173,7 +284,7 @@ void analyzeUnaryMethod(int E, int M, const char* title, const itv::interval& D,
     std::uniform_real_distribution rd(D.lo(), D.hi());
     itv::interval_algebra          A;
 
-    std::cout << "Analysis of " << title << " in domain " << D << std::endl;
+    testout() << "Analysis of " << title << " in domain " << D << '\n';
 
     for (int e = 0; e < E; e++) {  // E experiments
 
@@ -196,19 +307,21 @@ void analyzeUnaryMethod(int E, int M, const char* title, const itv::interval& D,
                 if (y > y1) y1 = y;
             }
         }
-        itv::interval Y(y0, y1);
+        // no measurement when f is undefined on the whole X
+        itv::interval Y = (y0 <= y1) ? itv::interval(y0, y1) : itv::interval(NAN, NAN);
         itv::interval Z = (A.*mp)(X);
 
+        report(Z >= Y);
         if (Z >= Y) {
             double lsb = (Z.size() == 0) ? 1 : Y.size() / Z.size();
 
-            std::cout << "OK    " << e << ": " << title << "(" << X << ") = " << Z << " >= " << Y << " (precision "
-                      << lsb << ")" << std::endl;
+            testout() << "OK    " << e << ": " << title << "(" << X << ") = " << Z << " >= " << Y << " (precision "
+                      << lsb << ")" << '\n';
         } else {
-            std::cout << "ERROR " << e << ": " << title << "(" << X << ") = " << Z << " INSTEAD OF " << Y << std::endl;
+            testout() << "ERROR " << e << ": " << title << "(" << X << ") = " << Z << " INSTEAD OF " << Y << '\n';
         }
     }
-    std::cout << std::endl;
+    testout() << '\n';
 }
 
 /**
@@ -232,7 +345,7 @@ void analyzeBinaryMethod(int E, int M, const char* title, const itv::interval& D
     std::uniform_real_distribution rdy(Dy.lo(), Dy.hi());
     itv::interval_algebra          A;
 
-    std::cout << "Analysis of " << title << " in domains " << Dx << " x " << Dy << std::endl;
+    testout() << "Analysis of " << title << " in domains " << Dx << " x " << Dy << '\n';
 
     for (int e = 0; e < E; e++) {  // for each experiments
 
@@ -262,17 +375,18 @@ void analyzeBinaryMethod(int E, int M, const char* title, const itv::interval& D
                 if (z > zhi) zhi = z;
             }
         }
-        itv::interval Zm(zlo, zhi);         // the measured Z
+        itv::interval Zm = (zlo <= zhi) ? itv::interval(zlo, zhi) : itv::interval(NAN, NAN);  // the measured Z
         itv::interval Zc  = (A.*bm)(X, Y);  // the computed Z
         double        lsb = (Zm.size() == Zc.size()) ? 1 : Zm.size() / Zc.size();
 
+        report(Zc >= Zm);
         if (Zc >= Zm) {
-            std::cout << "OK    " << e << ": " << title << "(" << X << "," << Y << ") =c=> " << Zc << " >= " << Zm
-                      << " (precision " << lsb << ")" << std::endl;
+            testout() << "OK    " << e << ": " << title << "(" << X << "," << Y << ") =c=> " << Zc << " >= " << Zm
+                      << " (precision " << lsb << ")" << '\n';
         } else {
-            std::cout << "ERROR " << e << ": " << title << "(" << X << "," << Y << ") =c=> " << Zc << " != " << Zm
-                      << std::endl;
+            testout() << "ERROR " << e << ": " << title << "(" << X << "," << Y << ") =c=> " << Zc << " != " << Zm
+                      << '\n';
         }
     }
-    std::cout << std::endl;
+    testout() << '\n';
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+#include <iostream>
 #include <string>
 
 #include "interval_algebra.hh"
@@ -25,3 +27,16 @@ void analyzeUnaryMethod(int E, int M, const char* title, const itv::interval& D,
 
 void analyzeBinaryMethod(int E, int M, const char* title, const itv::interval& C, const itv::interval& D, bfun f,
                          bmth m);
+
+// Registry of named tests. runTests() shards them over several threads, the
+// output of each test is buffered and printed in the order of registration,
+// followed by a summary table with the duration of each test.
+
+void registerTest(const std::string& name, const std::function<void()>& test);
+
+// run the registered tests, print the logs of the failed tests (of all tests if verbose)
+// and return the number of failed tests
+int runTests(unsigned int threads, bool verbose);
+
+// the output stream of the running test (std::cout outside of runTests)
+std::ostream& testout();
@@ -0,0 +1,155 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <map>
+#include <vector>
+
+#include "check.hh"
+#include "delay_planner.hh"
+#include "interval_algebra.hh"
+#include "interval_def.hh"
+#include "signal_graph.hh"
+
+namespace itv {
+
+// the smallest power of 2 >= n
+static int nextPowerOf2(int n)
+{
+    int p = 1;
+    while (p < n) p *= 2;
+    return p;
+}
+
+delay_plan planDelays(const signal_graph& g, const std::vector<interval>& R, const delay_cost& c)
+{
+    delay_plan                p;
+    std::map<int, delay_line> lines;  // by source node
+    auto                      read = [&](int reader, int source, int delay, bool zero) {
+        delay_line& l = lines[source];
+        l.source      = source;
+        l.readers.push_back(reader);
+        l.maxDelay = std::max(l.maxDelay, delay);
+        l.zero     = l.zero || zero;
+    };
+
+    using I = interval_algebra;
+    for (int i = 0; i < g.size(); i++) {
+        const signal_graph::node& n = g[i];
+        if ((n.type == signal_graph::kind::feedback) || ((n.type == signal_graph::kind::unary) && (n.u == &I::Mem))) {
+            read(i, n.x, 1, false);
+        } else if ((n.type == signal_graph::kind::binary) && (n.b == &I::Delay)) {
+            interval d = R[n.y];
+            if (d.isEmpty()) continue;
+            if (!(d.hi() < INT_MAX / 2)) {
+                p.unbounded.push_back(i);
+                continue;
+            }
+            // a fractional delay also reads the sample after floor(d)
+            int m = (d.lsb() < 0) ? int(std::floor(d.hi())) + 1 : int(d.hi());
+            read(i, n.x, std::max(m, 0), d.lo() < 1);
+        }
+    }
+
+    for (auto& [source, l] : lines) {
+        // with a reader of the delay 0 the sample is written first, the oldest sample needs one more cell
+        l.cells = l.maxDelay + (l.zero ? 1 : 0);
+        if (l.cells <= 1) {
+            l.size     = 1;
+            l.indexing = delay_indexing::scalar;
+        } else {
+            int    p2     = nextPowerOf2(l.cells);
+            double masked = c.maskCost + c.byteCost * double(p2) * c.sampleBytes;
+            double exact  = c.moduloCost + c.byteCost * double(l.cells) * c.sampleBytes;
+            l.indexing    = (masked <= exact) ? delay_indexing::mask : delay_indexing::modulo;
+            l.size        = (masked <= exact) ? p2 : l.cells;
+        }
+        p.lines.push_back(l);
+    }
+
+    // the packed layout, the largest buffers first
+    std::stable_sort(p.lines.begin(), p.lines.end(),
+                     [](const delay_line& a, const delay_line& b) { return a.size > b.size; });
+    for (delay_line& l : p.lines) {
+        l.offset = p.bytes;
+        p.bytes += size_t(l.size) * size_t(c.sampleBytes);
+    }
+    return p;
+}
+
+std::ostream& operator<<(std::ostream& dst, const delay_plan& p)
+{
+    static const char* names[] = {"scalar", "mask", "modulo"};
+    for (const delay_line& l : p.lines) {
+        dst << "line of node " << l.source << ": delay " << l.maxDelay << ", " << l.cells << " cells, " << l.size
+            << " allocated, " << names[int(l.indexing)] << ", offset " << l.offset << '\n';
+    }
+    for (int i : p.unbounded) dst << "unbounded delay at node " << i << '\n';
+    return dst << p.bytes << " bytes";
+}
+
+void testDelayPlanner()
+{
+    using I = interval_algebra;
+
+    signal_graph g;
+    int          x  = g.input(interval(-1, 1, -24));
+    int          d1 = g.binary(&I::Delay, x, g.input(interval(0, 1000, 0)));  // d1, d2 and m share the line of x
+    int          d2 = g.binary(&I::Delay, x, g.input(interval(10, 20, 0)));
+    int          m  = g.unary(&I::Mem, x);
+    int          y  = g.binary(&I::Add, d1, d2);
+    int          f  = g.binary(&I::Delay, y, g.input(interval(1, 4096.5, -1)));   // fractional
+    int          u  = g.binary(&I::Delay, y, g.input(interval(0, HUGE_VAL, 0)));  // unbounded
+    int          r  = g.feedback();
+    int          s  = g.binary(&I::Add, m, g.binary(&I::Mul, r, g.constant(0.5)));
+    g.loop(r, s);
+    int t = g.binary(&I::Delay, s, g.input(interval(2, 3, 0)));  // no delay 0: 3 cells
+    int q = g.unary(&I::Mem, d2);                                 // a scalar state
+
+    delay_plan p = planDelays(g, g.ranges(I()));
+    testout() << p << '\n';
+
+    auto line = [&](int source) {
+        for (const delay_line& l : p.lines) {
+            if (l.source == source) return l;
+        }
+        delay_line none;
+        none.source = -1;
+        return none;
+    };
+    check("test delay shared", (line(x).maxDelay == 1000) && (line(x).readers.size() == 3), true);
+    check("test delay mask", (line(x).cells == 1001) && (line(x).size == 1024), true);
+    check("test delay fractional", (line(y).maxDelay == 4097) && (line(y).cells == 4097) && (line(y).readers[0] == f),
+          true);
+    check("test delay modulo", line(y).indexing == delay_indexing::modulo, true);
+    check("test delay scalar", (line(d2).indexing == delay_indexing::scalar) && (line(d2).readers[0] == q), true);
+    check("test delay no zero", (line(s).cells == 3) && (line(s).readers == std::vector<int>{r, t}), true);
+    check("test delay unbounded", p.unbounded == std::vector<int>{u}, true);
+    check("test delay bytes", p.bytes == 8 * size_t(4097 + 1024 + 4 + 1), true);
+    check("test delay layout", (p.lines[0].offset == 0) && (p.lines[1].offset == 4097 * 8), true);
+
+    // a reader of the delay 0 makes the line one cell longer for the other readers too
+    signal_graph h;
+    int          z  = h.input(interval(-1, 1, -24));
+    int          h1 = h.binary(&I::Delay, z, h.input(interval(0, 5, 0)));
+    int          h2 = h.binary(&I::Delay, z, h.input(interval(1, 10, 0)));
+    delay_plan   hp = planDelays(h, h.ranges(I()));
+    const delay_line& hl = hp.lines[0];
+    check("test delay mixed zero", (hl.cells == 11) && (hl.maxDelay == 10) && (hl.readers == std::vector<int>{h1, h2}),
+          true);
+}
+
+}  // namespace itv
@@ -0,0 +1,76 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include "check.hh"
+#include "interval_def.hh"
+#include "signal_graph.hh"
+
+namespace itv {
+
+//==============================================================================
+// Memory planner of the delay lines of a signal graph.
+//
+// The Delay, Mem and feedback nodes reading the same signal share one delay
+// line, sized by the largest delay read from the ranges of their amounts (the
+// amount of a fractional delay is rounded up, plus the next sample read by the
+// interpolation). A line of maximal delay d needs d+1 cells when any of its
+// readers can read the delay 0 (the sample is then written before all the
+// reads) and d cells otherwise, a single cell is a scalar state.
+//
+// Each line is then either a power of 2 ring buffer with mask indexing or an
+// exact size buffer with modulo indexing: the cost model adds the cost of the
+// indexing of an access to the cost of the cache footprint of the buffer and
+// the cheapest one is chosen. The buffers are packed in a single block, the
+// largest first.
+//==============================================================================
+
+enum class delay_indexing { scalar, mask, modulo };
+
+struct delay_cost {
+    int    sampleBytes{8};      ///< size of a sample (8 for double, 4 for float)
+    double maskCost{1};         ///< cost of a mask indexing, per access
+    double moduloCost{20};      ///< cost of a modulo indexing, per access
+    double byteCost{1.0 / 64};  ///< cost of a byte of footprint (a cache line of 64 bytes costs 1)
+};
+
+struct delay_line {
+    int              source{0};    ///< node written in the line
+    std::vector<int> readers;      ///< Delay, Mem and feedback nodes reading it
+    int              maxDelay{0};
+    bool             zero{false};  ///< a reader can read the delay 0
+    int              cells{0};     ///< cells needed
+    int              size{0};      ///< cells allocated
+    delay_indexing   indexing{delay_indexing::scalar};
+    size_t           offset{0};    ///< offset in bytes of the buffer in the block
+};
+
+struct delay_plan {
+    std::vector<delay_line> lines;
+    std::vector<int>        unbounded;  ///< Delay nodes whose amount is unbounded, not planned
+    size_t                  bytes{0};   ///< total state memory
+};
+
+delay_plan planDelays(const signal_graph& g, const std::vector<interval>& R, const delay_cost& c = {});
+
+std::ostream& operator<<(std::ostream& dst, const delay_plan& p);
+
+void testDelayPlanner();
+
+}  // namespace itv
@@ -0,0 +1,298 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "check.hh"
+#include "domain_report.hh"
+#include "interval_algebra.hh"
+#include "interval_def.hh"
+#include "multi_interval.hh"
+#include "signal_graph.hh"
+
+namespace itv {
+
+//------------------------------------------------------------------------------------------
+// parts of an interval
+
+// the values of x below b
+static interval below(const interval& x, double b)
+{
+    if (!(x.lo() < b)) return {NAN, NAN};
+    return {x.lo(), std::min(x.hi(), std::nextafter(b, -HUGE_VAL)), x.lsb()};
+}
+
+// the values of x above b
+static interval above(const interval& x, double b)
+{
+    if (!(x.hi() > b)) return {NAN, NAN};
+    return {std::max(x.lo(), std::nextafter(b, HUGE_VAL)), x.hi(), x.lsb()};
+}
+
+// the values of x below or equal to b
+static interval atMost(const interval& x, double b)
+{
+    if (!(x.lo() <= b)) return {NAN, NAN};
+    return {x.lo(), std::min(x.hi(), b), x.lsb()};
+}
+
+// the values of x above or equal to b
+static interval atLeast(const interval& x, double b)
+{
+    if (!(x.hi() >= b)) return {NAN, NAN};
+    return {std::max(x.lo(), b), x.hi(), x.lsb()};
+}
+
+// the value v if x has it
+static interval point(const interval& x, double v)
+{
+    return x.has(v) ? interval(v, v, x.lsb()) : interval(NAN, NAN);
+}
+
+static multi_interval pieces(const interval& a, const interval& b = {NAN, NAN})
+{
+    interval p[2]{a, b};
+    return multi_interval::fromPieces(p, 2);
+}
+
+// y can take values that aren't integers
+static bool fractional(const interval& y)
+{
+    return (y.lsb() < 0) && !((y.lo() == y.hi()) && (std::rint(y.lo()) == y.lo()));
+}
+
+//------------------------------------------------------------------------------------------
+// the domains of the primitives
+
+static void logDomain(const interval& x, domain_hazard& h)
+{
+    h.outside = pieces(atMost(x, 0));
+    h.nan     = x.lo() < 0;
+    h.inf     = x.has(0);
+}
+
+static void sqrtDomain(const interval& x, domain_hazard& h)
+{
+    h.outside = pieces(below(x, 0));
+    h.nan     = !h.outside.isEmpty();
+}
+
+static void unitDomain(const interval& x, domain_hazard& h)  // acos and asin
+{
+    h.outside = pieces(below(x, -1), above(x, 1));
+    h.nan     = !h.outside.isEmpty();
+}
+
+static void acoshDomain(const interval& x, domain_hazard& h)
+{
+    h.outside = pieces(below(x, 1));
+    h.nan     = !h.outside.isEmpty();
+}
+
+static void atanhDomain(const interval& x, domain_hazard& h)
+{
+    h.outside = pieces(atMost(x, -1), atLeast(x, 1));
+    h.nan     = (x.lo() < -1) || (x.hi() > 1);
+    h.inf     = x.has(-1) || x.has(1);
+}
+
+static void invDomain(const interval& x, domain_hazard& h)
+{
+    h.outside = pieces(point(x, 0));
+    h.inf     = x.has(0);
+}
+
+static void tanDomain(const interval& x, domain_hazard& h)
+{
+    // the poles pi/2 + k*pi in x, x itself when there are too many of them
+    double k = std::ceil((x.lo() - M_PI_2) / M_PI);
+    double n = std::floor((x.hi() - M_PI_2) / M_PI) - k + 1;
+    if (!(n <= kMultiPieces)) {
+        h.outside = multi_interval(x);
+    } else {
+        interval p[kMultiPieces];
+        for (int i = 0; i < int(n); i++) {
+            double v = M_PI_2 + (k + i) * M_PI;
+            p[i]     = interval(v, v, x.lsb());
+        }
+        h.outside = multi_interval::fromPieces(p, std::max(0, int(n)));
+    }
+    h.inf = !h.outside.isEmpty();
+}
+
+static void divDomain(const interval& x, const interval& y, domain_hazard& h)
+{
+    h.argument = 1;
+    h.outside  = pieces(point(y, 0));
+    h.inf      = y.has(0);
+    h.nan      = h.inf && x.has(0);  // 0/0
+}
+
+static void powDomain(const interval& x, const interval& y, domain_hazard& h)
+{
+    bool neg  = (x.lo() < 0) && fractional(y);  // pow(-1,0.5)
+    bool pole = x.has(0) && (y.lo() < 0);       // pow(0,-1)
+    h.outside = pieces(neg ? below(x, 0) : interval(NAN, NAN), pole ? point(x, 0) : interval(NAN, NAN));
+    h.nan     = neg;
+    h.inf     = pole;
+}
+
+struct unary_domain {
+    const char* name;
+    umth        m;
+    void (*check)(const interval& x, domain_hazard& h);
+};
+
+struct binary_domain {
+    const char* name;
+    bmth        m;
+    void (*check)(const interval& x, const interval& y, domain_hazard& h);
+};
+
+static const unary_domain gUnaryDomains[] = {
+    {"Log", &interval_algebra::Log, logDomain},         {"Log10", &interval_algebra::Log10, logDomain},
+    {"Sqrt", &interval_algebra::Sqrt, sqrtDomain},      {"Acos", &interval_algebra::Acos, unitDomain},
+    {"Asin", &interval_algebra::Asin, unitDomain},      {"Acosh", &interval_algebra::Acosh, acoshDomain},
+    {"Atanh", &interval_algebra::Atanh, atanhDomain},   {"Inv", &interval_algebra::Inv, invDomain},
+    {"Tan", &interval_algebra::Tan, tanDomain},
+};
+
+static const binary_domain gBinaryDomains[] = {
+    {"Div", &interval_algebra::Div, divDomain},
+    {"Pow", &interval_algebra::Pow, powDomain},
+};
+
+//------------------------------------------------------------------------------------------
+// the report
+
+std::vector<domain_hazard> domainHazards(const signal_graph& g, const std::vector<interval>& R)
+{
+    std::vector<domain_hazard> r;
+    auto                       report = [&](int i, const char* name, auto check, const auto&... args) {
+        if ((args.isEmpty() || ...)) return;
+        domain_hazard h;
+        h.node      = i;
+        h.primitive = name;
+        check(args..., h);
+        if (h.nan || h.inf) r.push_back(h);
+    };
+    for (int i = 0; i < g.size(); i++) {
+        const signal_graph::node& n = g[i];
+        if (n.type == signal_graph::kind::unary) {
+            for (const unary_domain& d : gUnaryDomains) {
+                if (n.u == d.m) {
+                    report(i, d.name, d.check, R[n.x]);
+                    break;
+                }
+            }
+        } else if (n.type == signal_graph::kind::binary) {
+            for (const binary_domain& d : gBinaryDomains) {
+                if (n.b == d.m) {
+                    report(i, d.name, d.check, R[n.x], R[n.y]);
+                    break;
+                }
+            }
+        }
+    }
+    return r;
+}
+
+std::vector<domain_hazard> domainHazards(const signal_graph& g, int precision)
+{
+    return domainHazards(g, g.ranges(interval_algebra(precision)));
+}
+
+std::ostream& operator<<(std::ostream& dst, const domain_hazard& h)
+{
+    dst << "node " << h.node << ": " << h.primitive << ", " << (h.argument == 0 ? "x" : "y") << " outside the domain "
+        << h.outside << ", risk";
+    if (h.nan) dst << " NaN";
+    if (h.inf) dst << " Inf";
+    return dst;
+}
+
+//------------------------------------------------------------------------------------------
+// tests
+
+void testDomainReport()
+{
+    using I = interval_algebra;
+
+    signal_graph g;
+    int          x  = g.input(interval(-1, 1, -24));
+    int          p  = g.input(interval(0.5, 2, -24));
+    int          lg = g.unary(&I::Log, x);
+    int          lp = g.unary(&I::Log, p);
+    int          sq = g.unary(&I::Sqrt, x);
+    int          ac = g.unary(&I::Acos, g.binary(&I::Mul, x, g.constant(2)));
+    int          ah = g.unary(&I::Acosh, p);
+    int          at = g.unary(&I::Atanh, x);
+    int          iv = g.unary(&I::Inv, x);
+    int          dv = g.binary(&I::Div, p, x);
+    int          dz = g.binary(&I::Div, x, x);
+    int          pw = g.binary(&I::Pow, x, x);
+    int          pi = g.binary(&I::Pow, x, g.constant(2));
+    int          tn = g.unary(&I::Tan, g.binary(&I::Mul, x, g.constant(2)));
+    int          ex = g.unary(&I::Exp, x);
+
+    std::vector<domain_hazard> h = domainHazards(g);
+    for (const domain_hazard& d : h) testout() << d << '\n';
+
+    auto find = [&](int i) {
+        for (const domain_hazard& d : h) {
+            if (d.node == i) return d;
+        }
+        domain_hazard none;
+        none.node = -1;
+        return none;
+    };
+    check("test domain Log", find(lg).nan && find(lg).inf && (find(lg).outside.hull() == interval(-1, 0)), true);
+    check("test domain Log inside", find(lp).node >= 0, false);
+    check("test domain Sqrt", find(sq).nan && !find(sq).inf, true);
+    check("test domain Acos", find(ac).outside.count() == 2, true);
+    check("test domain Acosh", find(ah).nan && (find(ah).outside.hull().hi() < 1), true);
+    check("test domain Atanh", find(at).inf && !find(at).nan && find(at).outside.count() == 2, true);
+    check("test domain Inv", find(iv).inf && find(iv).outside.has(0), true);
+    check("test domain Div", find(dv).inf && !find(dv).nan && (find(dv).argument == 1), true);
+    check("test domain Div 0/0", find(dz).nan, true);
+    check("test domain Pow", find(pw).nan && find(pw).inf, true);
+    check("test domain Pow integer", find(pi).node >= 0, false);
+    check("test domain Tan", find(tn).inf && (find(tn).outside.count() == 2), true);
+    check("test domain Exp", find(ex).node >= 0, false);
+
+    // the cost of the report compared to the range analysis, on a chain of one pole filters with a few hazards
+    signal_graph c;
+    int          y = c.input(interval(-1, 1, -24));
+    for (int k = 0; k < 64; k++) {
+        int f = c.feedback();
+        int z = c.binary(&I::Add, y, c.binary(&I::Mul, c.constant(0.5), f));
+        c.loop(f, z);
+        y = c.binary(&I::Mul, z, c.constant(0.25));
+        if (k % 16 == 0) y = c.unary(&I::Sqrt, c.unary(&I::Abs, y));
+    }
+    using clock              = std::chrono::steady_clock;
+    auto                  t0 = clock::now();
+    std::vector<interval> R;
+    for (int k = 0; k < 100; k++) R = c.ranges(I());
+    auto t1 = clock::now();
+    for (int k = 0; k < 100; k++) h = domainHazards(c, R);
+    auto t2 = clock::now();
+    double ratio = std::chrono::duration<double>(t2 - t1).count() / std::chrono::duration<double>(t1 - t0).count();
+    testout() << "report " << ratio << " of the range analysis\n";
+    check("test domain cost", h.empty() && (ratio < 0.05), true);
+}
+
+}  // namespace itv
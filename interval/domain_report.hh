@@ -0,0 +1,60 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <iostream>
+#include <vector>
+
+#include "interval_def.hh"
+#include "multi_interval.hh"
+#include "signal_graph.hh"
+
+namespace itv {
+
+//==============================================================================
+// NaN and Inf hazards of the primitives restricted to a domain.
+//
+// interval_algebra clips the arguments of Log, Log10, Sqrt, Acos, Asin, Acosh,
+// Atanh, Inv, Div, Pow and Tan to their domain, or returns an empty interval,
+// without telling which values are out of it. The report lists, for each node
+// applying one of them, the part of the argument range outside the domain and
+// the risk: NaN for the values where the function is undefined (log(-1),
+// asin(2), pow(-1,0.5), 0/0) and Inf for its poles (log(0), 1/0, tan(pi/2),
+// atanh(1), pow(0,-1)).
+//
+// The report reads the ranges already computed for the graph and checks each
+// node in constant time, it can run after every range analysis.
+//==============================================================================
+
+struct domain_hazard {
+    int            node{0};
+    const char*    primitive{""};
+    int            argument{0};  ///< 0 for x, 1 for y
+    multi_interval outside;      ///< the part of the argument outside the domain
+    bool           nan{false};   ///< can produce NaN
+    bool           inf{false};   ///< can produce an infinity
+};
+
+// the hazards of the nodes of g, for the ranges R of its nodes
+std::vector<domain_hazard> domainHazards(const signal_graph& g, const std::vector<interval>& R);
+
+// the hazards of the nodes of g, for the ranges computed by interval_algebra(precision)
+std::vector<domain_hazard> domainHazards(const signal_graph& g, int precision = -24);
+
+std::ostream& operator<<(std::ostream& dst, const domain_hazard& h);
+
+void testDomainReport();
+
+}  // namespace itv
@@ -0,0 +1,592 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <string>
+
+#include "check.hh"
+#include "error_algebra.hh"
+#include "error_interval.hh"
+#include "interval_def.hh"
+
+namespace itv {
+
+//------------------------------------------------------------------------------------------
+// propagation of the errors
+
+// an error interval, without lsb truncation
+static interval exact(double lo, double hi)
+{
+    return {lo, hi, kMinLSB};
+}
+
+static double mag(const interval& x)
+{
+    return std::max(std::fabs(x.lo()), std::fabs(x.hi()));
+}
+
+// the range of the arguments, with and without their errors
+static interval widen(const interval& x, const interval& dx)
+{
+    return exact(std::min(x.lo(), x.lo() - dx.hi()), std::max(x.hi(), x.hi() - dx.lo()));
+}
+
+// bound of |f'| on X for the differentiable unary methods, -1 when unknown
+static double slope(const interval_algebra& A, umth m, const interval& X)
+{
+    using I = interval_algebra;
+    if ((m == &I::Abs) || (m == &I::Tanh) || (m == &I::Atan) || (m == &I::Asinh)) return 1;
+    if (m == &I::Sin) return mag(A.Cos(X));
+    if (m == &I::Cos) return mag(A.Sin(X));
+    if (m == &I::Exp) return mag(A.Exp(X));
+    if (m == &I::Sinh) return mag(A.Cosh(X));
+    if (m == &I::Cosh) return mag(A.Sinh(X));
+    if (m == &I::Tan) return 1 + mag(A.Tan(X)) * mag(A.Tan(X));
+    if (m == &I::Log) return (X.lo() > 0) ? 1 / X.lo() : HUGE_VAL;
+    if (m == &I::Log10) return (X.lo() > 0) ? 1 / (X.lo() * M_LN10) : HUGE_VAL;
+    if (m == &I::Sqrt) return (X.lo() > 0) ? 0.5 / std::sqrt(X.lo()) : HUGE_VAL;
+    if (m == &I::Acosh) return (X.lo() > 1) ? 1 / std::sqrt(X.lo() * X.lo() - 1) : HUGE_VAL;
+    if ((m == &I::Asin) || (m == &I::Acos)) return (mag(X) < 1) ? 1 / std::sqrt(1 - mag(X) * mag(X)) : HUGE_VAL;
+    if (m == &I::Atanh) return (mag(X) < 1) ? 1 / (1 - mag(X) * mag(X)) : HUGE_VAL;
+    if (m == &I::Inv) {
+        double d = std::min(std::fabs(X.lo()), std::fabs(X.hi()));
+        return X.hasZero() ? HUGE_VAL : 1 / (d * d);
+    }
+    return -1;
+}
+
+static bool increasing(umth m)
+{
+    using I = interval_algebra;
+    return (m == &I::Exp) || (m == &I::Sinh) || (m == &I::Tanh) || (m == &I::Atan) || (m == &I::Asinh) ||
+           (m == &I::Log) || (m == &I::Log10) || (m == &I::Sqrt) || (m == &I::Asin) || (m == &I::Acosh) ||
+           (m == &I::Atanh);
+}
+
+// the unary methods whose results are rounded to their lsb
+static bool rounded(umth m)
+{
+    using I = interval_algebra;
+    return increasing(m) || (m == &I::Sin) || (m == &I::Cos) || (m == &I::Tan) || (m == &I::Cosh) ||
+           (m == &I::Acos) || (m == &I::Inv);
+}
+
+interval error_algebra::propagate(umth m, const interval& x, const interval& dx) const
+{
+    using I = interval_algebra;
+    if (dx.isZero() || x.isEmpty()) return exact(0, 0);
+    if (m == &I::Neg) return fAlgebra.Neg(dx);
+    if (m == &I::FloatCast) return dx;
+    if (m == &I::Mem) return reunion(dx, exact(0, 0));
+    if ((m == &I::Floor) || (m == &I::Ceil)) return exact(std::floor(dx.lo()), std::ceil(dx.hi()));
+    if ((m == &I::IntCast) || (m == &I::Rint)) return exact(std::floor(dx.lo()) - 1, std::ceil(dx.hi()) + 1);
+
+    interval xe = widen(x, dx);
+    double   s  = slope(fAlgebra, m, xe);
+    if (s < 0) {
+        // no derivative: any value of the image can be computed instead of any other
+        double e = (fAlgebra.*m)(xe).size();
+        return exact(-e, e);
+    }
+    if (std::isinf(s)) return exact(-HUGE_VAL, HUGE_VAL);
+    if (increasing(m)) return fAlgebra.Mul(dx, exact(0, s));
+    return exact(-s * mag(dx), s * mag(dx));
+}
+
+interval error_algebra::propagate(bmth m, const interval& x, const interval& dx, const interval& y,
+                                  const interval& dy) const
+{
+    using I = interval_algebra;
+    if ((dx.isZero() && dy.isZero()) || x.isEmpty() || y.isEmpty()) return exact(0, 0);
+    if (m == &I::Add) return fAlgebra.Add(dx, dy);
+    if (m == &I::Sub) return fAlgebra.Sub(dx, dy);
+    if ((m == &I::Min) || (m == &I::Max)) return reunion(dx, dy);
+    if (m == &I::Delay) return reunion(dx, exact(0, 0));
+    if (m == &I::Mul) {
+        // x'y' - xy = x'.dy + y'.dx - dx.dy
+        const I& A = fAlgebra;
+        return A.Sub(A.Add(A.Mul(x, dy), A.Mul(y, dx)), A.Mul(dx, dy));
+    }
+    if (m == &I::Div) {
+        // |x'/y' - x/y| <= |dx|/|y'| + |x|.|dy|/|y.y'|
+        interval ye = widen(y, dy);
+        if (ye.hasZero()) return exact(-HUGE_VAL, HUGE_VAL);
+        double d = std::min(std::fabs(ye.lo()), std::fabs(ye.hi()));
+        double e = mag(dx) / d + (dy.isZero() ? 0 : mag(widen(x, dx)) * mag(dy) / (d * d));
+        return exact(-e, e);
+    }
+    if (((m == &I::Lsh) || (m == &I::Rsh)) && dy.isZero()) return (fAlgebra.*m)(dx, y);
+    double e = (fAlgebra.*m)(widen(x, dx), widen(y, dy)).size();
+    return exact(-e, e);
+}
+
+error_interval error_algebra::apply(umth m, const error_interval& x) const
+{
+    if (x.isEmpty()) return {};
+    interval z = (fAlgebra.*m)(x.value());
+    interval e = propagate(m, x.value(), x.error());
+    if (rounded(m)) {
+        double u = std::ldexp(1.0, z.lsb() - 1);
+        e        = fAlgebra.Add(e, exact(-u, u));
+    }
+    if ((m == &interval_algebra::FloatCast) && fAlgebra.isFloat32()) {
+        double u = std::max(std::ldexp(mag(z), -24), std::ldexp(1.0, -150));  // half the spacing of the subnormals
+        e        = fAlgebra.Add(e, exact(-u, u));
+    }
+    return {z, e};
+}
+
+error_interval error_algebra::apply(bmth m, const error_interval& x, const error_interval& y) const
+{
+    using I = interval_algebra;
+    if (x.isEmpty() || y.isEmpty()) return {};
+    interval z = (fAlgebra.*m)(x.value(), y.value());
+    interval e = propagate(m, x.value(), x.error(), y.value(), y.error());
+    if ((m == &I::Div) || (m == &I::Atan2) || ((m == &I::Pow) && (z.lsb() < 0))) {
+        double u = std::ldexp(1.0, z.lsb() - 1);
+        e        = fAlgebra.Add(e, exact(-u, u));
+    }
+    return {z, e};
+}
+
+error_interval error_algebra::Quantize(const error_interval& x, int lsb) const
+{
+    if (x.isEmpty() || (lsb <= x.lsb())) return x;
+    double u = std::ldexp(1.0, lsb - 1);
+    return {interval(x.value().lo() - u, x.value().hi() + u, lsb), fAlgebra.Add(x.error(), exact(-u, u))};
+}
+
+//------------------------------------------------------------------------------------------
+// methods
+
+error_interval error_algebra::Label(const std::string& x) const
+{
+    return error_interval(fAlgebra.Label(x));
+}
+
+error_interval error_algebra::IntNum(int x) const
+{
+    return error_interval(fAlgebra.IntNum(x));
+}
+
+error_interval error_algebra::FloatNum(double x) const
+{
+    // the constant is rounded to its lsb
+    interval v = fAlgebra.FloatNum(x);
+    return {v, exact(v.lo() - x, v.lo() - x)};
+}
+
+error_interval error_algebra::Button(const error_interval& name) const
+{
+    return error_interval(fAlgebra.Button(name.value()));
+}
+
+error_interval error_algebra::Checkbox(const error_interval& name) const
+{
+    return error_interval(fAlgebra.Checkbox(name.value()));
+}
+
+error_interval error_algebra::VSlider(const error_interval& name, const error_interval& init,
+                                      const error_interval& lo, const error_interval& hi,
+                                      const error_interval& step) const
+{
+    return error_interval(fAlgebra.VSlider(name.value(), init.value(), lo.value(), hi.value(), step.value()));
+}
+
+error_interval error_algebra::HSlider(const error_interval& name, const error_interval& init,
+                                      const error_interval& lo, const error_interval& hi,
+                                      const error_interval& step) const
+{
+    return error_interval(fAlgebra.HSlider(name.value(), init.value(), lo.value(), hi.value(), step.value()));
+}
+
+error_interval error_algebra::NumEntry(const error_interval& name, const error_interval& init,
+                                       const error_interval& lo, const error_interval& hi,
+                                       const error_interval& step) const
+{
+    return error_interval(fAlgebra.NumEntry(name.value(), init.value(), lo.value(), hi.value(), step.value()));
+}
+
+error_interval error_algebra::Abs(const error_interval& x) const
+{
+    return apply(&interval_algebra::Abs, x);
+}
+
+error_interval error_algebra::Add(const error_interval& x, const error_interval& y) const
+{
+    return apply(&interval_algebra::Add, x, y);
+}
+
+error_interval error_algebra::Sub(const error_interval& x, const error_interval& y) const
+{
+    return apply(&interval_algebra::Sub, x, y);
+}
+
+error_interval error_algebra::Mul(const error_interval& x, const error_interval& y) const
+{
+    return apply(&interval_algebra::Mul, x, y);
+}
+
+error_interval error_algebra::Div(const error_interval& x, const error_interval& y) const
+{
+    return apply(&interval_algebra::Div, x, y);
+}
+
+error_interval error_algebra::Inv(const error_interval& x) const
+{
+    return apply(&interval_algebra::Inv, x);
+}
+
+error_interval error_algebra::Neg(const error_interval& x) const
+{
+    return apply(&interval_algebra::Neg, x);
+}
+
+error_interval error_algebra::Mod(const error_interval& x, const error_interval& y) const
+{
+    return apply(static_cast<bmth>(&interval_algebra::Mod), x, y);
+}
+
+error_interval error_algebra::Acos(const error_interval& x) const
+{
+    return apply(&interval_algebra::Acos, x);
+}
+
+error_interval error_algebra::Acosh(const error_interval& x) const
+{
+    return apply(&interval_algebra::Acosh, x);
+}
+
+error_interval error_algebra::And(const error_interval& x, const error_interval& y) const
+{
+    return apply(&interval_algebra::And, x, y);
+}
+
+error_interval error_algebra::Asin(const error_interval& x) const
+{
+    return apply(&interval_algebra::Asin, x);
+}
+
+error_interval error_algebra::Asinh(const error_interval& x) const
+{
+    return apply(&interval_algebra::Asinh, x);
+}
+
+error_interval error_algebra::Atan(const error_interval& x) const
+{
+    return apply(&interval_algebra::Atan, x);
+}
+
+error_interval error_algebra::Atan2(const error_interval& x, const error_interval& y) const
+{
+    return apply(&interval_algebra::Atan2, x, y);
+}
+
+error_interval error_algebra::Atanh(const error_interval& x) const
+{
+    return apply(&interval_algebra::Atanh, x);
+}
+
+error_interval error_algebra::Ceil(const error_interval& x) const
+{
+    return apply(&interval_algebra::Ceil, x);
+}
+
+error_interval error_algebra::Cos(const error_interval& x) const
+{
+    return apply(&interval_algebra::Cos, x);
+}
+
+error_interval error_algebra::Cosh(const error_interval& x) const
+{
+    return apply(&interval_algebra::Cosh, x);
+}
+
+error_interval error_algebra::Delay(const error_interval& x, const error_interval& y) const
+{
+    return apply(&interval_algebra::Delay, x, y);
+}
+
+error_interval error_algebra::Eq(const error_interval& x, const error_interval& y) const
+{
+    return apply(&interval_algebra::Eq, x, y);
+}
+
+error_interval error_algebra::Exp(const error_interval& x) const
+{
+    return apply(&interval_algebra::Exp, x);
+}
+
+error_interval error_algebra::FloatCast(const error_interval& x) const
+{
+    return apply(&interval_algebra::FloatCast, x);
+}
+
+error_interval error_algebra::Floor(const error_interval& x) const
+{
+    return apply(&interval_algebra::Floor, x);
+}
+
+error_interval error_algebra::Ge(const error_interval& x, const error_interval& y) const
+{
+    return apply(&interval_algebra::Ge, x, y);
+}
+
+error_interval error_algebra::Gt(const error_interval& x, const error_interval& y) const
+{
+    return apply(&interval_algebra::Gt, x, y);
+}
+
+error_interval error_algebra::IntCast(const error_interval& x) const
+{
+    return apply(&interval_algebra::IntCast, x);
+}
+
+error_interval error_algebra::Le(const error_interval& x, const error_interval& y) const
+{
+    return apply(&interval_algebra::Le, x, y);
+}
+
+error_interval error_algebra::Log(const error_interval& x) const
+{
+    return apply(&interval_algebra::Log, x);
+}
+
+error_interval error_algebra::Log10(const error_interval& x) const
+{
+    return apply(&interval_algebra::Log10, x);
+}
+
+error_interval error_algebra::Lsh(const error_interval& x, const error_interval& y) const
+{
+    return apply(&interval_algebra::Lsh, x, y);
+}
+
+error_interval error_algebra::Lt(const error_interval& x, const error_interval& y) const
+{
+    return apply(&interval_algebra::Lt, x, y);
+}
+
+error_interval error_algebra::Max(const error_interval& x, const error_interval& y) const
+{
+    return apply(&interval_algebra::Max, x, y);
+}
+
+error_interval error_algebra::Mem(const error_interval& x) const
+{
+    return apply(&interval_algebra::Mem, x);
+}
+
+error_interval error_algebra::Min(const error_interval& x, const error_interval& y) const
+{
+    return apply(&interval_algebra::Min, x, y);
+}
+
+error_interval error_algebra::Ne(const error_interval& x, const error_interval& y) const
+{
+    return apply(&interval_algebra::Ne, x, y);
+}
+
+error_interval error_algebra::Not(const error_interval& x) const
+{
+    return apply(&interval_algebra::Not, x);
+}
+
+error_interval error_algebra::Or(const error_interval& x, const error_interval& y) const
+{
+    return apply(&interval_algebra::Or, x, y);
+}
+
+error_interval error_algebra::Pow(const error_interval& x, const error_interval& y) const
+{
+    return apply(&interval_algebra::Pow, x, y);
+}
+
+error_interval error_algebra::RdTbl(const error_interval& tbl, const error_interval& index) const
+{
+    if (index.isEmpty() || tbl.isEmpty()) return {};
+    if (index.error().isZero()) return tbl;
+    // an inexact index can read another cell than the exact one
+    const interval& v = tbl.value();
+    const interval& x = tbl.exact();
+    return {v, reunion(tbl.error(), exact(std::nextafter(v.lo() - x.hi(), -HUGE_VAL),
+                                          std::nextafter(v.hi() - x.lo(), HUGE_VAL)))};
+}
+
+error_interval error_algebra::Remainder(const error_interval& x) const
+{
+    return apply(&interval_algebra::Remainder, x);
+}
+
+error_interval error_algebra::Rint(const error_interval& x) const
+{
+    return apply(&interval_algebra::Rint, x);
+}
+
+error_interval error_algebra::Rsh(const error_interval& x, const error_interval& y) const
+{
+    return apply(&interval_algebra::Rsh, x, y);
+}
+
+// The computed selector chooses among the branches reachable with its values, the exact one among the branches
+// reachable with its exact values: the error is the difference of a computed branch and an exact branch.
+error_interval error_algebra::select(const error_interval& s,
+                                     std::initializer_list<const error_interval*> branches) const
+{
+    if (s.isEmpty()) return {};
+    int      n  = int(branches.size());
+    unsigned bv = fAlgebra.selectBranches(s.value(), n);
+    unsigned be = fAlgebra.selectBranches(s.exact(), n);
+    interval z(NAN, NAN), e(NAN, NAN);
+    for (int i = 0; i < n; i++) {
+        if ((bv & (1U << i)) == 0) continue;
+        const error_interval& x = *branches.begin()[i];
+        z                       = reunion(z, x.value());
+        for (int j = 0; j < n; j++) {
+            if ((be & (1U << j)) == 0) continue;
+            // the same branch keeps its error, another one differs by the distance of the two values
+            const interval& y = branches.begin()[j]->exact();
+            e = reunion(e, (i == j) ? x.error()
+                                    : exact(std::nextafter(x.value().lo() - y.hi(), -HUGE_VAL),
+                                            std::nextafter(x.value().hi() - y.lo(), HUGE_VAL)));
+        }
+    }
+    if (z.isEmpty()) return {};
+    return {z, e.isEmpty() ? exact(0, 0) : e};
+}
+
+error_interval error_algebra::Select2(const error_interval& s, const error_interval& x, const error_interval& y) const
+{
+    return select(s, {&x, &y});
+}
+
+error_interval error_algebra::Select3(const error_interval& s, const error_interval& x, const error_interval& y,
+                                      const error_interval& z) const
+{
+    return select(s, {&x, &y, &z});
+}
+
+error_interval error_algebra::Sin(const error_interval& x) const
+{
+    return apply(&interval_algebra::Sin, x);
+}
+
+error_interval error_algebra::Sinh(const error_interval& x) const
+{
+    return apply(&interval_algebra::Sinh, x);
+}
+
+error_interval error_algebra::Sqrt(const error_interval& x) const
+{
+    return apply(&interval_algebra::Sqrt, x);
+}
+
+error_interval error_algebra::Tan(const error_interval& x) const
+{
+    return apply(&interval_algebra::Tan, x);
+}
+
+error_interval error_algebra::Tanh(const error_interval& x) const
+{
+    return apply(&interval_algebra::Tanh, x);
+}
+
+error_interval error_algebra::WrTbl(const error_interval& n, const error_interval& init,
+                                    const error_interval& index, const error_interval& value) const
+{
+    if (n.isEmpty()) return {};
+    if (index.isEmpty() || value.isEmpty()) return init;  // read only table
+    interval e = reunion(init.error(), value.error());
+    if (!index.error().isZero()) {
+        // an inexact index can write another cell than the exact one, the cells mix the init and written values
+        for (const error_interval* a : {&init, &value}) {
+            for (const error_interval* b : {&init, &value}) {
+                e = reunion(e, exact(std::nextafter(a->value().lo() - b->exact().hi(), -HUGE_VAL),
+                                     std::nextafter(a->value().hi() - b->exact().lo(), HUGE_VAL)));
+            }
+        }
+    }
+    return {reunion(init.value(), value.value()), e};
+}
+
+error_interval error_algebra::Xor(const error_interval& x, const error_interval& y) const
+{
+    return apply(&interval_algebra::Xor, x, y);
+}
+
+//------------------------------------------------------------------------------------------
+// tests
+
+void testErrorAlgebra()
+{
+    error_algebra A;
+
+    // integer paths are exact
+    error_interval n = A.Add(A.Mul(A.IntNum(3), A.IntNum(5)), A.IntNum(-2));
+    check("test error IntNum", n.value(), interval(13));
+    check("test error integer", n.absError() == 0, true);
+
+    // a constant with more bits than the precision is rounded
+    error_interval c = A.FloatNum(0.1);
+    check("test error FloatNum", (c.absError() > 0) && (c.absError() <= std::ldexp(1.0, -24)), true);
+    check("test error FloatNum exact", c.exact().has(0.1), true);
+    check("test error FloatNum dyadic", A.FloatNum(0.375).absError() == 0, true);
+
+    // the errors are scaled by the arithmetic and accumulated
+    error_interval h = A.HSlider(A.Label("x"), A.IntNum(0), A.IntNum(-1), A.IntNum(1), A.FloatNum(0.001));
+    error_interval x = A.Quantize(h, -8);
+    check("test error Quantize", x.absError() == std::ldexp(1.0, -9), true);
+    check("test error Mul", A.Mul(x, A.IntNum(4)).absError() == std::ldexp(1.0, -7), true);
+    check("test error Add", A.Add(x, A.Mul(x, A.IntNum(3))).absError() == std::ldexp(1.0, -7), true);
+    check("test error Sub", A.Sub(x, x).absError() == std::ldexp(1.0, -8), true);  // no correlation
+
+    // the transcendental functions scale by their derivative and round their result
+    error_interval s = A.Sin(x);
+    check("test error Sin",
+          (s.absError() >= std::ldexp(1.0, -25)) && (s.absError() <= std::ldexp(1.0, -9) + std::ldexp(1.0, -25)), true);
+    check("test error Exp", A.Exp(A.Add(x, A.IntNum(2))).absError() > 7 * std::ldexp(1.0, -9), true);
+    check("test error precision", error_algebra(-12).Sin(A.IntNum(1)).absError() == std::ldexp(1.0, -13), true);
+    check("test error Log", std::isinf(A.Log(x).absError()), true);
+
+    // float32 rounding is relative to the magnitude of the values
+    error_algebra  F(-24, true);
+    error_interval f = F.FloatCast(F.Mul(F.IntNum(1000), x));
+    double         e = 1000 * std::ldexp(1.0, -9);  // the error of x, scaled
+    check("test error float32", (f.absError() > e) && (f.absError() <= e + std::ldexp(1024.0, -24)), true);
+    check("test error float32 subnormal", F.FloatCast(F.FloatNum(1e-40)).absError() >= std::ldexp(1.0, -150), true);
+    check("test error float32 overflow", std::isinf(F.FloatCast(F.FloatNum(1e39)).absError()), true);
+
+    // a recursive filter y = x + 0.5*y', unrolled
+    error_interval y = x;
+    for (int i = 0; i < 20; i++) y = A.Add(x, A.Mul(A.Mem(y), A.FloatNum(0.5)));
+    check("test error filter", y.absError() < 2 * std::ldexp(1.0, -9) * 1.0001, true);
+    testout() << "filter: " << y << '\n';
+
+    // an exact selector keeps the error of the branch, an inexact one adds the distance to the other branch
+    error_interval bx(interval(0, 1), interval(-1e-9, 1e-9, kMinLSB));
+    error_interval by(interval(10, 11));
+    check("test error Select2", A.Select2(A.IntNum(0), bx, by).absError() == 1e-9, true);
+    error_interval bs(interval(0, 0, 0), interval(-1, 0, 0));  // the exact selector can be 1
+    check("test error Select2 selector", A.Select2(bs, bx, by).absError() >= 10, true);
+
+    // the cells of a table keep the errors of their values, an inexact index mixes the cells
+    error_interval tbl = A.WrTbl(A.IntNum(8), A.IntNum(0), A.IntNum(3), bx);
+    check("test error WrTbl", A.RdTbl(tbl, A.IntNum(3)).absError() == 1e-9, true);
+    error_interval bi(interval(3, 3, 0), interval(0, 1, 0));
+    check("test error RdTbl index", A.RdTbl(A.WrTbl(A.IntNum(8), by, bi, by), bi).absError() >= 1, true);
+}
+
+}  // namespace itv
@@ -0,0 +1,124 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <initializer_list>
+#include <string>
+
+#include "check.hh"
+#include "error_interval.hh"
+#include "faust_algebra.hh"
+#include "interval_algebra.hh"
+
+namespace itv {
+
+// The faust algebra on error intervals. The values are computed by
+// interval_algebra, with the lsb of their node. The errors of the arguments
+// are propagated to the result: exactly for the affine methods, with
+// the product rule for Mul and Div, and with a bound of the derivative on the
+// range of the arguments for the differentiable functions. The results of the
+// functions that are not exact (transcendental functions, Inv, Div) are
+// rounded to their lsb, which adds half an lsb of error. A signal is rounded to
+// a coarser fixed-point format by Quantize. In float32 mode, FloatCast adds the
+// relative error of the rounding to float32, half an ulp.
+class error_algebra : public faust_algebra<error_interval> {
+   private:
+    interval_algebra fAlgebra;
+
+   public:
+    explicit error_algebra(int precision = -24, bool float32 = false) : fAlgebra(precision, float32) {}
+
+    error_interval Label(const std::string& x) const;
+    error_interval IntNum(int x) const;
+    error_interval FloatNum(double x) const;
+    error_interval Button(const error_interval& name) const;
+    error_interval Checkbox(const error_interval& name) const;
+    error_interval VSlider(const error_interval& name, const error_interval& init, const error_interval& lo,
+                           const error_interval& hi, const error_interval& step) const;
+    error_interval HSlider(const error_interval& name, const error_interval& init, const error_interval& lo,
+                           const error_interval& hi, const error_interval& step) const;
+    error_interval NumEntry(const error_interval& name, const error_interval& init, const error_interval& lo,
+                            const error_interval& hi, const error_interval& step) const;
+    error_interval Abs(const error_interval& x) const;
+    error_interval Add(const error_interval& x, const error_interval& y) const;
+    error_interval Sub(const error_interval& x, const error_interval& y) const;
+    error_interval Mul(const error_interval& x, const error_interval& y) const;
+    error_interval Div(const error_interval& x, const error_interval& y) const;
+    error_interval Inv(const error_interval& x) const;
+    error_interval Neg(const error_interval& x) const;
+    error_interval Mod(const error_interval& x, const error_interval& y) const;
+    error_interval Acos(const error_interval& x) const;
+    error_interval Acosh(const error_interval& x) const;
+    error_interval And(const error_interval& x, const error_interval& y) const;
+    error_interval Asin(const error_interval& x) const;
+    error_interval Asinh(const error_interval& x) const;
+    error_interval Atan(const error_interval& x) const;
+    error_interval Atan2(const error_interval& x, const error_interval& y) const;
+    error_interval Atanh(const error_interval& x) const;
+    error_interval Ceil(const error_interval& x) const;
+    error_interval Cos(const error_interval& x) const;
+    error_interval Cosh(const error_interval& x) const;
+    error_interval Delay(const error_interval& x, const error_interval& y) const;
+    error_interval Eq(const error_interval& x, const error_interval& y) const;
+    error_interval Exp(const error_interval& x) const;
+    error_interval FloatCast(const error_interval& x) const;
+    error_interval Floor(const error_interval& x) const;
+    error_interval Ge(const error_interval& x, const error_interval& y) const;
+    error_interval Gt(const error_interval& x, const error_interval& y) const;
+    error_interval IntCast(const error_interval& x) const;
+    error_interval Le(const error_interval& x, const error_interval& y) const;
+    error_interval Log(const error_interval& x) const;
+    error_interval Log10(const error_interval& x) const;
+    error_interval Lsh(const error_interval& x, const error_interval& y) const;
+    error_interval Lt(const error_interval& x, const error_interval& y) const;
+    error_interval Max(const error_interval& x, const error_interval& y) const;
+    error_interval Mem(const error_interval& x) const;
+    error_interval Min(const error_interval& x, const error_interval& y) const;
+    error_interval Ne(const error_interval& x, const error_interval& y) const;
+    error_interval Not(const error_interval& x) const;
+    error_interval Or(const error_interval& x, const error_interval& y) const;
+    error_interval Pow(const error_interval& x, const error_interval& y) const;
+    error_interval RdTbl(const error_interval& tbl, const error_interval& index) const;
+    error_interval Remainder(const error_interval& x) const;
+    error_interval Rint(const error_interval& x) const;
+    error_interval Rsh(const error_interval& x, const error_interval& y) const;
+    error_interval Select2(const error_interval& s, const error_interval& x, const error_interval& y) const;
+    error_interval Select3(const error_interval& s, const error_interval& x, const error_interval& y,
+                           const error_interval& z) const;
+    error_interval Sin(const error_interval& x) const;
+    error_interval Sinh(const error_interval& x) const;
+    error_interval Sqrt(const error_interval& x) const;
+    error_interval Tan(const error_interval& x) const;
+    error_interval Tanh(const error_interval& x) const;
+    error_interval WrTbl(const error_interval& n, const error_interval& init,
+                         const error_interval& index, const error_interval& value) const;
+    error_interval Xor(const error_interval& x, const error_interval& y) const;
+
+    // x rounded to nearest at a coarser lsb
+    error_interval Quantize(const error_interval& x, int lsb) const;
+
+    // error of m(x), m(x,y) for the errors dx, dy of the arguments, before the rounding of the result
+    interval propagate(umth m, const interval& x, const interval& dx) const;
+    interval propagate(bmth m, const interval& x, const interval& dx, const interval& y, const interval& dy) const;
+
+   private:
+    error_interval apply(umth m, const error_interval& x) const;
+    error_interval apply(bmth m, const error_interval& x, const error_interval& y) const;
+    error_interval select(const error_interval& s, std::initializer_list<const error_interval*> branches) const;
+};
+
+void testErrorAlgebra();
+
+}  // namespace itv
@@ -0,0 +1,65 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "interval_def.hh"
+
+// ***************************************************************************
+//
+//     An error_interval pairs the range of a signal, as computed with the lsb
+//     of its node, with the interval of its accumulated error: the difference
+//     between the computed value and the exact real value of the signal.
+//
+//****************************************************************************
+namespace itv {
+
+class error_interval {
+   private:
+    interval fValue{NAN, NAN};       ///< range of the computed values, with their lsb
+    interval fError{0, 0, kMinLSB};  ///< computed value - exact value
+
+   public:
+    error_interval() = default;  // empty
+
+    explicit error_interval(const interval& value) : fValue(value) {}
+    error_interval(const interval& value, const interval& error) : fValue(value), fError(error) {}
+
+    const interval& value() const { return fValue; }
+    const interval& error() const { return fError; }
+
+    bool isEmpty() const { return fValue.isEmpty(); }
+    int  lsb() const { return fValue.lsb(); }
+
+    // bound of the absolute error
+    double absError() const { return std::max(std::fabs(fError.lo()), std::fabs(fError.hi())); }
+
+    // the exact values are in this range
+    interval exact() const
+    {
+        if (isEmpty()) return fValue;
+        return {fValue.lo() - fError.hi(), fValue.hi() - fError.lo(), kMinLSB};
+    }
+};
+
+inline std::ostream& operator<<(std::ostream& dst, const error_interval& x)
+{
+    return dst << "error_interval(" << x.value() << " +/- " << x.absError() << ")";
+}
+
+}  // namespace itv
@@ -0,0 +1,286 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "check.hh"
+#include "exhaustive.hh"
+#include "interval_algebra.hh"
+#include "interval_def.hh"
+
+namespace itv {
+
+static constexpr int kBlockBits = 16;               // floats per block: 2^16
+static constexpr int kBlockSize = 1 << kBlockBits;  //
+static constexpr int kLevelBits = 4;                // granularity step between two levels of a block
+static constexpr int kTileBits  = 6;                // integers per side of a bitwise tile: 2^6
+static constexpr int kExactLSB  = -149;             // every float32 is a multiple of 2^-149
+
+// a sweep report, with the position of its first unsound result and of its worst ratio,
+// so that the merge of the per thread reports doesn't depend on the scheduling
+struct partial_report {
+    sweep_report r;
+    uint64_t     unsoundKey{UINT64_MAX};
+    uint64_t     worstKey{UINT64_MAX};
+};
+
+/**
+ * @brief Enumerate float32 in increasing order: key 0 is -NAN, key 2^31-1 is -0.0,
+ * key 2^31 is +0.0 and key 2^32-1 is +NAN.
+ */
+static float keyToFloat(uint32_t k)
+{
+    uint32_t bits = ((k & 0x80000000U) != 0) ? (k ^ 0x80000000U) : ~k;
+    float    f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+/**
+ * @brief Check one result Z against the true image [ylo,yhi] of an input shape.
+ * An empty true image (ylo > yhi) means the function is undefined on the whole shape.
+ */
+static void checkShape(partial_report& p, uint64_t key, const interval& X, const interval& Y, const interval& Z,
+                       double ylo, double yhi)
+{
+    p.r.shapes++;
+    if (ylo > yhi) return;  // nothing defined to contain
+
+    double tol = std::ldexp(1.0, Z.lsb());
+    if (Z.isEmpty() || (ylo < Z.lo() - tol) || (yhi > Z.hi() + tol)) {
+        p.r.unsound++;
+        if (key < p.unsoundKey) {
+            p.unsoundKey      = key;
+            p.r.firstUnsound  = X;
+            p.r.firstUnsoundY = Y;
+        }
+        return;
+    }
+    if (std::isinf(ylo) || std::isinf(yhi)) return;  // an unbounded true image can't be loose
+    if (Z.isUnbounded()) {
+        p.r.unbounded++;
+        return;
+    }
+    double ratio = (Z.size() + tol) / (yhi - ylo + tol);
+    if ((ratio > p.r.worstRatio) || ((ratio == p.r.worstRatio) && (key < p.worstKey))) {
+        p.r.worstRatio = ratio;
+        p.worstKey     = key;
+        p.r.worstInput = X;
+    }
+}
+
+static void merge(partial_report& dst, const partial_report& src)
+{
+    dst.r.points += src.r.points;
+    dst.r.shapes += src.r.shapes;
+    dst.r.unsound += src.r.unsound;
+    dst.r.unbounded += src.r.unbounded;
+    if (src.unsoundKey < dst.unsoundKey) {
+        dst.unsoundKey      = src.unsoundKey;
+        dst.r.firstUnsound  = src.r.firstUnsound;
+        dst.r.firstUnsoundY = src.r.firstUnsoundY;
+    }
+    if ((src.r.worstRatio > dst.r.worstRatio) ||
+        ((src.r.worstRatio == dst.r.worstRatio) && (src.worstKey < dst.worstKey))) {
+        dst.r.worstRatio = src.r.worstRatio;
+        dst.worstKey     = src.worstKey;
+        dst.r.worstInput = src.r.worstInput;
+    }
+}
+
+/**
+ * @brief Run task(i, report) for i in [0,count[ on several threads and merge the reports.
+ */
+static sweep_report parallelSweep(const char* title, uint64_t count, unsigned int threads,
+                                  const std::function<void(uint64_t, partial_report&)>& task)
+{
+    if (threads == 0) threads = std::max(1U, std::thread::hardware_concurrency());
+    threads = unsigned(std::min<uint64_t>(threads, std::max<uint64_t>(count, 1)));
+
+    std::atomic<uint64_t>    next{0};
+    std::mutex               lock;
+    partial_report           total;
+    std::vector<std::thread> workers;
+
+    auto work = [&]() {
+        partial_report local;
+        for (uint64_t i = next++; i < count; i = next++) {
+            task(i, local);
+        }
+        std::lock_guard<std::mutex> guard(lock);
+        merge(total, local);
+    };
+    for (unsigned int t = 1; t < threads; t++) workers.emplace_back(work);
+    work();
+    for (auto& w : workers) w.join();
+
+    total.r.title = title;
+    return total.r;
+}
+
+//------------------------------------------------------------------------------------------
+// unary methods over float32 inputs
+
+sweep_report sweepUnaryMethod(const char* title, ufun f, umth m, unsigned int blocks, unsigned int threads)
+{
+    constexpr uint64_t kTotalBlocks = uint64_t(1) << (32 - kBlockBits);
+    blocks                          = unsigned(std::clamp<uint64_t>(blocks, 1, kTotalBlocks));
+
+    return parallelSweep(title, blocks, threads, [=](uint64_t b, partial_report& p) {
+        interval_algebra A;
+        uint64_t         block = b * kTotalBlocks / blocks;
+        uint32_t         first = uint32_t(block << kBlockBits);
+
+        // the input ranges and true images of the shapes of the current level,
+        // undefined values are neutral elements (+inf for the lows, -inf for the highs)
+        // so that the reductions below are plain min/max loops the compiler can vectorize
+        std::vector<double> xlo(kBlockSize), xhi(kBlockSize), ylo(kBlockSize), yhi(kBlockSize);
+
+        for (int i = 0; i < kBlockSize; i++) {
+            double x = keyToFloat(first + uint32_t(i));
+            double y = std::isnan(x) ? NAN : f(x);
+            xlo[i]   = std::isnan(x) ? HUGE_VAL : x;
+            xhi[i]   = std::isnan(x) ? -HUGE_VAL : x;
+            ylo[i]   = std::isnan(y) ? HUGE_VAL : y;
+            yhi[i]   = std::isnan(y) ? -HUGE_VAL : y;
+        }
+        p.r.points += kBlockSize;
+
+        for (int n = kBlockSize; n >= 1; n >>= kLevelBits) {
+            int width = kBlockSize / n;  // number of consecutive floats per shape
+            for (int i = 0; i < n; i++) {
+                if (xlo[i] > xhi[i]) continue;  // only NAN inputs
+                interval X(xlo[i], xhi[i], kExactLSB);
+                checkShape(p, (uint64_t(first) + uint64_t(i) * width) * 32 + n, X, interval(NAN, NAN), (A.*m)(X),
+                           ylo[i], yhi[i]);
+            }
+            if (n == 1) break;
+            // reduce groups of 2^kLevelBits shapes into the shapes of the next level
+            int k = 1 << kLevelBits;
+            for (int i = 0; i < n / k; i++) {
+                double a = HUGE_VAL, b = -HUGE_VAL, c = HUGE_VAL, d = -HUGE_VAL;
+                for (int j = i * k; j < (i + 1) * k; j++) {
+                    a = std::min(a, xlo[j]);
+                    b = std::max(b, xhi[j]);
+                    c = std::min(c, ylo[j]);
+                    d = std::max(d, yhi[j]);
+                }
+                xlo[i] = a;
+                xhi[i] = b;
+                ylo[i] = c;
+                yhi[i] = d;
+            }
+        }
+    });
+}
+
+//------------------------------------------------------------------------------------------
+// binary bitwise methods over all pairs of b-bits integers
+
+sweep_report sweepBitwiseMethod(const char* title, bfun f, bmth m, int bits, unsigned int threads)
+{
+    bits          = std::clamp(bits, 2, 16);
+    int tileBits  = std::min(kTileBits, bits);
+    int side      = 1 << tileBits;          // integers per side of a tile
+    int tiles     = 1 << (bits - tileBits);  // tiles per side of the whole square
+    int origin    = -(1 << (bits - 1));      // smallest b-bits integer
+
+    return parallelSweep(title, uint64_t(tiles) * tiles, threads, [=](uint64_t t, partial_report& p) {
+        interval_algebra A;
+        int              x0 = origin + int(t / tiles) * side;
+        int              y0 = origin + int(t % tiles) * side;
+
+        // zlo/zhi[i*n+j]: true image of the square (i,j) of the current level
+        std::vector<double> zlo(size_t(side) * side), zhi(size_t(side) * side);
+        for (int i = 0; i < side; i++) {
+            for (int j = 0; j < side; j++) {
+                double z                 = f(double(x0 + i), double(y0 + j));
+                zlo[size_t(i) * side + j] = zhi[size_t(i) * side + j] = z;
+            }
+        }
+        p.r.points += uint64_t(side) * side;
+
+        for (int n = side; n >= 1; n >>= 1) {
+            int w = side / n;  // integers per side of a square
+            for (int i = 0; i < n; i++) {
+                for (int j = 0; j < n; j++) {
+                    interval X(x0 + i * w, x0 + i * w + w - 1);
+                    interval Y(y0 + j * w, y0 + j * w + w - 1);
+                    uint64_t key = (t << 32) | (uint64_t(i * w) << 16) | uint64_t(j * w);
+                    checkShape(p, key * 8 + tileBits, X, Y, (A.*m)(X, Y), zlo[size_t(i) * n + j],
+                               zhi[size_t(i) * n + j]);
+                }
+            }
+            if (n == 1) break;
+            // reduce squares of 2x2 squares into the squares of the next level
+            int h = n / 2;
+            for (int i = 0; i < h; i++) {
+                for (int j = 0; j < h; j++) {
+                    size_t a = size_t(2 * i) * n + 2 * j;
+                    size_t b = a + n;
+                    double l = std::min(std::min(zlo[a], zlo[a + 1]), std::min(zlo[b], zlo[b + 1]));
+                    double u = std::max(std::max(zhi[a], zhi[a + 1]), std::max(zhi[b], zhi[b + 1]));
+                    zlo[size_t(i) * h + j] = l;
+                    zhi[size_t(i) * h + j] = u;
+                }
+            }
+        }
+    });
+}
+
+std::ostream& operator<<(std::ostream& dst, const sweep_report& r)
+{
+    dst << r.title << ": " << r.points << " points, " << r.shapes << " shapes, " << r.unsound << " unsound, "
+        << r.unbounded << " unbounded, worst ratio " << r.worstRatio;
+    if (r.unsound > 0) {
+        dst << ", first unsound " << r.firstUnsound;
+        if (!r.firstUnsoundY.isEmpty()) dst << " x " << r.firstUnsoundY;
+    }
+    if (r.worstRatio > 1) dst << ", worst input " << r.worstInput;
+    return dst;
+}
+
+//------------------------------------------------------------------------------------------
+// tests on a small sample of the full sweeps
+
+static double myAnd(double x, double y)
+{
+    return double(saturatedIntCast(x) & saturatedIntCast(y));
+}
+
+void testExhaustive()
+{
+    sweep_report e = sweepUnaryMethod("exp", exp, &interval_algebra::Exp, 4, 1);
+    testout() << e << '\n';
+    check("test exhaustive Exp sound", e.unsound == 0, true);
+    check("test exhaustive Exp points", e.points == 4 * uint64_t(kBlockSize), true);
+
+    sweep_report s = sweepUnaryMethod("floor", floor, &interval_algebra::Floor, 4, 1);
+    testout() << s << '\n';
+    check("test exhaustive Floor sound", s.unsound == 0, true);
+
+    sweep_report a = sweepBitwiseMethod("and", myAnd, &interval_algebra::And, 6, 1);
+    testout() << a << '\n';
+    check("test exhaustive And sound", a.unsound == 0, true);
+    check("test exhaustive And points", a.points == 64 * 64, true);
+}
+
+}  // namespace itv
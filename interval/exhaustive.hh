@@ -0,0 +1,79 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "check.hh"
+#include "interval_def.hh"
+
+namespace itv {
+
+//==============================================================================
+// Exhaustive verification of the interval primitives.
+//
+// Unary methods are checked over the float32 inputs: the 2^32 bit patterns are
+// enumerated in increasing order, grouped in blocks of 2^16 consecutive floats
+// and every block is checked at several granularities (single points, then
+// groups of 2^4, 2^8, 2^12 and 2^16 consecutive floats). Binary bitwise methods
+// are checked over all the pairs of b-bits integers, with square tiles of
+// increasing sizes. The blocks are distributed over several threads.
+//
+// A result is unsound when it misses a true image by more than one lsb of the
+// resulting interval. A result is maximally loose when it is unbounded while
+// the true image is bounded.
+//==============================================================================
+
+struct sweep_report {
+    std::string title;
+    uint64_t    points{0};     ///< number of inputs evaluated with the numerical function
+    uint64_t    shapes{0};     ///< number of input intervals checked
+    uint64_t    unsound{0};    ///< number of results missing a true image
+    uint64_t    unbounded{0};  ///< number of unbounded results for a bounded true image
+    double      worstRatio{1}; ///< worst (computed width / true width) for bounded results
+    interval    firstUnsound{NAN, NAN};  ///< x argument of the first unsound result found
+    interval    firstUnsoundY{NAN, NAN}; ///< y argument of the first unsound result found (binary only)
+    interval    worstInput{NAN, NAN};    ///< x argument of the worst ratio
+};
+
+std::ostream& operator<<(std::ostream& dst, const sweep_report& r);
+
+/**
+ * @brief Check an unary method against its numerical function over float32 inputs.
+ *
+ * @param title name of the tested method
+ * @param f the numerical function of reference
+ * @param m the interval method corresponding to f
+ * @param blocks number of blocks of 2^16 floats to check, evenly spread (65536 for a full sweep)
+ * @param threads number of threads to use (0 for all hardware threads)
+ */
+sweep_report sweepUnaryMethod(const char* title, ufun f, umth m, unsigned int blocks = 65536, unsigned int threads = 0);
+
+/**
+ * @brief Check a binary integer method against its numerical function over all pairs of b-bits integers.
+ *
+ * @param title name of the tested method
+ * @param f the numerical function of reference
+ * @param m the interval method corresponding to f
+ * @param bits width of the signed integers to enumerate, between 2 and 16
+ * @param threads number of threads to use (0 for all hardware threads)
+ */
+sweep_report sweepBitwiseMethod(const char* title, bfun f, bmth m, int bits = 8, unsigned int threads = 0);
+
+void testExhaustive();
+
+}  // namespace itv
@@ -60,14 +60,18 @@ class faust_algebra {
     T Not(const T& x) const;
     T Or(const T& x, const T& y) const;
     T Pow(const T& x, const T& y) const;
+    T RdTbl(const T& tbl, const T& index) const;
     T Remainder(const T& x) const;
     T Rint(const T& x) const;
     T Rsh(const T& x, const T& y) const;
+    T Select2(const T& s, const T& x, const T& y) const;
+    T Select3(const T& s, const T& x, const T& y, const T& z) const;
     T Sin(const T& x) const;
     T Sinh(const T& x) const;
     T Sqrt(const T& x) const;
     T Tan(const T& x) const;
     T Tanh(const T& x) const;
+    T WrTbl(const T& n, const T& init, const T& index, const T& value) const;
     T Xor(const T& x, const T& y) const;
 };
 }  // namespace itv
\ No newline at end of file
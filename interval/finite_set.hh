@@ -0,0 +1,128 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <type_traits>
+
+#include "interval_def.hh"
+
+// ***************************************************************************
+//
+//     A finite_set is a sorted set of at most kFiniteValues values stored
+//     inline, like the values {0,1} of a button or the few values of a
+//     stepped numerical entry. When a result has more values, or when some
+//     values are undefined, only its range is kept as an interval.
+//
+//****************************************************************************
+namespace itv {
+
+constexpr int kFiniteValues = 16;
+
+class finite_set {
+   private:
+    std::array<double, kFiniteValues> fValues{};
+    int                               fCount{0};         ///< number of values, -1 when only fRange is known
+    interval                          fRange{NAN, NAN};  ///< range of the values when they are not known
+
+   public:
+    finite_set() = default;  // empty
+
+    explicit finite_set(const interval& x)
+    {
+        if (!x.isEmpty()) {
+            fCount = -1;
+            fRange = x;
+        }
+    }
+
+    /**
+     * @brief The set of the values v[0..n[, sorted and without duplicates, or
+     * their range when there are more than kFiniteValues distinct values. The
+     * NAN values must have been removed. The array v is used as work space.
+     */
+    static finite_set fromValues(double* v, int n)
+    {
+        std::sort(v, v + n);
+        n = int(std::unique(v, v + n) - v);
+        finite_set r;
+        if (n > kFiniteValues) {
+            r.fCount = -1;
+            r.fRange = hull(v, n);
+        } else {
+            std::copy(v, v + n, r.fValues.begin());
+            r.fCount = n;
+        }
+        return r;
+    }
+
+    bool isExact() const { return fCount >= 0; }
+    bool isEmpty() const { return fCount == 0; }
+
+    // the values of an exact set
+    int           count() const { return std::max(fCount, 0); }
+    double        operator[](int i) const { return fValues[i]; }
+    const double* begin() const { return fValues.data(); }
+    const double* end() const { return fValues.data() + count(); }
+
+    bool has(double x) const
+    {
+        if (!isExact()) return fRange.has(x);
+        return std::binary_search(begin(), end(), x);
+    }
+
+    // the smallest interval containing the values, with lsb 0 for sets of integers
+    interval toInterval() const
+    {
+        if (!isExact()) return fRange;
+        if (fCount == 0) return {NAN, NAN};
+        return hull(fValues.data(), fCount);
+    }
+
+   private:
+    static interval hull(const double* v, int n)
+    {
+        bool integers = std::all_of(v, v + n, [](double x) { return std::isinf(x) || (x == std::floor(x)); });
+        interval x(v[0], v[n - 1], integers ? 0 : -24);
+        return (x.hi() < v[n - 1]) ? interval(x.lo(), v[n - 1] + std::ldexp(1.0, x.lsb()), x.lsb()) : x;
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<finite_set>, "finite_set must not allocate");
+
+inline std::ostream& operator<<(std::ostream& dst, const finite_set& x)
+{
+    if (!x.isExact()) return dst << "finite_set(" << x.toInterval() << ')';
+    dst << "finite_set{";
+    for (int i = 0; i < x.count(); i++) dst << ((i > 0) ? "," : "") << x[i];
+    return dst << '}';
+}
+
+inline bool operator==(const finite_set& x, const finite_set& y)
+{
+    if (x.isExact() != y.isExact()) return false;
+    if (!x.isExact()) return x.toInterval() == y.toInterval();
+    return std::equal(x.begin(), x.end(), y.begin(), y.end());
+}
+
+inline bool operator!=(const finite_set& x, const finite_set& y)
+{
+    return !(x == y);
+}
+
+}  // namespace itv
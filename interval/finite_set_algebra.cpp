@@ -0,0 +1,483 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <initializer_list>
+#include <sstream>
+#include <string>
+
+#include "check.hh"
+#include "finite_set.hh"
+#include "finite_set_algebra.hh"
+#include "interval_def.hh"
+#include "reference_functions.hh"
+
+namespace itv {
+
+//------------------------------------------------------------------------------------------
+// enumeration of the values
+
+finite_set finite_set_algebra::map(ufun f, umth m, const finite_set& x) const
+{
+    if (!x.isExact()) return finite_set((fAlgebra.*m)(x.toInterval()));
+    std::array<double, kFiniteValues> v;
+    int                               n = 0;
+    for (double a : x) {
+        v[n] = f(a);
+        if (std::isnan(v[n++])) return finite_set((fAlgebra.*m)(x.toInterval()));
+    }
+    return finite_set::fromValues(v.data(), n);
+}
+
+finite_set finite_set_algebra::map(bfun f, bmth m, const finite_set& x, const finite_set& y) const
+{
+    if (!x.isExact() || !y.isExact()) return finite_set((fAlgebra.*m)(x.toInterval(), y.toInterval()));
+    std::array<double, kFiniteValues * kFiniteValues> v;
+    int                                               n = 0;
+    for (double a : x) {
+        for (double b : y) {
+            v[n] = f(a, b);
+            if (std::isnan(v[n++])) return finite_set((fAlgebra.*m)(x.toInterval(), y.toInterval()));
+        }
+    }
+    return finite_set::fromValues(v.data(), n);
+}
+
+// the values lo, lo+step, lo+2*step, ... of a slider, up to hi included
+finite_set finite_set_algebra::steps(const finite_set& lo, const finite_set& hi, const finite_set& step) const
+{
+    interval range = fAlgebra.NumEntry(interval{}, interval{}, lo.toInterval(), hi.toInterval(), step.toInterval());
+    if ((lo.count() != 1) || (hi.count() != 1) || (step.count() != 1)) return finite_set(range);
+    double a = lo[0];
+    double b = hi[0];
+    double s = step[0];
+    if (!(s > 0) || !(a <= b) || !((b - a) / s < kFiniteValues)) return finite_set(range);
+
+    std::array<double, kFiniteValues + 1> v;
+    int                                   n = 0;
+    for (int i = 0; a + i * s < b; i++) v[n++] = a + i * s;
+    v[n++] = b;
+    return finite_set::fromValues(v.data(), n);
+}
+
+//------------------------------------------------------------------------------------------
+// methods
+
+finite_set finite_set_algebra::Label(const std::string& x) const
+{
+    return finite_set(fAlgebra.Label(x));
+}
+
+finite_set finite_set_algebra::IntNum(int x) const
+{
+    double v = x;
+    return finite_set::fromValues(&v, 1);
+}
+
+finite_set finite_set_algebra::FloatNum(double x) const
+{
+    if (std::isnan(x)) return {};
+    double v = x;
+    return finite_set::fromValues(&v, 1);
+}
+
+finite_set finite_set_algebra::Button(const finite_set& name) const
+{
+    double v[2]{0, 1};
+    return finite_set::fromValues(v, 2);
+}
+
+finite_set finite_set_algebra::Checkbox(const finite_set& name) const
+{
+    double v[2]{0, 1};
+    return finite_set::fromValues(v, 2);
+}
+
+finite_set finite_set_algebra::VSlider(const finite_set& name, const finite_set& init, const finite_set& lo,
+                                       const finite_set& hi, const finite_set& step) const
+{
+    return steps(lo, hi, step);
+}
+
+finite_set finite_set_algebra::HSlider(const finite_set& name, const finite_set& init, const finite_set& lo,
+                                       const finite_set& hi, const finite_set& step) const
+{
+    return steps(lo, hi, step);
+}
+
+finite_set finite_set_algebra::NumEntry(const finite_set& name, const finite_set& init, const finite_set& lo,
+                                        const finite_set& hi, const finite_set& step) const
+{
+    return steps(lo, hi, step);
+}
+
+finite_set finite_set_algebra::Abs(const finite_set& x) const
+{
+    return map(fabs, &interval_algebra::Abs, x);
+}
+
+finite_set finite_set_algebra::Add(const finite_set& x, const finite_set& y) const
+{
+    return map(myAdd, &interval_algebra::Add, x, y);
+}
+
+finite_set finite_set_algebra::Sub(const finite_set& x, const finite_set& y) const
+{
+    return map(mySub, &interval_algebra::Sub, x, y);
+}
+
+finite_set finite_set_algebra::Mul(const finite_set& x, const finite_set& y) const
+{
+    return map(myMul, &interval_algebra::Mul, x, y);
+}
+
+finite_set finite_set_algebra::Div(const finite_set& x, const finite_set& y) const
+{
+    return map(myDiv, &interval_algebra::Div, x, y);
+}
+
+finite_set finite_set_algebra::Inv(const finite_set& x) const
+{
+    return map(myInv, &interval_algebra::Inv, x);
+}
+
+finite_set finite_set_algebra::Neg(const finite_set& x) const
+{
+    return map(myNeg, &interval_algebra::Neg, x);
+}
+
+finite_set finite_set_algebra::Mod(const finite_set& x, const finite_set& y) const
+{
+    return map(fmod, &interval_algebra::Mod, x, y);
+}
+
+finite_set finite_set_algebra::Acos(const finite_set& x) const
+{
+    return map(acos, &interval_algebra::Acos, x);
+}
+
+finite_set finite_set_algebra::Acosh(const finite_set& x) const
+{
+    return map(acosh, &interval_algebra::Acosh, x);
+}
+
+finite_set finite_set_algebra::And(const finite_set& x, const finite_set& y) const
+{
+    return map(myAnd, &interval_algebra::And, x, y);
+}
+
+finite_set finite_set_algebra::Asin(const finite_set& x) const
+{
+    return map(asin, &interval_algebra::Asin, x);
+}
+
+finite_set finite_set_algebra::Asinh(const finite_set& x) const
+{
+    return map(asinh, &interval_algebra::Asinh, x);
+}
+
+finite_set finite_set_algebra::Atan(const finite_set& x) const
+{
+    return map(atan, &interval_algebra::Atan, x);
+}
+
+finite_set finite_set_algebra::Atan2(const finite_set& x, const finite_set& y) const
+{
+    return map(atan2, &interval_algebra::Atan2, x, y);
+}
+
+finite_set finite_set_algebra::Atanh(const finite_set& x) const
+{
+    return map(atanh, &interval_algebra::Atanh, x);
+}
+
+finite_set finite_set_algebra::Ceil(const finite_set& x) const
+{
+    return map(ceil, &interval_algebra::Ceil, x);
+}
+
+finite_set finite_set_algebra::Cos(const finite_set& x) const
+{
+    return map(cos, &interval_algebra::Cos, x);
+}
+
+finite_set finite_set_algebra::Cosh(const finite_set& x) const
+{
+    return map(cosh, &interval_algebra::Cosh, x);
+}
+
+finite_set finite_set_algebra::Delay(const finite_set& x, const finite_set& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return {};
+    if (!x.isExact() || !y.isExact()) return finite_set(fAlgebra.Delay(x.toInterval(), y.toInterval()));
+    if ((y.count() == 1) && (y[0] == 0)) return x;
+    // the values of x, and 0 before the first samples
+    std::array<double, kFiniteValues + 1> v;
+    std::copy(x.begin(), x.end(), v.begin());
+    v[x.count()] = 0;
+    return finite_set::fromValues(v.data(), x.count() + 1);
+}
+
+finite_set finite_set_algebra::Eq(const finite_set& x, const finite_set& y) const
+{
+    return map(myEq, &interval_algebra::Eq, x, y);
+}
+
+finite_set finite_set_algebra::Exp(const finite_set& x) const
+{
+    return map(exp, &interval_algebra::Exp, x);
+}
+
+finite_set finite_set_algebra::FloatCast(const finite_set& x) const
+{
+    return map(myId, &interval_algebra::FloatCast, x);
+}
+
+finite_set finite_set_algebra::Floor(const finite_set& x) const
+{
+    return map(floor, &interval_algebra::Floor, x);
+}
+
+finite_set finite_set_algebra::Ge(const finite_set& x, const finite_set& y) const
+{
+    return map(myGe, &interval_algebra::Ge, x, y);
+}
+
+finite_set finite_set_algebra::Gt(const finite_set& x, const finite_set& y) const
+{
+    return map(myGt, &interval_algebra::Gt, x, y);
+}
+
+finite_set finite_set_algebra::IntCast(const finite_set& x) const
+{
+    return map(myIntCast, &interval_algebra::IntCast, x);
+}
+
+finite_set finite_set_algebra::Le(const finite_set& x, const finite_set& y) const
+{
+    return map(myLe, &interval_algebra::Le, x, y);
+}
+
+finite_set finite_set_algebra::Log(const finite_set& x) const
+{
+    return map(log, &interval_algebra::Log, x);
+}
+
+finite_set finite_set_algebra::Log10(const finite_set& x) const
+{
+    return map(log10, &interval_algebra::Log10, x);
+}
+
+finite_set finite_set_algebra::Lsh(const finite_set& x, const finite_set& y) const
+{
+    return map(myLsh, &interval_algebra::Lsh, x, y);
+}
+
+finite_set finite_set_algebra::Lt(const finite_set& x, const finite_set& y) const
+{
+    return map(myLt, &interval_algebra::Lt, x, y);
+}
+
+finite_set finite_set_algebra::Max(const finite_set& x, const finite_set& y) const
+{
+    return map(myMax, &interval_algebra::Max, x, y);
+}
+
+finite_set finite_set_algebra::Mem(const finite_set& x) const
+{
+    return Delay(x, FloatNum(1));
+}
+
+finite_set finite_set_algebra::Min(const finite_set& x, const finite_set& y) const
+{
+    return map(myMin, &interval_algebra::Min, x, y);
+}
+
+finite_set finite_set_algebra::Ne(const finite_set& x, const finite_set& y) const
+{
+    return map(myNe, &interval_algebra::Ne, x, y);
+}
+
+finite_set finite_set_algebra::Not(const finite_set& x) const
+{
+    return map(myNot, &interval_algebra::Not, x);
+}
+
+finite_set finite_set_algebra::Or(const finite_set& x, const finite_set& y) const
+{
+    return map(myOr, &interval_algebra::Or, x, y);
+}
+
+finite_set finite_set_algebra::Pow(const finite_set& x, const finite_set& y) const
+{
+    return map(pow, &interval_algebra::Pow, x, y);
+}
+
+finite_set finite_set_algebra::RdTbl(const finite_set& tbl, const finite_set& index) const
+{
+    if (index.isEmpty()) return {};
+    return tbl;
+}
+
+finite_set finite_set_algebra::Remainder(const finite_set& x) const
+{
+    return finite_set(fAlgebra.Remainder(x.toInterval()));
+}
+
+finite_set finite_set_algebra::Rint(const finite_set& x) const
+{
+    return map(rint, &interval_algebra::Rint, x);
+}
+
+finite_set finite_set_algebra::Rsh(const finite_set& x, const finite_set& y) const
+{
+    return map(myRsh, &interval_algebra::Rsh, x, y);
+}
+
+// the union of the branches chosen by the values of the selector, or by its range when it isn't exact
+static finite_set select(const interval_algebra& A, const finite_set& s,
+                         std::initializer_list<const finite_set*> branches)
+{
+    int      n = int(branches.size());
+    unsigned b = 0;
+    if (s.isExact()) {
+        for (double v : s) b |= A.selectBranches(interval(v), n);
+    } else {
+        b = A.selectBranches(s.toInterval(), n);
+    }
+    std::array<double, 3 * kFiniteValues> v;
+    int                                   m = 0;
+    interval                              r(NAN, NAN);
+    bool                                  exact = true;
+    for (int i = 0; i < n; i++) {
+        if ((b & (1U << i)) == 0) continue;
+        const finite_set& x = *branches.begin()[i];
+        exact               = exact && x.isExact();
+        r                   = reunion(r, x.toInterval());
+        for (double a : x) v[m++] = a;
+    }
+    return exact ? finite_set::fromValues(v.data(), m) : finite_set(r);
+}
+
+finite_set finite_set_algebra::Select2(const finite_set& s, const finite_set& x, const finite_set& y) const
+{
+    return select(fAlgebra, s, {&x, &y});
+}
+
+finite_set finite_set_algebra::Select3(const finite_set& s, const finite_set& x, const finite_set& y,
+                                       const finite_set& z) const
+{
+    return select(fAlgebra, s, {&x, &y, &z});
+}
+
+finite_set finite_set_algebra::Sin(const finite_set& x) const
+{
+    return map(sin, &interval_algebra::Sin, x);
+}
+
+finite_set finite_set_algebra::Sinh(const finite_set& x) const
+{
+    return map(sinh, &interval_algebra::Sinh, x);
+}
+
+finite_set finite_set_algebra::Sqrt(const finite_set& x) const
+{
+    return map(sqrt, &interval_algebra::Sqrt, x);
+}
+
+finite_set finite_set_algebra::Tan(const finite_set& x) const
+{
+    return map(tan, &interval_algebra::Tan, x);
+}
+
+finite_set finite_set_algebra::Tanh(const finite_set& x) const
+{
+    return map(tanh, &interval_algebra::Tanh, x);
+}
+
+finite_set finite_set_algebra::WrTbl(const finite_set& n, const finite_set& init,
+                                     const finite_set& index, const finite_set& value) const
+{
+    if (n.isEmpty()) return {};
+    if (index.isEmpty() || value.isEmpty()) return init;  // read only table
+    if (!init.isExact() || !value.isExact()) return finite_set(reunion(init.toInterval(), value.toInterval()));
+    std::array<double, 2 * kFiniteValues> v;
+    std::copy(init.begin(), init.end(), v.begin());
+    std::copy(value.begin(), value.end(), v.begin() + init.count());
+    return finite_set::fromValues(v.data(), init.count() + value.count());
+}
+
+finite_set finite_set_algebra::Xor(const finite_set& x, const finite_set& y) const
+{
+    return map(myXor, &interval_algebra::Xor, x, y);
+}
+
+//------------------------------------------------------------------------------------------
+// tests
+
+static void check(const std::string& testname, const finite_set& exp, const finite_set& res)
+{
+    std::ostringstream e, r;
+    e << exp;
+    r << res;
+    ::check(testname + " " + e.str() + " == " + r.str(), exp == res, true);
+}
+
+static finite_set values(std::initializer_list<double> l)
+{
+    std::array<double, kFiniteValues> v;
+    std::copy(l.begin(), l.end(), v.begin());
+    return finite_set::fromValues(v.data(), int(l.size()));
+}
+
+void testFiniteSet()
+{
+    finite_set_algebra A;
+    finite_set         b = A.Button(A.Label("b"));
+    finite_set         c = A.Checkbox(A.Label("c"));
+
+    check("test finite Button", values({0, 1}), b);
+    check("test finite Add", values({0, 1, 2}), A.Add(b, c));
+    check("test finite Mul", values({0, 0.5}), A.Mul(b, A.FloatNum(0.5)));
+    check("test finite Eq", values({0}), A.Eq(A.Add(b, c), A.IntNum(3)));  // a constant condition
+    check("test finite Mem", values({0, 3}), A.Mem(A.IntNum(3)));
+    ::check("test finite integers lsb", A.Add(b, c).toInterval().lsb() == 0, true);
+
+    // a stepped entry has a few values, kept exactly through the transcendental functions
+    finite_set e = A.NumEntry(A.Label("e"), A.IntNum(0), A.IntNum(0), A.IntNum(4), A.IntNum(1));
+    check("test finite NumEntry", values({0, 1, 2, 3, 4}), e);
+    check("test finite NumEntry hi", values({0, 3, 4}), A.NumEntry(b, b, A.IntNum(0), A.IntNum(4), A.IntNum(3)));
+    check("test finite Sin", values({std::sin(0.0), std::sin(1.0), std::sin(2.0), std::sin(3.0), std::sin(4.0)}),
+          A.Sin(e));
+    ::check("test finite Sin has", A.Sin(e).has(0.5), false);
+
+    // beyond kFiniteValues, and for undefined values, only the range is kept
+    finite_set f = A.NumEntry(b, b, A.IntNum(0), A.IntNum(1), A.FloatNum(0.01));
+    check("test finite fine step", finite_set(interval(0, 1, -24)), f);
+    finite_set m = A.Mul(A.Add(e, A.Mul(e, A.IntNum(5))), A.Add(e, A.FloatNum(0.5)));
+    ::check("test finite overflow", !m.isExact() && (m.toInterval() == interval(0, 108)), true);
+    ::check("test finite Log", A.Log(A.Sub(b, A.IntNum(1))).isExact(), false);
+    ::check("test finite Inv", A.Inv(b).has(HUGE_VAL), true);
+
+    // the selector {0,2} of Select3 never chooses the second branch
+    check("test finite Select3", values({1, 3}),
+          A.Select3(A.Mul(b, A.FloatNum(2)), A.FloatNum(1), A.FloatNum(2), A.FloatNum(3)));
+
+    finite_set tbl = A.WrTbl(A.FloatNum(8), A.FloatNum(0), A.FloatNum(3), b);
+    check("test finite WrTbl", values({0, 1}), A.RdTbl(tbl, A.FloatNum(3)));
+}
+
+}  // namespace itv
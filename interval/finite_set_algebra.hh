@@ -0,0 +1,109 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <string>
+
+#include "check.hh"
+#include "faust_algebra.hh"
+#include "finite_set.hh"
+#include "interval_algebra.hh"
+
+namespace itv {
+
+// The faust algebra on finite sets. The methods are computed exactly by
+// applying their numerical function to every value, or every pair of values,
+// of their arguments. When an argument is not exact, when a result has more
+// than kFiniteValues values or when a value is undefined, the range of the
+// result is computed by interval_algebra instead.
+class finite_set_algebra : public faust_algebra<finite_set> {
+   private:
+    interval_algebra fAlgebra;
+
+   public:
+    finite_set Label(const std::string& x) const;
+    finite_set IntNum(int x) const;
+    finite_set FloatNum(double x) const;
+    finite_set Button(const finite_set& name) const;
+    finite_set Checkbox(const finite_set& name) const;
+    finite_set VSlider(const finite_set& name, const finite_set& init, const finite_set& lo,
+                       const finite_set& hi, const finite_set& step) const;
+    finite_set HSlider(const finite_set& name, const finite_set& init, const finite_set& lo,
+                       const finite_set& hi, const finite_set& step) const;
+    finite_set NumEntry(const finite_set& name, const finite_set& init, const finite_set& lo,
+                        const finite_set& hi, const finite_set& step) const;
+    finite_set Abs(const finite_set& x) const;
+    finite_set Add(const finite_set& x, const finite_set& y) const;
+    finite_set Sub(const finite_set& x, const finite_set& y) const;
+    finite_set Mul(const finite_set& x, const finite_set& y) const;
+    finite_set Div(const finite_set& x, const finite_set& y) const;
+    finite_set Inv(const finite_set& x) const;
+    finite_set Neg(const finite_set& x) const;
+    finite_set Mod(const finite_set& x, const finite_set& y) const;
+    finite_set Acos(const finite_set& x) const;
+    finite_set Acosh(const finite_set& x) const;
+    finite_set And(const finite_set& x, const finite_set& y) const;
+    finite_set Asin(const finite_set& x) const;
+    finite_set Asinh(const finite_set& x) const;
+    finite_set Atan(const finite_set& x) const;
+    finite_set Atan2(const finite_set& x, const finite_set& y) const;
+    finite_set Atanh(const finite_set& x) const;
+    finite_set Ceil(const finite_set& x) const;
+    finite_set Cos(const finite_set& x) const;
+    finite_set Cosh(const finite_set& x) const;
+    finite_set Delay(const finite_set& x, const finite_set& y) const;
+    finite_set Eq(const finite_set& x, const finite_set& y) const;
+    finite_set Exp(const finite_set& x) const;
+    finite_set FloatCast(const finite_set& x) const;
+    finite_set Floor(const finite_set& x) const;
+    finite_set Ge(const finite_set& x, const finite_set& y) const;
+    finite_set Gt(const finite_set& x, const finite_set& y) const;
+    finite_set IntCast(const finite_set& x) const;
+    finite_set Le(const finite_set& x, const finite_set& y) const;
+    finite_set Log(const finite_set& x) const;
+    finite_set Log10(const finite_set& x) const;
+    finite_set Lsh(const finite_set& x, const finite_set& y) const;
+    finite_set Lt(const finite_set& x, const finite_set& y) const;
+    finite_set Max(const finite_set& x, const finite_set& y) const;
+    finite_set Mem(const finite_set& x) const;
+    finite_set Min(const finite_set& x, const finite_set& y) const;
+    finite_set Ne(const finite_set& x, const finite_set& y) const;
+    finite_set Not(const finite_set& x) const;
+    finite_set Or(const finite_set& x, const finite_set& y) const;
+    finite_set Pow(const finite_set& x, const finite_set& y) const;
+    finite_set RdTbl(const finite_set& tbl, const finite_set& index) const;
+    finite_set Remainder(const finite_set& x) const;
+    finite_set Rint(const finite_set& x) const;
+    finite_set Rsh(const finite_set& x, const finite_set& y) const;
+    finite_set Select2(const finite_set& s, const finite_set& x, const finite_set& y) const;
+    finite_set Select3(const finite_set& s, const finite_set& x, const finite_set& y, const finite_set& z) const;
+    finite_set Sin(const finite_set& x) const;
+    finite_set Sinh(const finite_set& x) const;
+    finite_set Sqrt(const finite_set& x) const;
+    finite_set Tan(const finite_set& x) const;
+    finite_set Tanh(const finite_set& x) const;
+    finite_set WrTbl(const finite_set& n, const finite_set& init,
+                     const finite_set& index, const finite_set& value) const;
+    finite_set Xor(const finite_set& x, const finite_set& y) const;
+
+   private:
+    finite_set map(ufun f, umth m, const finite_set& x) const;
+    finite_set map(bfun f, bmth m, const finite_set& x, const finite_set& y) const;
+    finite_set steps(const finite_set& lo, const finite_set& hi, const finite_set& step) const;
+};
+
+void testFiniteSet();
+
+}  // namespace itv
@@ -0,0 +1,102 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+#include "check.hh"
+#include "float_report.hh"
+#include "interval_algebra.hh"
+#include "interval_def.hh"
+#include "signal_graph.hh"
+
+namespace itv {
+
+static float_suitability suitability(const interval& r, int lsb)
+{
+    float_suitability s;
+    s.range       = r;
+    s.lsb         = lsb;
+    double m      = std::max(std::fabs(r.lo()), std::fabs(r.hi()));
+    s.overflow    = !(m <= FLT_MAX);
+    if (s.overflow) return s;
+    if (m == 0) {
+        s.single = true;  // 0 is exact
+        return s;
+    }
+    int msb      = std::ilogb(m);
+    s.bits       = std::max(0, msb - lsb + 1);
+    s.floatError = std::ldexp(1.0, msb - 24);
+    s.single     = s.bits <= FLT_MANT_DIG;
+    return s;
+}
+
+std::vector<float_suitability> floatSuitability(const signal_graph& g, const std::vector<int>& lsb)
+{
+    std::vector<interval>          R = g.ranges(interval_algebra(kMinLSB));
+    std::vector<float_suitability> r;
+    for (int i = 0; i < g.size(); i++) r.push_back(suitability(R[i], lsb[i]));
+    return r;
+}
+
+std::vector<float_suitability> floatSuitability(const signal_graph& g, int precision)
+{
+    std::vector<interval> R = g.ranges(interval_algebra(precision));
+    std::vector<int>      lsb;
+    for (const interval& x : R) lsb.push_back(std::max(x.lsb(), precision));
+    return floatSuitability(g, lsb);
+}
+
+void printFloatReport(std::ostream& dst, const std::vector<float_suitability>& r)
+{
+    for (size_t i = 0; i < r.size(); i++) {
+        const float_suitability& s = r[i];
+        dst << "node " << i << ": " << s.range << ", lsb " << s.lsb;
+        if (s.overflow) {
+            dst << ", overflows float32";
+        } else {
+            dst << ", " << s.bits << " bits, float32 error " << s.floatError;
+        }
+        dst << " -> " << (s.single ? "float" : "double") << '\n';
+    }
+}
+
+void testFloatReport()
+{
+    using I = interval_algebra;
+
+    // a 16 bits input scaled to [-1,1] fits in float, its square needs 32 bits
+    signal_graph g;
+    int          x  = g.input(interval(-1, 1, -15));
+    int          x2 = g.binary(&I::Mul, x, x);
+    int          b  = g.binary(&I::Mul, x, g.constant(1e30));
+    int          o  = g.binary(&I::Mul, b, b);  // beyond FLT_MAX
+    int          s  = g.unary(&I::Sin, x);
+
+    std::vector<float_suitability> r = floatSuitability(g);
+    printFloatReport(testout(), r);
+    check("test float input", r[x].single, true);
+    check("test float square", r[x2].single, false);
+    check("test float overflow", r[o].overflow && !r[o].single, true);
+    check("test float large", r[b].single, false);
+    check("test float sin", r[s].single && (r[s].bits == 24), true);
+
+    // with the lsb of the word-length optimizer
+    std::vector<int> lsb(size_t(g.size()), -12);
+    check("test float lsb", floatSuitability(g, lsb)[x2].single, true);
+}
+
+}  // namespace itv
@@ -0,0 +1,54 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <iostream>
+#include <vector>
+
+#include "interval_def.hh"
+#include "signal_graph.hh"
+
+namespace itv {
+
+//==============================================================================
+// Float versus double suitability of the nodes of a signal graph.
+//
+// A node can be computed in single precision when its range fits in float32
+// and when the 24 bits of the float32 significand, aligned on the msb of its
+// range, reach the lsb the node requires. The required lsb comes from the
+// word-length optimizer, or from the lsb computed by the algebra, bounded by
+// an absolute precision.
+//==============================================================================
+
+struct float_suitability {
+    interval range;          ///< range of the node
+    int      lsb{0};         ///< required lsb
+    int      bits{0};        ///< significant bits needed: msb - lsb + 1
+    double   floatError{0};  ///< half an ulp of float32 at the largest magnitude of the range
+    bool     overflow{false};  ///< values beyond FLT_MAX (or unbounded)
+    bool     single{false};    ///< float32 is precise enough
+};
+
+// the report for the required lsb of each node
+std::vector<float_suitability> floatSuitability(const signal_graph& g, const std::vector<int>& lsb);
+
+// the report for the lsb of the ranges computed by interval_algebra, bounded by precision
+std::vector<float_suitability> floatSuitability(const signal_graph& g, int precision = -24);
+
+void printFloatReport(std::ostream& dst, const std::vector<float_suitability>& r);
+
+void testFloatReport();
+
+}  // namespace itv
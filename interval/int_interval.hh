@@ -0,0 +1,133 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+
+// ***************************************************************************
+//
+//     An int_interval is an exact interval of int64 values. Operations use
+//     checked arithmetic: a result that can overflow is saturated to the
+//     int64 range and flagged, the flag is then propagated.
+//
+//****************************************************************************
+namespace itv {
+
+constexpr int64_t kInt64Min = std::numeric_limits<int64_t>::min();
+constexpr int64_t kInt64Max = std::numeric_limits<int64_t>::max();
+
+//-------------------------------------------------------------------------
+// checked int64 arithmetic, return true when the operation overflows
+//-------------------------------------------------------------------------
+
+inline bool addOverflow(int64_t a, int64_t b, int64_t& r)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_add_overflow(a, b, &r);
+#else
+    if (((b > 0) && (a > kInt64Max - b)) || ((b < 0) && (a < kInt64Min - b))) return true;
+    r = a + b;
+    return false;
+#endif
+}
+
+inline bool subOverflow(int64_t a, int64_t b, int64_t& r)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_sub_overflow(a, b, &r);
+#else
+    if (((b < 0) && (a > kInt64Max + b)) || ((b > 0) && (a < kInt64Min + b))) return true;
+    r = a - b;
+    return false;
+#endif
+}
+
+inline bool mulOverflow(int64_t a, int64_t b, int64_t& r)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_mul_overflow(a, b, &r);
+#else
+    if ((a == 0) || (b == 0)) {
+        r = 0;
+        return false;
+    }
+    if (((a == -1) && (b == kInt64Min)) || ((b == -1) && (a == kInt64Min))) return true;
+    if ((a > 0) ? ((b > 0) ? (a > kInt64Max / b) : (b < kInt64Min / a))
+                : ((b > 0) ? (a < kInt64Min / b) : (a < kInt64Max / b))) {
+        return true;
+    }
+    r = a * b;
+    return false;
+#endif
+}
+
+class int_interval {
+   private:
+    int64_t fLo{kInt64Min};  ///< minimal value
+    int64_t fHi{kInt64Max};  ///< maximal value
+    bool    fOverflow{false};  ///< the bounds were saturated by an overflow
+
+   public:
+    int_interval() = default;
+
+    int_interval(int64_t n, int64_t m, bool overflow = false) noexcept
+        : fLo(std::min(n, m)), fHi(std::max(n, m)), fOverflow(overflow)
+    {
+    }
+
+    explicit int_interval(int64_t n) noexcept : int_interval(n, n) {}
+
+    static int_interval empty() { return {kInt64Max, kInt64Min, unordered{}}; }
+
+    bool    isEmpty() const { return fLo > fHi; }
+    bool    overflow() const { return fOverflow; }
+    bool    has(int64_t x) const { return (fLo <= x) && (x <= fHi); }
+    bool    isconst() const { return fLo == fHi; }
+    int64_t lo() const { return fLo; }
+    int64_t hi() const { return fHi; }
+
+   private:
+    struct unordered {};
+    int_interval(int64_t lo, int64_t hi, unordered) noexcept : fLo(lo), fHi(hi) {}  // for empty()
+};
+
+inline std::ostream& operator<<(std::ostream& dst, const int_interval& i)
+{
+    if (i.isEmpty()) return dst << "int_interval()";
+    return dst << "int_interval(" << i.lo() << ',' << i.hi() << (i.overflow() ? ",overflow)" : ")");
+}
+
+inline bool operator==(const int_interval& i, const int_interval& j)
+{
+    return (i.isEmpty() && j.isEmpty()) ||
+           ((i.lo() == j.lo()) && (i.hi() == j.hi()) && (i.overflow() == j.overflow()));
+}
+
+inline bool operator!=(const int_interval& i, const int_interval& j)
+{
+    return !(i == j);
+}
+
+inline int_interval reunion(const int_interval& i, const int_interval& j)
+{
+    if (i.isEmpty()) return j;
+    if (j.isEmpty()) return i;
+    return {std::min(i.lo(), j.lo()), std::max(i.hi(), j.hi()), i.overflow() || j.overflow()};
+}
+
+}  // namespace itv
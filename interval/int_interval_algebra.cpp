@@ -0,0 +1,468 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <sstream>
+#include <string>
+
+#include "bitwiseOperations.hh"
+#include "check.hh"
+#include "int_interval.hh"
+#include "int_interval_algebra.hh"
+#include "interval_algebra.hh"
+
+namespace itv {
+
+//------------------------------------------------------------------------------------------
+// saturated bounds: an overflowing bound is replaced by the int64 limit of its sign
+
+// a bound being computed, saturated on overflow
+struct bound {
+    int64_t v{0};
+    bool    overflow{false};
+};
+
+static bound badd(int64_t a, int64_t b)
+{
+    bound r;
+    if (addOverflow(a, b, r.v)) r = {(a < 0) ? kInt64Min : kInt64Max, true};
+    return r;
+}
+
+static bound bsub(int64_t a, int64_t b)
+{
+    bound r;
+    if (subOverflow(a, b, r.v)) r = {(a < 0) ? kInt64Min : kInt64Max, true};
+    return r;
+}
+
+static bound bmul(int64_t a, int64_t b)
+{
+    bound r;
+    if (mulOverflow(a, b, r.v)) r = {((a < 0) != (b < 0)) ? kInt64Min : kInt64Max, true};
+    return r;
+}
+
+// the interval of the bounds b[0..n[, flagged if any of them, or of the arguments, overflowed
+static int_interval hull(const bound* b, int n, bool overflow)
+{
+    int64_t lo = b[0].v;
+    int64_t hi = b[0].v;
+    for (int i = 0; i < n; i++) {
+        lo       = std::min(lo, b[i].v);
+        hi       = std::max(hi, b[i].v);
+        overflow = overflow || b[i].overflow;
+    }
+    return {lo, hi, overflow};
+}
+
+static bool overflow(const int_interval& x, const int_interval& y)
+{
+    return x.overflow() || y.overflow();
+}
+
+static bool isInt32(const int_interval& x)
+{
+    return (x.lo() >= INT_MIN) && (x.hi() <= INT_MAX);
+}
+
+// all the bits up to the msb of n >= 0
+static int64_t bitmask(int64_t n)
+{
+    auto v = uint64_t(n);
+    for (int i = 1; i < 64; i *= 2) v |= v >> i;
+    return int64_t(v);
+}
+
+//------------------------------------------------------------------------------------------
+// injections and conversions
+
+int_interval int_interval_algebra::IntNum(int x) const
+{
+    return int_interval(x);
+}
+
+int_interval int_interval_algebra::Button(const int_interval& name) const
+{
+    return {0, 1};
+}
+
+int_interval int_interval_algebra::Checkbox(const int_interval& name) const
+{
+    return {0, 1};
+}
+
+// truncation of d toward zero, saturated to the int64 range
+static bound truncate(double d)
+{
+    if (d >= 0x1p63) return {kInt64Max, true};
+    if (d < -0x1p63) return {kInt64Min, true};
+    return {int64_t(std::trunc(d)), false};
+}
+
+int_interval int_interval_algebra::IntCast(const interval& x) const
+{
+    if (x.isEmpty()) return int_interval::empty();
+    bound b[2]{truncate(x.lo()), truncate(x.hi())};
+    return hull(b, 2, false);
+}
+
+int_interval int_interval_algebra::IntCast(const int_interval& x) const
+{
+    return x;
+}
+
+interval int_interval_algebra::FloatCast(const int_interval& x) const
+{
+    if (x.isEmpty()) return {NAN, NAN, 0};
+    // int64 values above 2^53 are rounded by the conversion, round them outward
+    double lo = double(x.lo());
+    double hi = double(x.hi());
+    if ((lo >= 0x1p63) || ((lo > -0x1p63) && (int64_t(lo) > x.lo()))) lo = std::nextafter(lo, -HUGE_VAL);
+    if ((hi < 0x1p63) && (hi >= -0x1p63) && (int64_t(hi) < x.hi())) hi = std::nextafter(hi, HUGE_VAL);
+    return {lo, hi, 0};
+}
+
+//------------------------------------------------------------------------------------------
+// arithmetic
+
+int_interval int_interval_algebra::Abs(const int_interval& x) const
+{
+    if (x.isEmpty()) return x;
+    if (x.lo() >= 0) return x;
+    if (x.hi() <= 0) return Neg(x);
+    bound b[2]{bsub(0, x.lo()), {x.hi(), false}};
+    return {0, hull(b, 2, false).hi(), x.overflow() || b[0].overflow};
+}
+
+int_interval int_interval_algebra::Add(const int_interval& x, const int_interval& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return int_interval::empty();
+    bound b[2]{badd(x.lo(), y.lo()), badd(x.hi(), y.hi())};
+    return hull(b, 2, overflow(x, y));
+}
+
+int_interval int_interval_algebra::Sub(const int_interval& x, const int_interval& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return int_interval::empty();
+    bound b[2]{bsub(x.lo(), y.hi()), bsub(x.hi(), y.lo())};
+    return hull(b, 2, overflow(x, y));
+}
+
+int_interval int_interval_algebra::Mul(const int_interval& x, const int_interval& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return int_interval::empty();
+    bound b[4]{bmul(x.lo(), y.lo()), bmul(x.lo(), y.hi()), bmul(x.hi(), y.lo()), bmul(x.hi(), y.hi())};
+    return hull(b, 4, overflow(x, y));
+}
+
+// x/y for y of constant sign: the extrema are on the corners
+static int_interval divide(const int_interval& x, int64_t ylo, int64_t yhi)
+{
+    bound b[4];
+    int   n = 0;
+    for (int64_t a : {x.lo(), x.hi()}) {
+        for (int64_t c : {ylo, yhi}) {
+            b[n++] = ((a == kInt64Min) && (c == -1)) ? bound{kInt64Max, true} : bound{a / c, false};
+        }
+    }
+    return hull(b, 4, x.overflow());
+}
+
+int_interval int_interval_algebra::Div(const int_interval& x, const int_interval& y) const
+{
+    if (x.isEmpty() || y.isEmpty() || ((y.lo() == 0) && (y.hi() == 0))) return int_interval::empty();
+    // the division by zero is undefined, split y into its negative and positive parts
+    int_interval r = int_interval::empty();
+    if (y.lo() < 0) r = reunion(r, divide(x, y.lo(), std::min<int64_t>(y.hi(), -1)));
+    if (y.hi() > 0) r = reunion(r, divide(x, std::max<int64_t>(y.lo(), 1), y.hi()));
+    return y.overflow() ? int_interval(r.lo(), r.hi(), true) : r;
+}
+
+int_interval int_interval_algebra::Neg(const int_interval& x) const
+{
+    if (x.isEmpty()) return x;
+    bound b[2]{bsub(0, x.hi()), bsub(0, x.lo())};
+    return hull(b, 2, x.overflow());
+}
+
+// x % y for x >= 0 and 0 < m1 <= |y| <= m2
+static int_interval positiveMod(int64_t xlo, int64_t xhi, int64_t m1, int64_t m2)
+{
+    if (xhi < m1) return {xlo, xhi};  // the modulo has no effect
+    return {0, std::min(xhi, m2 - 1)};
+}
+
+int_interval int_interval_algebra::Mod(const int_interval& x, const int_interval& y) const
+{
+    if (x.isEmpty() || y.isEmpty() || ((y.lo() == 0) && (y.hi() == 0))) return int_interval::empty();
+
+    // range [m1,m2] of |y| for y != 0, |kInt64Min| is saturated
+    int_interval a  = Abs(y);
+    int64_t      m1 = std::max<int64_t>(a.lo(), 1);
+    int64_t      m2 = a.hi();
+
+    // the result has the sign of x and |x % y| <= |x|
+    int_interval r = int_interval::empty();
+    if (x.hi() >= 0) r = reunion(r, positiveMod(std::max<int64_t>(x.lo(), 0), x.hi(), m1, m2));
+    if (x.lo() < 0) {
+        int_interval n = Neg({x.lo(), std::min<int64_t>(x.hi(), -1)});
+        int_interval p = positiveMod(n.lo(), n.hi(), m1, m2);
+        r              = reunion(r, Neg(p));
+    }
+    return overflow(x, y) ? int_interval(r.lo(), r.hi(), true) : r;
+}
+
+//------------------------------------------------------------------------------------------
+// bitwise operations, exact on 32 bits values
+
+int_interval int_interval_algebra::And(const int_interval& x, const int_interval& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return int_interval::empty();
+    if (isInt32(x) && isInt32(y)) {
+        SInterval z = bitwiseSignedAnd({int(x.lo()), int(x.hi())}, {int(y.lo()), int(y.hi())});
+        return {z.lo, z.hi, overflow(x, y)};
+    }
+    // x&y <= x and x&y <= y for non negative values
+    if ((x.lo() >= 0) && (y.lo() >= 0)) return {0, std::min(x.hi(), y.hi()), overflow(x, y)};
+    if (x.lo() >= 0) return {0, x.hi(), overflow(x, y)};
+    if (y.lo() >= 0) return {0, y.hi(), overflow(x, y)};
+    return {kInt64Min, kInt64Max, overflow(x, y)};
+}
+
+int_interval int_interval_algebra::Or(const int_interval& x, const int_interval& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return int_interval::empty();
+    if (isInt32(x) && isInt32(y)) {
+        SInterval z = bitwiseSignedOr({int(x.lo()), int(x.hi())}, {int(y.lo()), int(y.hi())});
+        return {z.lo, z.hi, overflow(x, y)};
+    }
+    // x|y >= max(x,y) and doesn't set bits above the msb for non negative values
+    if ((x.lo() >= 0) && (y.lo() >= 0)) {
+        return {std::max(x.lo(), y.lo()), bitmask(std::max(x.hi(), y.hi())), overflow(x, y)};
+    }
+    return {kInt64Min, kInt64Max, overflow(x, y)};
+}
+
+int_interval int_interval_algebra::Xor(const int_interval& x, const int_interval& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return int_interval::empty();
+    if (isInt32(x) && isInt32(y)) {
+        SInterval z = bitwiseSignedXOr({int(x.lo()), int(x.hi())}, {int(y.lo()), int(y.hi())});
+        return {z.lo, z.hi, overflow(x, y)};
+    }
+    if ((x.lo() >= 0) && (y.lo() >= 0)) return {0, bitmask(std::max(x.hi(), y.hi())), overflow(x, y)};
+    return {kInt64Min, kInt64Max, overflow(x, y)};
+}
+
+int_interval int_interval_algebra::Not(const int_interval& x) const
+{
+    if (x.isEmpty()) return x;
+    return {~x.hi(), ~x.lo(), x.overflow()};
+}
+
+// x << s for 0 <= s <= 63, as a checked multiplication
+static bound shiftLeft(int64_t x, int64_t s)
+{
+    if (x == 0) return {0, false};
+    if (s >= 63) return {(x < 0) ? kInt64Min : kInt64Max, true};
+    return bmul(x, int64_t(1) << s);
+}
+
+int_interval int_interval_algebra::Lsh(const int_interval& x, const int_interval& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return int_interval::empty();
+    int64_t s0 = std::clamp<int64_t>(y.lo(), 0, 63);
+    int64_t s1 = std::clamp<int64_t>(y.hi(), 0, 63);
+    bound   b[4]{shiftLeft(x.lo(), s0), shiftLeft(x.lo(), s1), shiftLeft(x.hi(), s0), shiftLeft(x.hi(), s1)};
+    return hull(b, 4, overflow(x, y));
+}
+
+int_interval int_interval_algebra::Rsh(const int_interval& x, const int_interval& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return int_interval::empty();
+    int64_t s0 = std::clamp<int64_t>(y.lo(), 0, 63);
+    int64_t s1 = std::clamp<int64_t>(y.hi(), 0, 63);
+    bound   b[4]{{x.lo() >> s0}, {x.lo() >> s1}, {x.hi() >> s0}, {x.hi() >> s1}};
+    return hull(b, 4, overflow(x, y));
+}
+
+//------------------------------------------------------------------------------------------
+// comparisons
+
+int_interval int_interval_algebra::Gt(const int_interval& x, const int_interval& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return int_interval::empty();
+    if (x.lo() > y.hi()) return int_interval(1);
+    if (x.hi() <= y.lo()) return int_interval(0);
+    return {0, 1};
+}
+
+int_interval int_interval_algebra::Lt(const int_interval& x, const int_interval& y) const
+{
+    return Gt(y, x);
+}
+
+int_interval int_interval_algebra::Ge(const int_interval& x, const int_interval& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return int_interval::empty();
+    if (x.lo() >= y.hi()) return int_interval(1);
+    if (x.hi() < y.lo()) return int_interval(0);
+    return {0, 1};
+}
+
+int_interval int_interval_algebra::Le(const int_interval& x, const int_interval& y) const
+{
+    return Ge(y, x);
+}
+
+int_interval int_interval_algebra::Eq(const int_interval& x, const int_interval& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return int_interval::empty();
+    if (x.isconst() && y.isconst() && (x.lo() == y.lo())) return int_interval(1);
+    if ((x.hi() < y.lo()) || (x.lo() > y.hi())) return int_interval(0);
+    return {0, 1};
+}
+
+int_interval int_interval_algebra::Ne(const int_interval& x, const int_interval& y) const
+{
+    int_interval e = Eq(x, y);
+    if (e.isEmpty()) return e;
+    return {1 - e.hi(), 1 - e.lo()};
+}
+
+//------------------------------------------------------------------------------------------
+// min, max and delays
+
+int_interval int_interval_algebra::Min(const int_interval& x, const int_interval& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return int_interval::empty();
+    return {std::min(x.lo(), y.lo()), std::min(x.hi(), y.hi()), overflow(x, y)};
+}
+
+int_interval int_interval_algebra::Max(const int_interval& x, const int_interval& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return int_interval::empty();
+    return {std::max(x.lo(), y.lo()), std::max(x.hi(), y.hi()), overflow(x, y)};
+}
+
+int_interval int_interval_algebra::Mem(const int_interval& x) const
+{
+    if (x.isEmpty()) return x;
+    return reunion(x, int_interval(0));
+}
+
+int_interval int_interval_algebra::Delay(const int_interval& x, const int_interval& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return int_interval::empty();
+    if ((y.lo() == 0) && (y.hi() == 0)) return x;
+    return reunion(x, int_interval(0));
+}
+
+// the hull of the branches reachable with the selector, see interval_algebra::selectBranches
+int_interval int_interval_algebra::Select2(const int_interval& s, const int_interval& x, const int_interval& y) const
+{
+    unsigned     b = interval_algebra().selectBranches(FloatCast(s), 2);
+    int_interval r = int_interval::empty();
+    if ((b & 1U) != 0) r = reunion(r, x);
+    if ((b & 2U) != 0) r = reunion(r, y);
+    return r;
+}
+
+int_interval int_interval_algebra::Select3(const int_interval& s, const int_interval& x, const int_interval& y,
+                                           const int_interval& z) const
+{
+    unsigned     b = interval_algebra().selectBranches(FloatCast(s), 3);
+    int_interval r = int_interval::empty();
+    if ((b & 1U) != 0) r = reunion(r, x);
+    if ((b & 2U) != 0) r = reunion(r, y);
+    if ((b & 4U) != 0) r = reunion(r, z);
+    return r;
+}
+
+// a table is summarized by the interval of its values, see interval_algebra::RdTbl
+int_interval int_interval_algebra::RdTbl(const int_interval& tbl, const int_interval& index) const
+{
+    if (index.isEmpty()) return int_interval::empty();
+    return tbl;
+}
+
+int_interval int_interval_algebra::WrTbl(const int_interval& n, const int_interval& init,
+                                         const int_interval& index, const int_interval& value) const
+{
+    if (n.isEmpty()) return int_interval::empty();
+    if (index.isEmpty() || value.isEmpty()) return init;  // read only table
+    return reunion(init, value);
+}
+
+//------------------------------------------------------------------------------------------
+// tests
+
+static void check(const std::string& testname, const int_interval& exp, const int_interval& res)
+{
+    std::ostringstream e, r;
+    e << exp;
+    r << res;
+    ::check(testname + " " + e.str() + " == " + r.str(), exp == res, true);
+}
+
+void testIntInterval()
+{
+    int_interval_algebra A;
+
+    check("test int Add", A.Add({0, 100}, {10, 500}), {10, 600});
+    check("test int Add exact", A.Add(int_interval(kInt64Max - 1), int_interval(1)), int_interval(kInt64Max));
+    check("test int Add overflow", A.Add({0, kInt64Max}, {0, 1}), {0, kInt64Max, true});
+    check("test int Sub overflow", A.Sub(int_interval(kInt64Min), {0, 1}), {kInt64Min, kInt64Min, true});
+    check("test int Mul", A.Mul({-2, 3}, {-50, 10}), {-150, 100});
+    check("test int Mul overflow", A.Mul({1, int64_t(1) << 40}, {-(int64_t(1) << 40), 2}),
+          {kInt64Min, int64_t(1) << 41, true});
+    check("test int overflow propagates", A.Add(A.Mul({2, 2}, int_interval(kInt64Max)), {0, 0}),
+          {kInt64Max, kInt64Max, true});
+    check("test int Neg overflow", A.Neg({kInt64Min, 0}), {0, kInt64Max, true});
+    check("test int Div", A.Div({-7, 7}, {2, 3}), {-3, 3});
+    check("test int Div zero", A.Div({10, 20}, {-1, 1}), {-20, 20});
+    check("test int Div overflow", A.Div(int_interval(kInt64Min), int_interval(-1)), {kInt64Max, kInt64Max, true});
+    check("test int Mod", A.Mod({0, 100}, {10, 10}), {0, 9});
+    check("test int Mod no effect", A.Mod({3, 5}, {8, 10}), {3, 5});
+    check("test int Mod negative", A.Mod({-7, 7}, {8, 10}), {-7, 7});
+    check("test int Mod sign", A.Mod({-100, -1}, {-10, -10}), {-9, 0});
+    check("test int And", A.And({0, 1000}, {63, 63}), {0, 63});
+    check("test int And 64 bits", A.And({0, int64_t(1) << 40}, {0, 255}), {0, 255});
+    check("test int Not", A.Not({-3, 4}), {-5, 2});
+    check("test int Lsh", A.Lsh({-3, 5}, {1, 4}), {-48, 80});
+    check("test int Lsh overflow", A.Lsh({1, 1}, {0, 63}), {1, kInt64Max, true});
+    check("test int Rsh", A.Rsh({-16, 16}, {1, 2}), {-8, 8});
+    check("test int Lt", A.Lt(int_interval(5), {6, 10}), int_interval(1));
+    check("test int Ne", A.Ne(int_interval(1), int_interval(1)), int_interval(0));
+    check("test int Mem", A.Mem({5, 7}), {0, 7});
+
+    // conversions
+    check("test int IntCast", A.IntCast(interval(-3.8, 4.9)), {-3, 4});
+    check("test int IntCast saturation", A.IntCast(interval(0, HUGE_VAL)), {0, kInt64Max, true});
+    ::check("test int IntCast empty", A.IntCast(interval(NAN, NAN)).isEmpty(), true);
+    ::check("test int FloatCast", A.FloatCast({-3, 4}), interval(-3, 4, 0));
+    interval big = A.FloatCast({(int64_t(1) << 53) + 1, (int64_t(1) << 53) + 1});
+    ::check("test int FloatCast outward", (big.lo() <= 0x1p53 + 1) && (big.hi() >= 0x1p53 + 1), true);
+
+    check("test int Select2", A.Select2({1, 5}, {0, 1}, {10, 20}), {10, 20});
+    check("test int Select3", A.Select3({0, 1}, {0, 1}, {10, 20}, {100, 200}), {0, 20});
+
+    check("test int WrTbl", A.RdTbl(A.WrTbl(int_interval(8), {0, 0}, {0, 7}, {-5, 5}), {0, 7}), {-5, 5});
+    check("test int RdTbl", A.RdTbl({0, 9}, int_interval::empty()), int_interval::empty());
+}
+
+}  // namespace itv
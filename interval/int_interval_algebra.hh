@@ -0,0 +1,75 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "faust_algebra.hh"
+#include "int_interval.hh"
+#include "interval_def.hh"
+
+namespace itv {
+
+// The faust algebra restricted to integer signals, computed exactly with int64
+// arithmetic. The real valued primitives (Sin, Exp, ...) are not part of it:
+// they are computed by interval_algebra after a FloatCast, and IntCast brings
+// their results back to the integer domain.
+class int_interval_algebra : public faust_algebra<int_interval> {
+   public:
+    // Injections of external values
+    int_interval IntNum(int x) const;
+
+    // User interface elements
+    int_interval Button(const int_interval& name) const;
+    int_interval Checkbox(const int_interval& name) const;
+
+    // Conversions with the interval domain
+    int_interval IntCast(const interval& x) const;      // truncation toward zero
+    int_interval IntCast(const int_interval& x) const;  // identity
+    interval     FloatCast(const int_interval& x) const;
+
+    // Operations
+    int_interval Abs(const int_interval& x) const;
+    int_interval Add(const int_interval& x, const int_interval& y) const;
+    int_interval Sub(const int_interval& x, const int_interval& y) const;
+    int_interval Mul(const int_interval& x, const int_interval& y) const;
+    int_interval Div(const int_interval& x, const int_interval& y) const;  // truncated integer division
+    int_interval Neg(const int_interval& x) const;
+    int_interval Mod(const int_interval& x, const int_interval& y) const;  // C remainder, of the sign of x
+    int_interval And(const int_interval& x, const int_interval& y) const;
+    int_interval Or(const int_interval& x, const int_interval& y) const;
+    int_interval Xor(const int_interval& x, const int_interval& y) const;
+    int_interval Not(const int_interval& x) const;
+    int_interval Lsh(const int_interval& x, const int_interval& y) const;  // shifts restricted to [0,63]
+    int_interval Rsh(const int_interval& x, const int_interval& y) const;  // arithmetic shift
+    int_interval Eq(const int_interval& x, const int_interval& y) const;
+    int_interval Ne(const int_interval& x, const int_interval& y) const;
+    int_interval Lt(const int_interval& x, const int_interval& y) const;
+    int_interval Le(const int_interval& x, const int_interval& y) const;
+    int_interval Gt(const int_interval& x, const int_interval& y) const;
+    int_interval Ge(const int_interval& x, const int_interval& y) const;
+    int_interval Min(const int_interval& x, const int_interval& y) const;
+    int_interval Max(const int_interval& x, const int_interval& y) const;
+    int_interval Mem(const int_interval& x) const;
+    int_interval Delay(const int_interval& x, const int_interval& y) const;
+    int_interval Select2(const int_interval& s, const int_interval& x, const int_interval& y) const;
+    int_interval Select3(const int_interval& s, const int_interval& x, const int_interval& y,
+                         const int_interval& z) const;
+    int_interval RdTbl(const int_interval& tbl, const int_interval& index) const;
+    int_interval WrTbl(const int_interval& n, const int_interval& init,
+                       const int_interval& index, const int_interval& value) const;
+};
+
+void testIntInterval();
+
+}  // namespace itv
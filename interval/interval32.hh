@@ -0,0 +1,103 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cfloat>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+#include "interval_def.hh"
+
+// ***************************************************************************
+//
+//     An interval32 is an interval with float boundaries, half the size of an
+//     interval (12 bytes instead of 24). Conversions from intervals round the
+//     boundaries outward, so that an interval32 always contains the interval
+//     it comes from.
+//
+//****************************************************************************
+namespace itv {
+
+class interval32 {
+   private:
+    float fLo{std::numeric_limits<float>::lowest()};  ///< minimal value
+    float fHi{std::numeric_limits<float>::max()};     ///< maximal value
+    int   fLSB{-24};                                  ///< lsb in bits
+
+    // the largest float <= d
+    static float floatBelow(double d)
+    {
+        if (d > FLT_MAX) return FLT_MAX;
+        if (d < -FLT_MAX) return -HUGE_VALF;
+        auto f = float(d);
+        return (double(f) > d) ? std::nextafter(f, -HUGE_VALF) : f;
+    }
+
+    // the smallest float >= d
+    static float floatAbove(double d)
+    {
+        if (d > FLT_MAX) return HUGE_VALF;
+        if (d < -FLT_MAX) return -FLT_MAX;
+        auto f = float(d);
+        return (double(f) < d) ? std::nextafter(f, HUGE_VALF) : f;
+    }
+
+   public:
+    interval32() = default;
+
+    // outward rounded conversion of an interval
+    explicit interval32(const interval& i) noexcept : fLSB(i.lsb())
+    {
+        if (i.isEmpty()) {
+            fLo = NAN;
+            fHi = NAN;
+        } else {
+            fLo = floatBelow(i.lo());
+            fHi = floatAbove(i.hi());
+        }
+    }
+
+    interval32(double n, double m, int lsb = -24) noexcept : interval32(interval(n, m, lsb)) {}
+
+    // conversion to an interval
+    interval widen() const { return isEmpty() ? interval(NAN, NAN, fLSB) : interval(fLo, fHi, fLSB); }
+
+    bool  isEmpty() const { return std::isnan(fLo) || std::isnan(fHi); }
+    bool  has(double x) const { return (fLo <= x) && (fHi >= x); }
+    float lo() const { return fLo; }
+    float hi() const { return fHi; }
+    int   lsb() const { return fLSB; }
+};
+
+static_assert(sizeof(interval32) == 12, "an interval32 is half the size of an interval");
+
+inline std::ostream& operator<<(std::ostream& dst, const interval32& i)
+{
+    if (i.isEmpty()) return dst << "interval32()";
+    return dst << "interval32(" << i.lo() << ',' << i.hi() << ',' << i.lsb() << ")";
+}
+
+inline bool operator==(const interval32& i, const interval32& j)
+{
+    return (i.isEmpty() && j.isEmpty()) || ((i.lo() == j.lo()) && (i.hi() == j.hi()));
+}
+
+inline bool operator!=(const interval32& i, const interval32& j)
+{
+    return !(i == j);
+}
+
+}  // namespace itv
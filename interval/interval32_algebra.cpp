@@ -0,0 +1,360 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string>
+
+#include "check.hh"
+#include "interval32.hh"
+#include "interval32_algebra.hh"
+
+namespace itv {
+
+interval32 interval32_algebra::Label(const std::string& x) const
+{
+    return interval32(fAlgebra.Label(x));
+}
+
+interval32 interval32_algebra::IntNum(int x) const
+{
+    return interval32(fAlgebra.IntNum(x));
+}
+
+interval32 interval32_algebra::FloatNum(double x) const
+{
+    return interval32(fAlgebra.FloatNum(x));
+}
+
+interval32 interval32_algebra::Button(const interval32& name) const
+{
+    return interval32(fAlgebra.Button(name.widen()));
+}
+
+interval32 interval32_algebra::Checkbox(const interval32& name) const
+{
+    return interval32(fAlgebra.Checkbox(name.widen()));
+}
+
+interval32 interval32_algebra::VSlider(const interval32& name, const interval32& init,
+                                       const interval32& lo, const interval32& hi, const interval32& step) const
+{
+    return interval32(fAlgebra.VSlider(name.widen(), init.widen(), lo.widen(), hi.widen(), step.widen()));
+}
+
+interval32 interval32_algebra::HSlider(const interval32& name, const interval32& init,
+                                       const interval32& lo, const interval32& hi, const interval32& step) const
+{
+    return interval32(fAlgebra.HSlider(name.widen(), init.widen(), lo.widen(), hi.widen(), step.widen()));
+}
+
+interval32 interval32_algebra::NumEntry(const interval32& name, const interval32& init,
+                                        const interval32& lo, const interval32& hi, const interval32& step) const
+{
+    return interval32(fAlgebra.NumEntry(name.widen(), init.widen(), lo.widen(), hi.widen(), step.widen()));
+}
+
+interval32 interval32_algebra::Abs(const interval32& x) const
+{
+    return interval32(fAlgebra.Abs(x.widen()));
+}
+
+interval32 interval32_algebra::Add(const interval32& x, const interval32& y) const
+{
+    return interval32(fAlgebra.Add(x.widen(), y.widen()));
+}
+
+interval32 interval32_algebra::Sub(const interval32& x, const interval32& y) const
+{
+    return interval32(fAlgebra.Sub(x.widen(), y.widen()));
+}
+
+interval32 interval32_algebra::Mul(const interval32& x, const interval32& y) const
+{
+    return interval32(fAlgebra.Mul(x.widen(), y.widen()));
+}
+
+interval32 interval32_algebra::Div(const interval32& x, const interval32& y) const
+{
+    return interval32(fAlgebra.Div(x.widen(), y.widen()));
+}
+
+interval32 interval32_algebra::Inv(const interval32& x) const
+{
+    return interval32(fAlgebra.Inv(x.widen()));
+}
+
+interval32 interval32_algebra::Neg(const interval32& x) const
+{
+    return interval32(fAlgebra.Neg(x.widen()));
+}
+
+interval32 interval32_algebra::Mod(const interval32& x, const interval32& y) const
+{
+    return interval32(fAlgebra.Mod(x.widen(), y.widen()));
+}
+
+interval32 interval32_algebra::Acos(const interval32& x) const
+{
+    return interval32(fAlgebra.Acos(x.widen()));
+}
+
+interval32 interval32_algebra::Acosh(const interval32& x) const
+{
+    return interval32(fAlgebra.Acosh(x.widen()));
+}
+
+interval32 interval32_algebra::And(const interval32& x, const interval32& y) const
+{
+    return interval32(fAlgebra.And(x.widen(), y.widen()));
+}
+
+interval32 interval32_algebra::Asin(const interval32& x) const
+{
+    return interval32(fAlgebra.Asin(x.widen()));
+}
+
+interval32 interval32_algebra::Asinh(const interval32& x) const
+{
+    return interval32(fAlgebra.Asinh(x.widen()));
+}
+
+interval32 interval32_algebra::Atan(const interval32& x) const
+{
+    return interval32(fAlgebra.Atan(x.widen()));
+}
+
+interval32 interval32_algebra::Atan2(const interval32& x, const interval32& y) const
+{
+    return interval32(fAlgebra.Atan2(x.widen(), y.widen()));
+}
+
+interval32 interval32_algebra::Atanh(const interval32& x) const
+{
+    return interval32(fAlgebra.Atanh(x.widen()));
+}
+
+interval32 interval32_algebra::Ceil(const interval32& x) const
+{
+    return interval32(fAlgebra.Ceil(x.widen()));
+}
+
+interval32 interval32_algebra::Cos(const interval32& x) const
+{
+    return interval32(fAlgebra.Cos(x.widen()));
+}
+
+interval32 interval32_algebra::Cosh(const interval32& x) const
+{
+    return interval32(fAlgebra.Cosh(x.widen()));
+}
+
+interval32 interval32_algebra::Delay(const interval32& x, const interval32& y) const
+{
+    return interval32(fAlgebra.Delay(x.widen(), y.widen()));
+}
+
+interval32 interval32_algebra::Eq(const interval32& x, const interval32& y) const
+{
+    return interval32(fAlgebra.Eq(x.widen(), y.widen()));
+}
+
+interval32 interval32_algebra::Exp(const interval32& x) const
+{
+    return interval32(fAlgebra.Exp(x.widen()));
+}
+
+interval32 interval32_algebra::FloatCast(const interval32& x) const
+{
+    return interval32(fAlgebra.FloatCast(x.widen()));
+}
+
+interval32 interval32_algebra::Floor(const interval32& x) const
+{
+    return interval32(fAlgebra.Floor(x.widen()));
+}
+
+interval32 interval32_algebra::Ge(const interval32& x, const interval32& y) const
+{
+    return interval32(fAlgebra.Ge(x.widen(), y.widen()));
+}
+
+interval32 interval32_algebra::Gt(const interval32& x, const interval32& y) const
+{
+    return interval32(fAlgebra.Gt(x.widen(), y.widen()));
+}
+
+interval32 interval32_algebra::IntCast(const interval32& x) const
+{
+    return interval32(fAlgebra.IntCast(x.widen()));
+}
+
+interval32 interval32_algebra::Le(const interval32& x, const interval32& y) const
+{
+    return interval32(fAlgebra.Le(x.widen(), y.widen()));
+}
+
+interval32 interval32_algebra::Log(const interval32& x) const
+{
+    return interval32(fAlgebra.Log(x.widen()));
+}
+
+interval32 interval32_algebra::Log10(const interval32& x) const
+{
+    return interval32(fAlgebra.Log10(x.widen()));
+}
+
+interval32 interval32_algebra::Lsh(const interval32& x, const interval32& y) const
+{
+    return interval32(fAlgebra.Lsh(x.widen(), y.widen()));
+}
+
+interval32 interval32_algebra::Lt(const interval32& x, const interval32& y) const
+{
+    return interval32(fAlgebra.Lt(x.widen(), y.widen()));
+}
+
+interval32 interval32_algebra::Max(const interval32& x, const interval32& y) const
+{
+    return interval32(fAlgebra.Max(x.widen(), y.widen()));
+}
+
+interval32 interval32_algebra::Mem(const interval32& x) const
+{
+    return interval32(fAlgebra.Mem(x.widen()));
+}
+
+interval32 interval32_algebra::Min(const interval32& x, const interval32& y) const
+{
+    return interval32(fAlgebra.Min(x.widen(), y.widen()));
+}
+
+interval32 interval32_algebra::Ne(const interval32& x, const interval32& y) const
+{
+    return interval32(fAlgebra.Ne(x.widen(), y.widen()));
+}
+
+interval32 interval32_algebra::Not(const interval32& x) const
+{
+    return interval32(fAlgebra.Not(x.widen()));
+}
+
+interval32 interval32_algebra::Or(const interval32& x, const interval32& y) const
+{
+    return interval32(fAlgebra.Or(x.widen(), y.widen()));
+}
+
+interval32 interval32_algebra::Pow(const interval32& x, const interval32& y) const
+{
+    return interval32(fAlgebra.Pow(x.widen(), y.widen()));
+}
+
+interval32 interval32_algebra::RdTbl(const interval32& tbl, const interval32& index) const
+{
+    return interval32(fAlgebra.RdTbl(tbl.widen(), index.widen()));
+}
+
+interval32 interval32_algebra::Remainder(const interval32& x) const
+{
+    return interval32(fAlgebra.Remainder(x.widen()));
+}
+
+interval32 interval32_algebra::Rint(const interval32& x) const
+{
+    return interval32(fAlgebra.Rint(x.widen()));
+}
+
+interval32 interval32_algebra::Rsh(const interval32& x, const interval32& y) const
+{
+    return interval32(fAlgebra.Rsh(x.widen(), y.widen()));
+}
+
+interval32 interval32_algebra::Select2(const interval32& s, const interval32& x, const interval32& y) const
+{
+    return interval32(fAlgebra.Select2(s.widen(), x.widen(), y.widen()));
+}
+
+interval32 interval32_algebra::Select3(const interval32& s, const interval32& x, const interval32& y,
+                                       const interval32& z) const
+{
+    return interval32(fAlgebra.Select3(s.widen(), x.widen(), y.widen(), z.widen()));
+}
+
+interval32 interval32_algebra::Sin(const interval32& x) const
+{
+    return interval32(fAlgebra.Sin(x.widen()));
+}
+
+interval32 interval32_algebra::Sinh(const interval32& x) const
+{
+    return interval32(fAlgebra.Sinh(x.widen()));
+}
+
+interval32 interval32_algebra::Sqrt(const interval32& x) const
+{
+    return interval32(fAlgebra.Sqrt(x.widen()));
+}
+
+interval32 interval32_algebra::Tan(const interval32& x) const
+{
+    return interval32(fAlgebra.Tan(x.widen()));
+}
+
+interval32 interval32_algebra::Tanh(const interval32& x) const
+{
+    return interval32(fAlgebra.Tanh(x.widen()));
+}
+
+interval32 interval32_algebra::WrTbl(const interval32& n, const interval32& init,
+                                     const interval32& index, const interval32& value) const
+{
+    return interval32(fAlgebra.WrTbl(n.widen(), init.widen(), index.widen(), value.widen()));
+}
+
+interval32 interval32_algebra::Xor(const interval32& x, const interval32& y) const
+{
+    return interval32(fAlgebra.Xor(x.widen(), y.widen()));
+}
+
+//------------------------------------------------------------------------------------------
+// tests
+
+void testInterval32()
+{
+    interval32_algebra A;
+
+    // conversions round outward
+    interval32 t(interval(0.1, 0.3, -60));
+    check("test interval32 outward lo", double(t.lo()) <= 0.1, true);
+    check("test interval32 outward hi", double(t.hi()) >= 0.3, true);
+    check("test interval32 tight", std::nextafter(t.hi(), 0.0F) < 0.3, true);
+    check("test interval32 overflow", interval32(interval(-1e300, 1e300)).hi() == HUGE_VALF, true);
+    check("test interval32 saturation", interval32(interval(1e300, 1e301)).lo() == FLT_MAX, true);
+    check("test interval32 empty", interval32(interval(NAN, NAN)).isEmpty(), true);
+    check("test interval32 widen", interval32(interval(-3, 5)).widen(), interval(-3, 5));
+
+    // operations
+    check("test interval32 Add", A.Add(interval32(0, 100), interval32(10, 500)) == interval32(10, 600), true);
+    check("test interval32 Mul", A.Mul(interval32(-2, 3), interval32(-50, 10)) == interval32(-150, 100), true);
+    interval32 e = A.Exp(interval32(0, 1));
+    check("test interval32 Exp", (e.lo() <= 1) && (double(e.hi()) >= std::exp(1.0)), true);
+    check("test interval32 Button", A.Button(interval32()) == interval32(0, 1), true);
+
+    interval32 sel = A.Select2(interval32(interval(0)), interval32(interval(0, 1)), interval32(interval(5, 6)));
+    check("test interval32 Select2", (double(sel.lo()) <= 0) && (double(sel.hi()) >= 1) && (sel.hi() < 5), true);
+
+    interval32 tbl = A.WrTbl(interval32(interval(8)), interval32(interval(0)), interval32(interval(0, 7, 0)),
+                             interval32(interval(2, 3)));
+    check("test interval32 WrTbl", (double(tbl.lo()) <= 0) && (double(tbl.hi()) >= 3), true);
+    check("test interval32 RdTbl", A.RdTbl(tbl, interval32(interval(NAN, NAN))).isEmpty(), true);
+}
+}  // namespace itv
@@ -0,0 +1,100 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <string>
+
+#include "faust_algebra.hh"
+#include "interval32.hh"
+#include "interval_algebra.hh"
+
+namespace itv {
+
+// The faust algebra on interval32. Each operation is computed by interval_algebra
+// on the widened arguments and its result is rounded outward to float boundaries.
+class interval32_algebra : public faust_algebra<interval32> {
+   private:
+    interval_algebra fAlgebra;
+
+   public:
+    interval32 Label(const std::string& x) const;
+    interval32 IntNum(int x) const;
+    interval32 FloatNum(double x) const;
+    interval32 Button(const interval32& name) const;
+    interval32 Checkbox(const interval32& name) const;
+    interval32 VSlider(const interval32& name, const interval32& init,
+                       const interval32& lo, const interval32& hi, const interval32& step) const;
+    interval32 HSlider(const interval32& name, const interval32& init,
+                       const interval32& lo, const interval32& hi, const interval32& step) const;
+    interval32 NumEntry(const interval32& name, const interval32& init,
+                        const interval32& lo, const interval32& hi, const interval32& step) const;
+    interval32 Abs(const interval32& x) const;
+    interval32 Add(const interval32& x, const interval32& y) const;
+    interval32 Sub(const interval32& x, const interval32& y) const;
+    interval32 Mul(const interval32& x, const interval32& y) const;
+    interval32 Div(const interval32& x, const interval32& y) const;
+    interval32 Inv(const interval32& x) const;
+    interval32 Neg(const interval32& x) const;
+    interval32 Mod(const interval32& x, const interval32& y) const;
+    interval32 Acos(const interval32& x) const;
+    interval32 Acosh(const interval32& x) const;
+    interval32 And(const interval32& x, const interval32& y) const;
+    interval32 Asin(const interval32& x) const;
+    interval32 Asinh(const interval32& x) const;
+    interval32 Atan(const interval32& x) const;
+    interval32 Atan2(const interval32& x, const interval32& y) const;
+    interval32 Atanh(const interval32& x) const;
+    interval32 Ceil(const interval32& x) const;
+    interval32 Cos(const interval32& x) const;
+    interval32 Cosh(const interval32& x) const;
+    interval32 Delay(const interval32& x, const interval32& y) const;
+    interval32 Eq(const interval32& x, const interval32& y) const;
+    interval32 Exp(const interval32& x) const;
+    interval32 FloatCast(const interval32& x) const;
+    interval32 Floor(const interval32& x) const;
+    interval32 Ge(const interval32& x, const interval32& y) const;
+    interval32 Gt(const interval32& x, const interval32& y) const;
+    interval32 IntCast(const interval32& x) const;
+    interval32 Le(const interval32& x, const interval32& y) const;
+    interval32 Log(const interval32& x) const;
+    interval32 Log10(const interval32& x) const;
+    interval32 Lsh(const interval32& x, const interval32& y) const;
+    interval32 Lt(const interval32& x, const interval32& y) const;
+    interval32 Max(const interval32& x, const interval32& y) const;
+    interval32 Mem(const interval32& x) const;
+    interval32 Min(const interval32& x, const interval32& y) const;
+    interval32 Ne(const interval32& x, const interval32& y) const;
+    interval32 Not(const interval32& x) const;
+    interval32 Or(const interval32& x, const interval32& y) const;
+    interval32 Pow(const interval32& x, const interval32& y) const;
+    interval32 RdTbl(const interval32& tbl, const interval32& index) const;
+    interval32 Remainder(const interval32& x) const;
+    interval32 Rint(const interval32& x) const;
+    interval32 Rsh(const interval32& x, const interval32& y) const;
+    interval32 Select2(const interval32& s, const interval32& x, const interval32& y) const;
+    interval32 Select3(const interval32& s, const interval32& x, const interval32& y, const interval32& z) const;
+    interval32 Sin(const interval32& x) const;
+    interval32 Sinh(const interval32& x) const;
+    interval32 Sqrt(const interval32& x) const;
+    interval32 Tan(const interval32& x) const;
+    interval32 Tanh(const interval32& x) const;
+    interval32 WrTbl(const interval32& n, const interval32& init,
+                     const interval32& index, const interval32& value) const;
+    interval32 Xor(const interval32& x, const interval32& y) const;
+};
+
+void testInterval32();
+
+}  // namespace itv
@@ -32,7 +32,7 @@ interval interval_algebra::Acos(const interval& x) const
 {
     interval i = intersection(AcosDomain, x);
     if (i.isEmpty()) return i;
-    return {acos(i.hi()), acos(i.lo())};
+    return {acos(i.hi()), acos(i.lo()), fPrecision};
 }
 
 void interval_algebra::testAcos() const
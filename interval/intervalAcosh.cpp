@@ -32,7 +32,7 @@ interval interval_algebra::Acosh(const interval& x) const
 {
     interval i = intersection(domain, x);
     if (i.isEmpty()) return i;
-    return {acosh(i.lo()), acosh(i.hi())};
+    return {acosh(i.lo()), acosh(i.hi()), fPrecision};
 }
 
 void interval_algebra::testAcosh() const
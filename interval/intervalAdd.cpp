@@ -29,11 +29,15 @@ interval interval_algebra::Add(const interval& x, const interval& y) const
 {
     if (x.isEmpty() || y.isEmpty()) return {};
 
-    return {x.lo() + y.lo(), x.hi() + y.hi()};
+    // inf-inf bounds are undefined, the other combinations of the arguments still reach the infinities
+    double lo = x.lo() + y.lo();
+    double hi = x.hi() + y.hi();
+    return {std::isnan(lo) ? -HUGE_VAL : lo, std::isnan(hi) ? HUGE_VAL : hi, std::min(x.lsb(), y.lsb())};
 }
 
 void interval_algebra::testAdd() const
 {
     check("test algebra Add", Add(interval(0, 100), interval(10, 500)), interval(10, 600));
+    check("test algebra Add lsb", Add(interval(0, 100, 0), interval(0, 1, -3)).lsb() == -3, true);
 }
 }  // namespace itv
@@ -130,7 +130,7 @@ interval interval_algebra::And(const interval& x, const interval& y) const
     int y1 = saturatedIntCast(y.hi());
 
     SInterval z = bitwiseSignedAnd({x0, x1}, {y0, y1});
-    return {double(z.lo), double(z.hi)};
+    return {double(z.lo), double(z.hi), 0};
 }
 
 void interval_algebra::testAnd() const
@@ -35,7 +35,7 @@ interval interval_algebra::Asin(const interval& x) const
 {
     interval i = intersection(domain, x);
     if (i.isEmpty()) return i;
-    return {asin(i.lo()), asin(i.hi())};
+    return {asin(i.lo()), asin(i.hi()), fPrecision};
 }
 
 void interval_algebra::testAsin() const
@@ -29,7 +29,7 @@ static const interval domain(-HUGE_VAL, HUGE_VAL);
 
 interval interval_algebra::Asinh(const interval& x) const
 {
-    return {asinh(x.lo()), asinh(x.hi())};
+    return {asinh(x.lo()), asinh(x.hi()), fPrecision};
 }
 
 void interval_algebra::testAsinh() const
@@ -32,7 +32,7 @@ namespace itv {
 interval interval_algebra::Atan(const interval& x) const
 {
     if (x.isEmpty()) return x;
-    return {atan(x.lo()), atan(x.hi())};
+    return {atan(x.lo()), atan(x.hi()), fPrecision};
 }
 
 void interval_algebra::testAtan() const
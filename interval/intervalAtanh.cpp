@@ -35,7 +35,7 @@ interval interval_algebra::Atanh(const interval& x) const
     if (i.isEmpty()) {
         return i;
     }
-    return {atanh(i.lo()), atanh(i.hi())};
+    return {atanh(i.lo()), atanh(i.hi()), fPrecision};
 }
 
 void interval_algebra::testAtanh() const
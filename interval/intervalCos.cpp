@@ -32,12 +32,12 @@ interval interval_algebra::Cos(const interval& x) const
     double TWOPI = 2 * M_PI;
 
     if (x.isEmpty()) return {};
-    if (x.size() >= TWOPI) return {-1, 1};
+    if (x.size() >= TWOPI) return {-1, 1, fPrecision};
 
     // normalize input interval between 0..4PI
     double l = fmod(x.lo(), TWOPI);
     if (l < 0) l += TWOPI;
-    interval i(l, l + x.size());
+    interval i(l, l + x.size(), kMinLSB);  // not truncated, a tiny argument must keep its variation
 
     // compute the default boundaries
     double a  = cos(i.lo());
@@ -49,7 +49,7 @@ interval interval_algebra::Cos(const interval& x) const
     if (i.has(0) || i.has(2 * M_PI)) hi = 1;
     if (i.has(M_PI) || i.has(3 * M_PI)) lo = -1;
 
-    return {lo, hi};
+    return {lo, hi, fPrecision};
 }
 
 void interval_algebra::testCos() const
@@ -29,9 +29,9 @@ namespace itv {
 interval interval_algebra::Cosh(const interval& x) const
 {
     if (x.isEmpty()) return x;
-    if (x.hasZero()) return {1, std::max(cosh(x.lo()), cosh(x.hi()))};
+    if (x.hasZero()) return {1, std::max(cosh(x.lo()), cosh(x.hi())), fPrecision};
 
-    return {std::min(cosh(x.lo()), cosh(x.hi())), std::max(cosh(x.lo()), cosh(x.hi()))};
+    return {std::min(cosh(x.lo()), cosh(x.hi())), std::max(cosh(x.lo()), cosh(x.hi())), fPrecision};
 }
 
 void interval_algebra::testCosh() const
@@ -30,7 +30,7 @@ interval interval_algebra::Delay(const interval& x, const interval& y) const
 {
     if (x.isEmpty() || y.isEmpty()) return {};
     if (y.isZero()) return x;
-    return reunion(x, interval{0});
+    return reunion(x, interval{0, 0, x.lsb()});
 }
 
 void interval_algebra::testDelay() const
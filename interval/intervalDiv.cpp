@@ -26,7 +26,9 @@ namespace itv {
 
 interval interval_algebra::Div(const interval& x, const interval& y) const
 {
-    return Mul(x, Inv(y));
+    // the inverse isn't truncated before the product, 1/y can be much finer than the precision
+    interval z = Mul(x, interval_algebra(kMinLSB).Inv(y));
+    return {z.lo(), z.hi(), fPrecision};
 }
 
 double div(double x, double y)
@@ -36,6 +38,7 @@ double div(double x, double y)
 
 void interval_algebra::testDiv() const
 {
+    check("test algebra Div large", Div(interval(-4096), interval(-1e300, -1e299)).lo() <= 4096e-300, true);
     analyzeBinaryMethod(10, 2000, "Div", interval(-1000, 1000), interval(0.001, 1000), div, &interval_algebra::Div);
     analyzeBinaryMethod(10, 2000, "Div", interval(-1000, 1000), interval(-1000, -0.001), div, &interval_algebra::Div);
 
@@ -29,11 +29,12 @@ namespace itv {
 interval interval_algebra::Exp(const interval& x) const
 {
     if (x.isEmpty()) return x;
-    return {exp(x.lo()), exp(x.hi())};
+    return {exp(x.lo()), exp(x.hi()), fPrecision};
 }
 
 void interval_algebra::testExp() const
 {
     analyzeUnaryMethod(10, 1000, "exp", interval(-100, 10), exp, &interval_algebra::Exp);
+    check("test algebra Exp precision", interval_algebra(-12).Exp(interval(0, 1, 0)).lsb() == -12, true);
 }
 }  // namespace itv
@@ -13,6 +13,8 @@
  * limitations under the License.
  */
 #include <algorithm>
+#include <cfloat>
+#include <cmath>
 #include <functional>
 #include <random>
 
@@ -26,13 +28,25 @@ namespace itv {
 // interval FloatCast(const interval& x) const;
 // void testFloatCast() const;
 
+// In float32 mode the bounds are rounded to the nearest float32, as the values:
+// rounding is monotonic, so [float(lo), float(hi)] is exactly the image of x.
+// The values beyond FLT_MAX overflow to infinity and the lsb can't be finer
+// than the lsb of the float32 subnormal numbers.
 interval interval_algebra::FloatCast(const interval& x) const
 {
-    return x;
+    if (!fFloat32 || x.isEmpty()) return x;
+    return {float(x.lo()), float(x.hi()), std::max(x.lsb(), -149)};
 }
 
 void interval_algebra::testFloatCast() const
 {
-    std::cout << "OK: FloatCast no tests needed" << std::endl;
+    check("test algebra FloatCast", FloatCast(interval(0.1, 0.2)), interval(0.1, 0.2));
+
+    interval_algebra F(-24, true);
+    interval         z = F.FloatCast(interval(0.1, 0.2, -60));
+    check("test algebra FloatCast float32", (z.lo() == double(0.1F)) && (z.hi() == double(0.2F)), true);
+    check("test algebra FloatCast exact", F.FloatCast(interval(0.5, 0.75, -60)), interval(0.5, 0.75, -60));
+    check("test algebra FloatCast overflow", F.FloatCast(interval(0, 1e39)).hi() == HUGE_VAL, true);
+    check("test algebra FloatCast lsb", F.FloatCast(interval(0, 1, -200)).lsb() == -149, true);
 }
 }  // namespace itv
@@ -21,6 +21,8 @@ namespace itv {
 
 interval interval_algebra::FloatNum(double x) const
 {
-    return {x, x, -24};
+    // the lsb of the value, or the target precision when it needs more bits
+    int lsb = exactLSB(x);
+    return {x, x, (lsb == INT_MAX) ? 0 : std::max(lsb, fPrecision)};
 }
 }  // namespace itv
@@ -29,7 +29,7 @@ namespace itv {
 interval interval_algebra::Floor(const interval& x) const
 {
     if (x.isEmpty()) return {};
-    return {floor(x.lo()), floor(x.hi())};
+    return {floor(x.lo()), floor(x.hi()), std::max(x.lsb(), 0)};
 }
 
 void interval_algebra::testFloor() const
@@ -31,12 +31,17 @@ namespace itv {
 interval interval_algebra::IntCast(const interval& x) const
 {
     if (x.isEmpty()) return {};
-    return {double(saturatedIntCast(x.lo())), double(saturatedIntCast(x.hi())), 0};  // integer intervals have 0 bits of precision
+    // integer intervals have 0 bits of precision, or less for multiples of 2^lsb, that the saturation doesn't keep
+    bool saturated = (x.lo() < -2147483648.0) || (x.hi() > 2147483647.0);
+    return {double(saturatedIntCast(x.lo())), double(saturatedIntCast(x.hi())), saturated ? 0 : std::max(x.lsb(), 0)};
 }
 
 void interval_algebra::testIntCast() const
 {
     check("test algebra IntCast", IntCast(interval{-3.8, 4.9}), interval{-3.0, 4.0, 0});
     check("test algebra IntCast", IntCast(interval{-HUGE_VAL, HUGE_VAL}), interval{-2147483648.0, 2147483647.0, 0});
+    check("test algebra IntCast lsb", IntCast(interval{0, 64, 2}).lsb() == 2, true);
+    check("test algebra IntCast saturated", IntCast(interval{0, HUGE_VAL, 31}), interval{0, 2147483647.0, 0});
+    check("test algebra FloatNum lsb", FloatNum(0.375).lsb() == -3, true);
 }
 }  // namespace itv
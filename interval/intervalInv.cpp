@@ -30,12 +30,12 @@ interval interval_algebra::Inv(const interval& x) const
         return {};
     }
     if ((x.hi() < 0) || (x.lo() >= 0)) {
-        return {1.0 / x.hi(), 1.0 / x.lo()};
+        return {1.0 / (x.hi() + 0.0), 1.0 / (x.lo() + 0.0), fPrecision};  // the bounds -0 are the 0 of [0,hi]
     }
     if (x.hi() == 0) {
-        return {-HUGE_VAL, 1.0 / x.lo()};
+        return {-HUGE_VAL, 1.0 / x.lo(), fPrecision};
     }
-    return {-HUGE_VAL, HUGE_VAL};
+    return {-HUGE_VAL, HUGE_VAL, fPrecision};
 }
 
 void interval_algebra::testInv() const
@@ -46,5 +46,6 @@ void interval_algebra::testInv() const
     check("test algebra Inv", Inv(interval(-10, 0)), interval(-HUGE_VAL, -0.1));
     check("test algebra Inv", Inv(interval(-20, +20)), interval(-HUGE_VAL, +HUGE_VAL));
     check("test algebra Inv", Inv(interval(0, 0)), interval(+HUGE_VAL, +HUGE_VAL));
+    check("test algebra Inv", Inv(interval(-0.0, 10)), interval(0.1, +HUGE_VAL));
 }
 }  // namespace itv
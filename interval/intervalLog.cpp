@@ -31,7 +31,7 @@ interval interval_algebra::Log(const interval& x) const
     if (x.isEmpty()) return {};
 
     interval i = intersection(interval(0, HUGE_VAL), x);
-    return {log(i.lo()), log(i.hi())};
+    return {log(i.lo()), log(i.hi()), fPrecision};
 }
 
 void interval_algebra::testLog() const
@@ -31,7 +31,7 @@ interval interval_algebra::Log10(const interval& x) const
     if (x.isEmpty()) return {};
 
     interval i = intersection(interval(0, HUGE_VAL), x);
-    return {log10(i.lo()), log10(i.hi())};
+    return {log10(i.lo()), log10(i.hi()), fPrecision};
 }
 
 void interval_algebra::testLog10() const
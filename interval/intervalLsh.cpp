@@ -29,8 +29,14 @@ namespace itv {
 
 interval interval_algebra::Lsh(const interval& x, const interval& y) const
 {
-    interval j{pow(2, y.lo()), pow(2, y.hi())};
-    return Mul(x, j);
+    // for integer shifts, the smallest factor 2^y.lo() gives the lsb of the factors, and of the result
+    if ((y.lsb() >= 0) || (y.isconst() && (std::rint(y.lo()) == y.lo()))) {
+        interval j{pow(2, y.lo()), pow(2, y.hi()), std::clamp(saturatedIntCast(std::floor(y.lo())), kMinLSB, 1023)};
+        return Mul(x, j);
+    }
+    // the factors of fractional shifts are not exact, the result has the precision of the algebra like Div
+    interval z = Mul(x, interval(pow(2, y.lo()), pow(2, y.hi()), kMinLSB));
+    return {z.lo(), z.hi(), fPrecision};
 }
 
 void interval_algebra::testLsh() const
@@ -38,5 +44,9 @@ void interval_algebra::testLsh() const
     check("test algebra Lsh", Lsh(interval(0, 1), interval(4)), interval(0, 16));
     check("test algebra Lsh", Lsh(interval(0.5, 1), interval(-1, 4)), interval(0.25, 16));
     check("test algebra Lsh", Lsh(interval(-10, 10), interval(-1, 4)), interval(-160, 160));
+    check("test algebra Lsh lsb", Lsh(interval(0, 1, -8), interval(3)).lsb() == -5, true);
+    check("test algebra Rsh lsb", Rsh(interval(0, 255, 0), interval(1, 2, 0)).lsb() == -2, true);
+    check("test algebra Lsh fractional", std::fabs(Lsh(interval(1), interval(-0.5)).hi() - std::sqrt(0.5)) < 1e-6,
+          true);
 }
 }  // namespace itv
@@ -29,12 +29,13 @@ namespace itv {
 interval interval_algebra::Mem(const interval& x) const
 {
     if (x.isEmpty()) return {};
-    return reunion(x, interval{0});
+    return reunion(x, interval{0, 0, x.lsb()});
 }
 
 void interval_algebra::testMem() const
 {
     check("test algebra Mem", Mem(interval(5)), interval(0, 5));
     check("test algebra Mem", Mem(interval(-1, 1)), interval(-1, 1));
+    check("test algebra Mem lsb", Mem(interval(4, 8, 2)).lsb() == 2, true);
 }
 }  // namespace itv
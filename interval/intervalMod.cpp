@@ -25,19 +25,19 @@ namespace itv {
 // modulo function on intervals
 // (see https://stackoverflow.com/questions/31057473/calculating-the-modulo-of-two-intervals)
 
-interval interval_algebra::Mod(const interval& x, double m) const
+interval interval_algebra::modulo(const interval& x, double m) const
 {
     if (x.isEmpty() || (m == 0)) {
         return {};
     }
 
     if (x.hi() < 0) {
-        return Neg(Mod({-x.hi(), -x.lo()}, m));
+        return Neg(modulo({-x.hi(), -x.lo()}, m));
         // (3): split into negative and non-negative interval, compute and join
     }
 
     if (x.lo() < 0) {
-        return reunion(Mod({x.lo(), nextafter(-0.0, -HUGE_VAL)}, m), Mod({0.0, x.hi()}, m));
+        return reunion(modulo({x.lo(), nextafter(-0.0, -HUGE_VAL)}, m), modulo({0.0, x.hi()}, m));
         // (4): there is no k > 0 such that x.lo() < k*m <= x.hi()
     }
 
@@ -49,29 +49,29 @@ interval interval_algebra::Mod(const interval& x, double m) const
     return {0, nextafter(fabs(m), 0.0)};
 }
 
-interval interval_algebra::Mod(const interval& x, const interval& y) const
+interval interval_algebra::modulo(const interval& x, const interval& y) const
 {
     if (x.isEmpty() || y.isEmpty()) {
         return {};
     }
     if (x.hi() < 0) {
-        return Neg(Mod({-x.hi(), -x.lo()}, {y.lo(), y.hi()}));
+        return Neg(modulo({-x.hi(), -x.lo()}, {y.lo(), y.hi()}));
         // (3): split into negative and non-negative interval, compute, and join
     }
     if (x.lo() < 0) {
-        return reunion(Mod({x.lo(), -1}, {y.lo(), y.hi()}), Mod({0, x.hi()}, {y.lo(), y.hi()}));
+        return reunion(modulo({x.lo(), -1}, {y.lo(), y.hi()}), modulo({0, x.hi()}, {y.lo(), y.hi()}));
         // (4) use the simpler function from before
     }
     if (y.lo() == y.hi()) {
-        return Mod({x.lo(), x.hi()}, y.lo());
+        return modulo({x.lo(), x.hi()}, y.lo());
         // (5) use only non-negative y.lo() and y.hi()
     }
     if (y.hi() <= 0) {
-        return Mod({x.lo(), x.hi()}, {-y.hi(), -y.lo()});
+        return modulo({x.lo(), x.hi()}, {-y.hi(), -y.lo()});
         // (6) similar to (5), make modulus non-negative
     }
     if (y.lo() <= 0) {
-        return Mod({x.lo(), x.hi()}, {1, std::max(-y.lo(), y.hi())});
+        return modulo({x.lo(), x.hi()}, {1, std::max(-y.lo(), y.hi())});
         // (7) compare to (4) in mod1, check x.hi()-x.lo() < |modulus|
     }
     if (x.hi() - x.lo() >= y.hi()) {
@@ -79,7 +79,10 @@ interval interval_algebra::Mod(const interval& x, const interval& y) const
         // (8) similar to (7), split interval, compute, and join
     }
     if (x.hi() - x.lo() >= y.lo()) {
-        return reunion({0, x.hi() - x.lo() - 1}, Mod({x.lo(), x.hi()}, {x.hi() - x.lo() + 1, y.hi()}));
+        if (x.hi() - x.lo() + 1 == x.hi() - x.lo()) {
+            return {0, std::min(x.hi(), y.hi())};  // too large to split, the recursion wouldn't progress
+        }
+        return reunion({0, x.hi() - x.lo() - 1}, modulo({x.lo(), x.hi()}, {x.hi() - x.lo() + 1, y.hi()}));
         // (9) modulo has no effect
     }
     if (y.lo() > x.hi()) {
@@ -93,9 +96,23 @@ interval interval_algebra::Mod(const interval& x, const interval& y) const
     return {0, y.hi() - 1};
 }
 
+// x % y = x - k*y is a multiple of the lsb of x and y
+interval interval_algebra::Mod(const interval& x, double m) const
+{
+    interval z = modulo(x, m);
+    return {z.lo(), z.hi(), std::min(x.lsb(), std::max(exactLSB(m), fPrecision))};
+}
+
+interval interval_algebra::Mod(const interval& x, const interval& y) const
+{
+    interval z = modulo(x, y);
+    return {z.lo(), z.hi(), std::min(x.lsb(), y.lsb())};
+}
+
 void interval_algebra::testMod() const
 {
-    check("test algebra Mod", Mod(interval(-100, 100), 1.0), interval(nextafter(-1.0, 0.0), nextafter(1.0, 0.0)));
+    // ]-1,1[ with the default lsb of -24
+    check("test algebra Mod", Mod(interval(-100, 100), 1.0), interval(std::ldexp(1.0, -24) - 1, 1 - std::ldexp(1.0, -24)));
     check("test algebra Mod", Mod(interval(0, 100), 2), interval(0, nextafter(2.0, 0)));
     check("test algebra Mod", Mod(interval(0, 100), -1.0), interval(0, nextafter(1.0, 0)));
     check("test algebra Mod", Mod(interval(5, 7), interval(8, 10)), interval(5, 7));
@@ -51,7 +51,8 @@ interval interval_algebra::Mul(const interval& x, const interval& y) const
     double b = specialmult(x.lo(), y.hi());
     double c = specialmult(x.hi(), y.lo());
     double d = specialmult(x.hi(), y.hi());
-    return {min4(a, b, c, d), max4(a, b, c, d)};
+    // the products of multiples of 2^lx and 2^ly are multiples of 2^(lx+ly)
+    return {min4(a, b, c, d), max4(a, b, c, d), std::max(x.lsb() + y.lsb(), kMinLSB)};
 }
 
 void interval_algebra::testMul() const
@@ -61,5 +62,7 @@ void interval_algebra::testMul() const
     check("test algebra Mul", Mul(interval(-2, -1), interval(-2, -1)), interval(1, 4));
     check("test algebra Mul", Mul(interval(0), interval(-HUGE_VAL, HUGE_VAL)), interval(0));
     check("test algebra Mul", Mul(interval(-HUGE_VAL, HUGE_VAL), interval(0)), interval(0));
+    check("test algebra Mul lsb", Mul(interval(0, 1, -8), interval(0, 1, -8)).lsb() == -16, true);
+    check("test algebra Mul lsb", Mul(interval(0, 1, -1000), interval(0, 1, -1000)).lsb() == kMinLSB, true);
 }
 }  // namespace itv
@@ -28,7 +28,7 @@ interval interval_algebra::Neg(const interval& x) const
 {
     if (x.isEmpty()) return {};
 
-    return {-x.hi(), -x.lo()};
+    return {-x.hi(), -x.lo(), x.lsb()};
 }
 
 void interval_algebra::testNeg() const
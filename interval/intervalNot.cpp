@@ -16,6 +16,7 @@
 #include <functional>
 #include <random>
 
+#include "bitwiseOperations.hh"
 #include "check.hh"
 #include "interval_algebra.hh"
 #include "interval_def.hh"
@@ -32,15 +33,9 @@ interval interval_algebra::Not(const interval& x) const
     int x0 = saturatedIntCast(x.lo());
     int x1 = saturatedIntCast(x.hi());
 
-    int z0 = INT32_MAX;
-    int z1 = INT32_MIN;
-
-    for (int i = x0; i <= x1; i++) {
-        int z = ~i;
-        if (z < z0) z0 = z;
-        if (z > z1) z1 = z;
-    }
-    return {double(z0), double(z1)};
+    // ~i = -i-1 is decreasing, no need to enumerate the interval
+    SInterval z = bitwiseSignedNot({x0, x1});
+    return {double(z.lo), double(z.hi), 0};
 }
 
 static double myNot(double x)
@@ -12,16 +12,77 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+#include "check.hh"
 #include "interval_algebra.hh"
 #include "interval_def.hh"
 
 namespace itv {
 //------------------------------------------------------------------------------------------
-// Interval IntNum
+// Interval NumEntry, HSlider and VSlider
+// The values of a user interface element are lo + k*step, up to hi. Their lsb
+// is the lsb of lo, hi and step when the step is a multiple of 2^lsb (integer
+// and dyadic steps), so that integer stepped elements have lsb >= 0. The
+// values of a decimal step are not on a binary grid: they have the precision
+// of the algebra (and the lsb of lo when it is finer).
+
+static int stepLSB(double lo, double hi, double step, int precision)
+{
+    if (!(step > 0) || !std::isfinite(step)) return precision;  // no usable step
+    int s = exactLSB(step);
+    if (s < std::ilogb(step) - 12) return std::min(precision, exactLSB(lo));  // decimal step
+    return std::min({s, exactLSB(lo), exactLSB(hi)});
+}
 
 interval interval_algebra::NumEntry(const interval& name, const interval& init, const interval& lo, const interval& hi,
                                     const interval& step) const
 {
-    return {lo.lo(), hi.hi(), -24};  // TODO: step, init
+    if (lo.isEmpty() || hi.isEmpty()) return {NAN, NAN};
+    double a   = lo.lo();
+    double b   = hi.hi();
+    int    lsb = (step.isEmpty()) ? fPrecision : stepLSB(a, b, step.lo(), fPrecision);
+    // hi is not always a multiple of 2^lsb with decimal steps, it is rounded up
+    interval x(a, b, lsb);
+    return (x.hi() < b) ? interval(x.lo(), b + std::ldexp(1.0, x.lsb()), x.lsb()) : x;
+}
+
+interval interval_algebra::SliderInit(const interval& init, const interval& lo, const interval& hi,
+                                      const interval& step) const
+{
+    interval r = NumEntry(interval{}, init, lo, hi, step);
+    if (r.isEmpty() || init.isEmpty()) return r;
+    double a = std::clamp(init.lo(), r.lo(), r.hi());
+    double b = std::clamp(init.hi(), r.lo(), r.hi());
+    return {a, std::max(a, b), r.lsb()};
+}
+
+void interval_algebra::testNumEntry() const
+{
+    interval n;
+    check("test algebra NumEntry", NumEntry(n, interval(0), interval(0), interval(10), interval(0.01)),
+          interval(0, 10, -24));
+    check("test algebra NumEntry lsb",
+          NumEntry(n, interval(0), interval(0), interval(10), interval(0.01)).lsb() == fPrecision, true);
+    check("test algebra NumEntry int", NumEntry(n, interval(1), interval(1), interval(16), interval(1)).lsb() == 0,
+          true);
+    check("test algebra NumEntry even", NumEntry(n, interval(0), interval(0), interval(64), interval(4)).lsb() == 2,
+          true);
+    check("test algebra NumEntry dyadic",
+          NumEntry(n, interval(0), interval(-1), interval(1), interval(0.25)).lsb() == -2, true);
+    check("test algebra NumEntry hi",
+          NumEntry(n, interval(0), interval(0), interval(0.95), interval(0.1)).hi() >= interval(0.95).hi(), true);
+    check("test algebra NumEntry decimal",
+          HSlider(n, interval(0), interval(0), interval(10), interval(1.1)).lsb() < 0, true);
+    check("test algebra NumEntry decimal hi",
+          HSlider(n, interval(0), interval(0), interval(100), interval(10.3)).hi() <= 100 + 1e-6, true);
+    check("test algebra HSlider", HSlider(n, interval(0), interval(20), interval(20000), interval(1)),
+          interval(20, 20000, 0));
+    check("test algebra SliderInit", SliderInit(interval(440), interval(20), interval(20000), interval(1)),
+          interval(440, 440, 0));
+    check("test algebra SliderInit clamp", SliderInit(interval(-5), interval(0), interval(1), interval(0.5)),
+          interval(0));
 }
 }  // namespace itv
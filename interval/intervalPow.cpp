@@ -38,7 +38,7 @@ static interval ipow(const interval& x, int y)
         // y is even
         double z0 = std::pow(x.lo(), y);
         double z1 = std::pow(x.hi(), y);
-        return {0, std::max(z0, z1)};
+        return {x.hasZero() ? 0 : std::min(z0, z1), std::max(z0, z1)};
     }
 
     // y is odd
@@ -52,16 +52,24 @@ interval interval_algebra::fPow(const interval& x, const interval& y) const
     return Exp(Mul(y, Log(x)));
 }
 
+// x^y for an integer y, a negative one being 1/x^-y
+interval interval_algebra::zPow(const interval& x, int y) const
+{
+    if (y >= 0) return ipow(x, y);
+    return Inv(ipow(x, (y == INT_MIN) ? INT_MAX - 1 : -y));  // -INT_MIN overflows, INT_MAX - 1 is even like it
+}
+
 interval interval_algebra::iPow(const interval& x, const interval& y) const
 {
-    int      y0 = std::max(0, saturatedIntCast(y.lo()));
-    int      y1 = std::max(0, saturatedIntCast(y.hi()));
-    interval z  = ipow(x, y0);
+    // |x|^y is monotonic in y, the extremes of each sign are at the two smallest and two largest exponents
+    int      y0 = saturatedIntCast(y.lo());
+    int      y1 = saturatedIntCast(y.hi());
+    interval z  = zPow(x, y0);
     if (y1 > y0) {
         // we have more than one integer exponent
-        z = reunion(z, ipow(x, y0 + 1));
-        z = reunion(z, ipow(x, y1 - 1));
-        z = reunion(z, ipow(x, y1));
+        z = reunion(z, zPow(x, y0 + 1));
+        z = reunion(z, zPow(x, y1 - 1));
+        z = reunion(z, zPow(x, y1));
     }
     return z;
 }
@@ -71,7 +79,9 @@ interval interval_algebra::Pow(const interval& x, const interval& y) const
     if (x.lo() > 0) {
         return fPow(x, y);
     }
-    return iPow(x, y);
+    // the non-negative integer powers of integers are integers
+    interval z = iPow(x, y);
+    return {z.lo(), z.hi(), ((x.lsb() >= 0) && (saturatedIntCast(y.lo()) >= 0)) ? 0 : fPrecision};
 }
 
 static double myfPow(double x, double y)
@@ -89,6 +99,8 @@ void interval_algebra::testPow() const
     analyzeBinaryMethod(10, 2000, "iPow2", interval(-100, 100), interval(0, 20), myiPow, &interval_algebra::iPow);
     analyzeBinaryMethod(10, 2000, "iPow2", interval(-1, 1), interval(1, 3), myiPow, &interval_algebra::iPow);
     analyzeBinaryMethod(10, 2000, "iPow2", interval(-1, 1), interval(1, 10), myiPow, &interval_algebra::iPow);
+    analyzeBinaryMethod(10, 2000, "iPow2", interval(-100, -1), interval(-10, 10), myiPow, &interval_algebra::iPow);
+    check("test algebra Pow negative", Pow(interval(-4, -2, 0), interval(-2, -2, 0)), interval(1.0 / 16, 0.25));
     analyzeBinaryMethod(10, 2000, "fPow2", interval(1, 1000), interval(-10, 10), myfPow, &interval_algebra::fPow);
     analyzeBinaryMethod(10, 2000, "fPow2", interval(0.001, 1), interval(-10, 10), myfPow, &interval_algebra::fPow);
     analyzeBinaryMethod(10, 2000, "fPow2", interval(0.001, 10), interval(-20, 20), myfPow, &interval_algebra::fPow);
@@ -0,0 +1,133 @@
+/* Copyright 2023 Yann ORLAREY
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "check.hh"
+#include "interval_algebra.hh"
+#include "interval_def.hh"
+
+namespace itv {
+//------------------------------------------------------------------------------------------
+// Interval RdTbl
+// interval RdTbl(const interval& tbl, const interval& index) const;
+// void testRdTbl() const;
+
+// A table is represented by the summary of its content: the interval of the
+// values it can hold. The summary of a table computed at compile time is
+// given by tableContent() once the table is built, a write table widens it
+// with the values written (see WrTbl). A read returns the summary, the index
+// being checked apart by tableIndexSafe().
+
+// min/max reductions written as plain loops on independent accumulators, that the compiler vectorizes. The same
+// pass finds the non-integer values: |v| < 2^(digits-1) is an integer when adding and subtracting 2^(digits-1)
+// (which rounds it to an integer) leaves it unchanged. A table of integers has the lsb 0, the others the lsb of
+// the algebra, or of their bounds when it is finer (as the decimal steps of the sliders).
+template <typename T>
+static interval content(const T* data, size_t n, int precision)
+{
+    constexpr int K = 4;
+    constexpr T   M = T(1) / std::numeric_limits<T>::epsilon();  // 2^(digits-1), above it all the values are integers
+    T             lo[K], hi[K];
+    bool          nan = false, frac = false;
+    for (int k = 0; k < K; k++) {
+        lo[k] = std::numeric_limits<T>::infinity();
+        hi[k] = -std::numeric_limits<T>::infinity();
+    }
+    size_t i = 0;
+    for (; i + K <= n; i += K) {
+        for (int k = 0; k < K; k++) {
+            T v   = data[i + k];
+            lo[k] = (v < lo[k]) ? v : lo[k];
+            hi[k] = (v > hi[k]) ? v : hi[k];
+            T a   = std::fabs(v);
+            nan |= (v != v);
+            frac |= (a < M) & ((a + M) - M != a);
+        }
+    }
+    for (; i < n; i++) {
+        T v   = data[i];
+        lo[0] = (v < lo[0]) ? v : lo[0];
+        hi[0] = (v > hi[0]) ? v : hi[0];
+        T a   = std::fabs(v);
+        nan |= (v != v);
+        frac |= (a < M) & ((a + M) - M != a);
+    }
+    if (nan) return {};  // the table can produce NaN
+    for (int k = 1; k < K; k++) {
+        lo[0] = std::min(lo[0], lo[k]);
+        hi[0] = std::max(hi[0], hi[k]);
+    }
+    if (lo[0] > hi[0]) return {NAN, NAN};  // empty table
+    if (!frac) return {double(lo[0]), double(hi[0]), 0};
+    int lsb = std::min({precision, exactLSB(double(lo[0])), exactLSB(double(hi[0]))});
+    return {double(lo[0]), double(hi[0]), lsb};
+}
+
+interval interval_algebra::tableContent(const double* data, size_t n) const
+{
+    return content(data, n, fPrecision);
+}
+
+interval interval_algebra::tableContent(const float* data, size_t n) const
+{
+    return content(data, n, fPrecision);
+}
+
+bool interval_algebra::tableIndexSafe(const interval& index, int size) const
+{
+    if (index.isEmpty()) return true;
+    interval i = IntCast(index);
+    return (i.lo() >= 0) && (i.hi() <= size - 1);
+}
+
+interval interval_algebra::RdTbl(const interval& tbl, const interval& index) const
+{
+    if (index.isEmpty()) return {NAN, NAN};
+    return tbl;
+}
+
+void interval_algebra::testRdTbl() const
+{
+    std::vector<double> sine(1000);
+    for (size_t i = 0; i < sine.size(); i++) sine[i] = std::sin(2 * M_PI * double(i) / 1000);
+    interval s = tableContent(sine.data(), sine.size());
+    check("test algebra RdTbl content", (s.lo() >= -1) && (s.lo() < -0.99) && (s.hi() <= 1) && (s.hi() > 0.99), true);
+    check("test algebra RdTbl", RdTbl(s, interval(0, 999, 0)), s);
+
+    float ints[5]{3, -2, 7, 0, 1};
+    check("test algebra RdTbl integers", tableContent(ints, 5), interval(-2, 7, 0));
+    check("test algebra RdTbl integers lsb", tableContent(ints, 5).lsb() == 0, true);
+    check("test algebra RdTbl sine lsb", s.lsb() <= fPrecision, true);
+    double big[3]{0x1p60, -0x1p53, 1e300};
+    check("test algebra RdTbl big integers lsb", tableContent(big, 3).lsb() == 0, true);
+    float halves[3]{-1.5F, 0.25F, 2};
+    check("test algebra RdTbl halves", tableContent(halves, 3), interval(-1.5, 2));
+    double nan[2]{1, NAN};
+    check("test algebra RdTbl NaN", tableContent(nan, 2), interval());
+    check("test algebra RdTbl empty", tableContent(sine.data(), 0).isEmpty(), true);
+
+    check("test algebra RdTbl index", tableIndexSafe(interval(0, 999, 0), 1000), true);
+    check("test algebra RdTbl index", tableIndexSafe(interval(0, 999.5), 1000), true);  // int(999.5) == 999
+    check("test algebra RdTbl index", tableIndexSafe(interval(0, 1000, 0), 1000), false);
+    check("test algebra RdTbl index", tableIndexSafe(interval(-1, 10, 0), 1000), false);
+}
+}  // namespace itv
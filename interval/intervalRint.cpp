@@ -28,7 +28,7 @@ namespace itv {
 
 interval interval_algebra::Rint(const interval& x) const
 {
-    return {rint(x.lo()), rint(x.hi())};
+    return {rint(x.lo()), rint(x.hi()), std::max(x.lsb(), 0)};
 }
 
 void interval_algebra::testRint() const
@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 #include <algorithm>
+#include <cmath>
 #include <functional>
 #include <random>
 
@@ -28,12 +29,19 @@ namespace itv {
 
 interval interval_algebra::Rsh(const interval& x, const interval& y) const
 {
-    interval j{pow(2, -y.hi()), pow(2, -y.lo())};
-    return Mul(x, j);
+    // for integer shifts, the smallest factor 2^-y.hi() gives the lsb of the factors, and of the result
+    if ((y.lsb() >= 0) || (y.isconst() && (std::rint(y.lo()) == y.lo()))) {
+        interval j{pow(2, -y.hi()), pow(2, -y.lo()), std::clamp(-saturatedIntCast(std::ceil(y.hi())), kMinLSB, 1023)};
+        return Mul(x, j);
+    }
+    // the factors of fractional shifts are not exact, the result has the precision of the algebra like Div
+    interval z = Mul(x, interval(pow(2, -y.hi()), pow(2, -y.lo()), kMinLSB));
+    return {z.lo(), z.hi(), fPrecision};
 }
 
 void interval_algebra::testRsh() const
 {
     check("test algebra Rsh", Rsh(interval(8, 16), interval(4)), interval(0.5, 1));
+    check("test algebra Rsh fractional", std::fabs(Rsh(interval(1), interval(0.5)).hi() - std::sqrt(0.5)) < 1e-6, true);
 }
 }  // namespace itv
@@ -0,0 +1,61 @@
+/* Copyright 2023 Yann ORLAREY
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <functional>
+#include <random>
+
+#include "check.hh"
+#include "interval_algebra.hh"
+#include "interval_def.hh"
+
+namespace itv {
+//------------------------------------------------------------------------------------------
+// Interval Select2
+// interval Select2(const interval& s, const interval& x, const interval& y) const;
+// void testSelect2() const;
+
+// The selector is cast to int, as in the code generated by Faust: select2(s,x,y)
+// is x when int(s) == 0 and y otherwise, select3(s,x,y,z) is x when int(s) == 0,
+// y when int(s) == 1 and z otherwise. Only the branches reachable with the range
+// of the selector are gathered, the others are dead and can be skipped.
+
+unsigned interval_algebra::selectBranches(const interval& s, int n) const
+{
+    if (s.isEmpty()) return 0;
+    interval i = IntCast(s);
+    unsigned b = i.has(0) ? 1U : 0U;
+    if (n == 2) return b | (!i.isZero() ? 2U : 0U);
+    return b | (i.has(1) ? 2U : 0U) | (((i.lo() < 0) || (i.hi() > 1)) ? 4U : 0U);
+}
+
+interval interval_algebra::Select2(const interval& s, const interval& x, const interval& y) const
+{
+    unsigned b = selectBranches(s, 2);
+    interval r(NAN, NAN);
+    if ((b & 1U) != 0) r = reunion(r, x);
+    if ((b & 2U) != 0) r = reunion(r, y);
+    return r;
+}
+
+void interval_algebra::testSelect2() const
+{
+    interval x(0, 1), y(10, 20);
+    check("test algebra Select2", Select2(interval(0, 1, 0), x, y), interval(0, 20));
+    check("test algebra Select2", Select2(interval(0), x, y), x);
+    check("test algebra Select2", Select2(interval(1, 5, 0), x, y), y);
+    check("test algebra Select2", Select2(interval(-0.5, 0.5), x, y), x);  // int(s) == 0
+    check("test algebra Select2 dead", selectBranches(interval(1, 5, 0), 2) == 2U, true);
+    check("test algebra Select2 empty", Select2(interval(NAN, NAN), x, y).isEmpty(), true);
+}
+}  // namespace itv
@@ -0,0 +1,48 @@
+/* Copyright 2023 Yann ORLAREY
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <functional>
+#include <random>
+
+#include "check.hh"
+#include "interval_algebra.hh"
+#include "interval_def.hh"
+
+namespace itv {
+//------------------------------------------------------------------------------------------
+// Interval Select3
+// interval Select3(const interval& s, const interval& x, const interval& y, const interval& z) const;
+// void testSelect3() const;
+
+interval interval_algebra::Select3(const interval& s, const interval& x, const interval& y, const interval& z) const
+{
+    unsigned b = selectBranches(s, 3);
+    interval r(NAN, NAN);
+    if ((b & 1U) != 0) r = reunion(r, x);
+    if ((b & 2U) != 0) r = reunion(r, y);
+    if ((b & 4U) != 0) r = reunion(r, z);
+    return r;
+}
+
+void interval_algebra::testSelect3() const
+{
+    interval x(0, 1), y(10, 20), z(-5, -4);
+    check("test algebra Select3", Select3(interval(0, 2, 0), x, y, z), interval(-5, 20));
+    check("test algebra Select3", Select3(interval(0, 1, 0), x, y, z), interval(0, 20));
+    check("test algebra Select3", Select3(interval(1, 1), x, y, z), y);
+    check("test algebra Select3", Select3(interval(2, 7, 0), x, y, z), z);
+    check("test algebra Select3", Select3(interval(-1, 0, 0), x, y, z), interval(-5, 1));
+    check("test algebra Select3 dead", selectBranches(interval(1, 2, 0), 3) == 6U, true);
+}
+}  // namespace itv
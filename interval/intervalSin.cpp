@@ -30,12 +30,12 @@ namespace itv {
 interval interval_algebra::Sin(const interval& x) const
 {
     double TWOPI = 2 * M_PI;
-    if (x.size() >= TWOPI) return {-1, 1};
+    if (x.size() >= TWOPI) return {-1, 1, fPrecision};
 
     // normalize input interval between 0..4PI
     double l = fmod(x.lo(), TWOPI);
     if (l < 0) l += TWOPI;
-    interval i(l, l + x.size());
+    interval i(l, l + x.size(), kMinLSB);  // not truncated, a tiny argument must keep its variation
 
     // compute the default boundaries
     double a  = sin(i.lo());
@@ -47,7 +47,7 @@ interval interval_algebra::Sin(const interval& x) const
     if (i.has(M_PI_2) || i.has(5 * M_PI_2)) hi = 1;
     if (i.has(3 * M_PI_2) || i.has(7 * M_PI_2)) lo = -1;
 
-    return {lo, hi};
+    return {lo, hi, fPrecision};
 }
 
 void interval_algebra::testSin() const
@@ -30,7 +30,7 @@ interval interval_algebra::Sinh(const interval& x) const
 {
     if (x.isEmpty()) return x;
 
-    return {sinh(x.lo()), sinh(x.hi())};
+    return {sinh(x.lo()), sinh(x.hi()), fPrecision};
 }
 
 void interval_algebra::testSinh() const
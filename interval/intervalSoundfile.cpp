@@ -0,0 +1,52 @@
+/* Copyright 2023 Yann ORLAREY
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cfloat>
+#include <cmath>
+#include <functional>
+#include <random>
+
+#include "check.hh"
+#include "interval_algebra.hh"
+#include "interval_def.hh"
+
+namespace itv {
+//------------------------------------------------------------------------------------------
+// Interval Soundfile
+// interval Soundfile(const interval& index, int bits) const;
+// void testSoundfile() const;
+
+// The samples of a soundfile read in a buffer of doubles, for the sample format
+// of the file: the signed integer formats of b bits are normalized to
+// [-1, 1-2^(1-b)] with an lsb of 1-b, the float formats aren't normalized and
+// are bounded by the largest float (bits 32) or double (bits 64).
+interval interval_algebra::Soundfile(const interval& index, int bits) const
+{
+    if (index.isEmpty()) return {NAN, NAN};
+    if (bits == 32) return {-FLT_MAX, FLT_MAX, -149};
+    if (bits == 64) return {-DBL_MAX, DBL_MAX, kMinLSB};
+    if ((bits < 2) || (bits > 31)) return {};
+    return {-1, 1 - std::ldexp(1.0, 1 - bits), 1 - bits};
+}
+
+void interval_algebra::testSoundfile() const
+{
+    interval i(0, 44099, 0);
+    check("test algebra Soundfile 16 bits", Soundfile(i, 16), interval(-1, 1 - std::ldexp(1.0, -15)));
+    check("test algebra Soundfile 16 bits lsb", Soundfile(i, 16).lsb() == -15, true);
+    check("test algebra Soundfile 24 bits", Soundfile(i, 24).hi() < 1, true);
+    check("test algebra Soundfile 8 bits", Soundfile(i, 8), interval(-1, 127.0 / 128));
+    check("test algebra Soundfile float", Soundfile(i, 32).hi() == FLT_MAX, true);
+}
+}  // namespace itv
@@ -31,7 +31,7 @@ interval interval_algebra::Sqrt(const interval& x) const
     if (x.isEmpty()) return x;
     if (x.lo() < 0) return {};  // sqrt of negative numbers
 
-    return {sqrt(x.lo()), sqrt(x.hi())};
+    return {sqrt(x.lo()), sqrt(x.hi()), fPrecision};
 }
 
 void interval_algebra::testSqrt() const
@@ -28,7 +28,10 @@ interval interval_algebra::Sub(const interval& x, const interval& y) const
 {
     if (x.isEmpty() || y.isEmpty()) return {};
 
-    return {x.lo() - y.hi(), x.hi() - y.lo()};
+    // inf-inf bounds are undefined, the other combinations of the arguments still reach the infinities
+    double lo = x.lo() - y.hi();
+    double hi = x.hi() - y.lo();
+    return {std::isnan(lo) ? -HUGE_VAL : lo, std::isnan(hi) ? HUGE_VAL : hi, std::min(x.lsb(), y.lsb())};
 }
 
 void interval_algebra::testSub() const
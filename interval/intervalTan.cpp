@@ -37,7 +37,7 @@ interval interval_algebra::Tan(const interval& x) const
     // normalize input interval between 0..4PI
     double l = fmod(x.lo(), TWOPI);
     if (l < 0) l += TWOPI;
-    interval i(l, l + x.size());
+    interval i(l, l + x.size(), kMinLSB);  // not truncated, a tiny argument must keep its variation
 
     if (i.has(M_PI_2) || i.has(3 * M_PI_2) || i.has(5 * M_PI_2) || i.has(7 * M_PI_2)) {
         return {};  //  we have undefined values
@@ -47,7 +47,7 @@ interval interval_algebra::Tan(const interval& x) const
     double b  = tan(i.hi());
     double lo = std::min(a, b);
     double hi = std::max(a, b);
-    return {lo, hi};
+    return {lo, hi, fPrecision};
 }
 
 void interval_algebra::testTan() const
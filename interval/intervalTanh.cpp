@@ -30,7 +30,7 @@ namespace itv {
 interval interval_algebra::Tanh(const interval& x) const
 {
     if (x.isEmpty()) return {};
-    return {tanh(x.lo()), tanh(x.hi())};
+    return {tanh(x.lo()), tanh(x.hi()), fPrecision};
 }
 
 void interval_algebra::testTanh() const
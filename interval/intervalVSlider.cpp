@@ -17,11 +17,11 @@
 
 namespace itv {
 //------------------------------------------------------------------------------------------
-// Interval IntNum
+// Interval VSlider, computed as NumEntry
 
 interval interval_algebra::VSlider(const interval& name, const interval& init, const interval& lo, const interval& hi,
                                    const interval& step) const
 {
-    return {lo.lo(), hi.hi(), -24};  // TODO: step, init
+    return NumEntry(name, init, lo, hi, step);
 }
 }  // namespace itv
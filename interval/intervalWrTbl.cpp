@@ -0,0 +1,46 @@
+/* Copyright 2023 Yann ORLAREY
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <functional>
+#include <random>
+
+#include "check.hh"
+#include "interval_algebra.hh"
+#include "interval_def.hh"
+
+namespace itv {
+//------------------------------------------------------------------------------------------
+// Interval WrTbl
+// interval WrTbl(const interval& n, const interval& init, const interval& index, const interval& value) const;
+// void testWrTbl() const;
+
+// the summary of a table of n values initialized with init, widened by the values written
+interval interval_algebra::WrTbl(const interval& n, const interval& init, const interval& index,
+                                 const interval& value) const
+{
+    if (n.isEmpty()) return {NAN, NAN};
+    if (index.isEmpty() || value.isEmpty()) return init;  // read only table
+    return reunion(init, value);
+}
+
+void interval_algebra::testWrTbl() const
+{
+    interval n(256, 256, 0);
+    check("test algebra WrTbl", WrTbl(n, interval(0, 0, 0), interval(0, 255, 0), interval(-1, 1)), interval(-1, 1));
+    check("test algebra WrTbl", WrTbl(n, interval(-2, 3), interval(0, 255, 0), interval(-1, 1)), interval(-2, 3));
+    check("test algebra WrTbl read only", WrTbl(n, interval(-2, 3), interval(NAN, NAN), interval(NAN, NAN)),
+          interval(-2, 3));
+    check("test algebra WrTbl lsb", WrTbl(n, interval(0, 4, 0), interval(0), interval(-1, 1, -8)).lsb() == -8, true);
+}
+}  // namespace itv
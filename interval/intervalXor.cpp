@@ -44,7 +44,7 @@ interval interval_algebra::Xor(const interval& x, const interval& y) const
     auto y1 = saturatedIntCast(y.hi());
 
     SInterval z = bitwiseSignedXOr({x0, x1}, {y0, y1});
-    return {double(z.lo), double(z.hi)};
+    return {double(z.lo), double(z.hi), 0};
 }
 
 void interval_algebra::testXor() const
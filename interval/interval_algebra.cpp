@@ -20,52 +20,77 @@
 #include "interval_algebra.hh"
 #include "interval_def.hh"
 namespace itv {
+// the tests of the methods, in alphabetical order, run by testAll() or registered by registerTests()
+using test_method = void (interval_algebra::*)() const;
+
+struct primitive_test {
+    const char* name;
+    test_method test;
+};
+
+static const primitive_test gPrimitiveTests[] = {
+    {"Abs", &interval_algebra::testAbs},
+    {"Acos", &interval_algebra::testAcos},
+    {"Acosh", &interval_algebra::testAcosh},
+    {"Add", &interval_algebra::testAdd},
+    {"And", &interval_algebra::testAnd},
+    {"Asin", &interval_algebra::testAsin},
+    {"Asinh", &interval_algebra::testAsinh},
+    {"Atan", &interval_algebra::testAtan},
+    {"Atanh", &interval_algebra::testAtanh},
+    {"Ceil", &interval_algebra::testCeil},
+    {"Cos", &interval_algebra::testCos},
+    {"Cosh", &interval_algebra::testCosh},
+    {"Delay", &interval_algebra::testDelay},
+    {"Div", &interval_algebra::testDiv},
+    {"Eq", &interval_algebra::testEq},
+    {"Exp", &interval_algebra::testExp},
+    {"FloatCast", &interval_algebra::testFloatCast},
+    {"Floor", &interval_algebra::testFloor},
+    {"Ge", &interval_algebra::testGe},
+    {"Gt", &interval_algebra::testGt},
+    {"IntCast", &interval_algebra::testIntCast},
+    {"Inv", &interval_algebra::testInv},
+    {"Log", &interval_algebra::testLog},
+    {"Log10", &interval_algebra::testLog10},
+    {"Lsh", &interval_algebra::testLsh},
+    {"Lt", &interval_algebra::testLt},
+    {"Max", &interval_algebra::testMax},
+    {"Mem", &interval_algebra::testMem},
+    {"Min", &interval_algebra::testMin},
+    {"Mod", &interval_algebra::testMod},
+    {"Mul", &interval_algebra::testMul},
+    {"Ne", &interval_algebra::testNe},
+    {"Neg", &interval_algebra::testNeg},
+    {"Not", &interval_algebra::testNot},
+    {"NumEntry", &interval_algebra::testNumEntry},
+    {"Or", &interval_algebra::testOr},
+    {"Pow", &interval_algebra::testPow},
+    {"RdTbl", &interval_algebra::testRdTbl},
+    {"Rint", &interval_algebra::testRint},
+    {"Rsh", &interval_algebra::testRsh},
+    {"Select2", &interval_algebra::testSelect2},
+    {"Select3", &interval_algebra::testSelect3},
+    {"Sin", &interval_algebra::testSin},
+    {"Sinh", &interval_algebra::testSinh},
+    {"Soundfile", &interval_algebra::testSoundfile},
+    {"Sqrt", &interval_algebra::testSqrt},
+    {"Sub", &interval_algebra::testSub},
+    {"Tan", &interval_algebra::testTan},
+    {"Tanh", &interval_algebra::testTanh},
+    {"WrTbl", &interval_algebra::testWrTbl},
+    {"Xor", &interval_algebra::testXor},
+};
+
 void interval_algebra::testAll() const
 {
-    testAbs();
-    testAcos();
-    testAcosh();
-    testAdd();
-    testAnd();
-    testAsin();
-    testAsinh();
-    testAtan();
-    testAtanh();
-    testCeil();
-    testCos();
-    testCosh();
-    testDelay();
-    testDiv();
-    testEq();
-    testExp();
-    testFloatCast();
-    testFloor();
-    testGe();
-    testGt();
-    testIntCast();
-    testInv();
-    testLog();
-    testLog10();
-    testLsh();
-    testLt();
-    testMax();
-    testMem();
-    testMin();
-    testMod();
-    testMul();
-    testNe();
-    testNeg();
-    testNot();
-    testOr();
-    testPow();
-    testRint();
-    testRsh();
-    testSin();
-    testSinh();
-    testSqrt();
-    testSub();
-    testTan();
-    testTanh();
-    testXor();
+    for (const primitive_test& t : gPrimitiveTests) (this->*t.test)();
+}
+
+void interval_algebra::registerTests() const
+{
+    for (const primitive_test& t : gPrimitiveTests) {
+        registerTest(t.name, [A = *this, m = t.test]() { (A.*m)(); });
+    }
 }
 }  // namespace itv
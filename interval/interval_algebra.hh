@@ -7,10 +7,22 @@
 namespace itv {
 class interval_algebra : public faust_algebra<interval> {
    private:
+    int  fPrecision{-24};  ///< lsb of the results of the functions that are not exact (transcendental, Inv, Div)
+    bool fFloat32{false};  ///< FloatCast rounds to float32
+
     interval iPow(const interval& x, const interval& y) const;  // integer power, when x can be negative
+    interval zPow(const interval& x, int y) const;              // integer power of a single exponent
     interval fPow(const interval& x, const interval& y) const;  // float power, when x is positive
+    interval modulo(const interval& x, double m) const;           // Mod without the lsb of the result
+    interval modulo(const interval& x, const interval& y) const;  //
 
    public:
+    interval_algebra() = default;
+    explicit interval_algebra(int precision, bool float32 = false) : fPrecision(precision), fFloat32(float32) {}
+
+    int  precision() const { return fPrecision; }
+    bool isFloat32() const { return fFloat32; }
+
     // Injections of external values
     interval Label(const std::string& x) const;
     interval IntNum(int x) const;
@@ -25,6 +37,10 @@ class interval_algebra : public faust_algebra<interval> {
                      const interval& step) const;
     interval NumEntry(const interval& name, const interval& init, const interval& lo, const interval& hi,
                       const interval& step) const;
+    void     testNumEntry() const;
+
+    // Initial value of a user interface element, within its range and with its lsb
+    interval SliderInit(const interval& init, const interval& lo, const interval& hi, const interval& step) const;
 
     interval Abs(const interval& x) const;
     void     testAbs() const;
@@ -122,14 +138,29 @@ class interval_algebra : public faust_algebra<interval> {
     void     testOr() const;
     interval Pow(const interval& x, const interval& y) const;  // for all cases
     void     testPow() const;
+    interval RdTbl(const interval& tbl, const interval& index) const;
+    void     testRdTbl() const;
     interval Remainder(const interval& x) const;
     void     testRemainder() const;
     interval Rint(const interval& x) const;
     void     testRint() const;
     interval Rsh(const interval& x, const interval& y) const;
     void     testRsh() const;
+    interval Select2(const interval& s, const interval& x, const interval& y) const;
+    void     testSelect2() const;
+    interval Select3(const interval& s, const interval& x, const interval& y, const interval& z) const;
+    void     testSelect3() const;
+    unsigned selectBranches(const interval& s, int n) const;  // reachable branches of Select2/3, bit i for branch i
+
+    // the content summary of a table, computed once when the table is built
+    interval tableContent(const double* data, size_t n) const;
+    interval tableContent(const float* data, size_t n) const;
+    // the index of a table of size values never needs a bounds check or a mask
+    bool tableIndexSafe(const interval& index, int size) const;
     interval Sin(const interval& x) const;
     void     testSin() const;
+    interval Soundfile(const interval& index, int bits) const;  // samples of b bits (32/64 for float/double files)
+    void     testSoundfile() const;
     interval Sinh(const interval& x) const;
     void     testSinh() const;
     interval Sqrt(const interval& x) const;
@@ -138,9 +169,12 @@ class interval_algebra : public faust_algebra<interval> {
     void     testTan() const;
     interval Tanh(const interval& x) const;
     void     testTanh() const;
+    interval WrTbl(const interval& n, const interval& init, const interval& index, const interval& value) const;
+    void     testWrTbl() const;
     interval Xor(const interval& x, const interval& y) const;
     void     testXor() const;
 
     void testAll() const;
+    void registerTests() const;  // register the tests of all the methods, to be run by runTests()
 };
 }  // namespace itv
@@ -25,6 +25,8 @@
 #include <iostream>
 #include <limits>
 #include <algorithm>
+#include <climits>
+#include <cstdint>
 #include <string>
 
 // ***************************************************************************
@@ -43,12 +45,41 @@ inline int saturatedIntCast(double d)
     return int(std::min(2147483647.0, std::max(d, -2147483648.0)));
 }
 
+// finest lsb of a value, the lsb of the subnormal numbers
+constexpr int kMinLSB = -1074;
+
+/**
+ * The lsb of the last bit set in x: x is a multiple of 2^exactLSB(x).
+ * INT_MAX for 0 and the values that are not finite.
+ */
+inline int exactLSB(double x)
+{
+    if ((x == 0) || !std::isfinite(x)) return INT_MAX;
+    int      e;
+    uint64_t m = uint64_t(std::ldexp(std::fabs(std::frexp(x, &e)), 53));
+    int      z = 0;
+    while ((m & 1) == 0) {
+        m >>= 1;
+        z++;
+    }
+    return e - 53 + z;
+}
+
 class interval {
    private:
     double fLo{std::numeric_limits<double>::lowest()};  ///< minimal value
     double fHi{std::numeric_limits<double>::max()};     ///< maximal value
     int    fLSB{-24};                                   ///< lsb in bits
 
+    // truncate n to a multiple of u = 2^lsb. Infinities, and values too large to
+    // have a fractional part at this lsb, are already multiples of u.
+    static double truncate(double n, double u)
+    {
+        double q = n / u;
+        if (!std::isfinite(u) || (u <= 0) || !std::isfinite(q) || (std::abs(q) >= 0x1p53)) return n;
+        return u * (double)floor(q);
+    }
+
    public:
     //-------------------------------------------------------------------------
     // constructors
@@ -63,8 +94,8 @@ class interval {
             fHi = NAN;
         } else {
             double u = pow(2, lsb);
-            double n_trunc = u*(double)floor(n/u);
-            double m_trunc = u*(double)floor(m/u);
+            double n_trunc = truncate(n, u);
+            double m_trunc = truncate(m, u);
             fLo = std::min(n_trunc, m_trunc);
             fHi = std::max(n_trunc, m_trunc);
         }
@@ -90,16 +121,20 @@ class interval {
     bool isZero() const { return is(0.0); }
     bool isconst() const { return (fLo == fHi) && !std::isnan(fLo); }
 
+    // a single positive int 2^k
     bool ispowerof2() const
     {
+        if (!isconst() || !(fHi >= 1) || !(fHi <= INT_MAX) || (std::rint(fHi) != fHi)) return false;
         auto n = int(fHi);
-        return isconst() && ((n & (-n)) == n);
+        return (n & (-n)) == n;
     }
 
+    // a single int 2^k-1 (including 0)
     bool isbitmask() const
     {
+        if (!isconst() || !(fHi >= 0) || !(fHi < INT_MAX) || (std::rint(fHi) != fHi)) return false;
         int n = int(fHi) + 1;
-        return isconst() && ((n & (-n)) == n);
+        return (n & (-n)) == n;
     }
 
     double lo() const { return fLo; }
@@ -157,7 +192,7 @@ inline interval intersection(const interval& i, const interval& j)
         if (l > h) {
             return {};
         } else {
-            return {l, h};
+            return {l, h, std::min(i.lsb(), j.lsb())};
         }
     }
 }
@@ -171,7 +206,7 @@ inline interval reunion(const interval& i, const interval& j)
     } else {
         double l = std::min(i.lo(), j.lo());
         double h = std::max(i.hi(), j.hi());
-        return {l, h};
+        return {l, h, std::min(i.lsb(), j.lsb())};
     }
 }
 
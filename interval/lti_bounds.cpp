@@ -0,0 +1,486 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "check.hh"
+#include "interval_algebra.hh"
+#include "interval_def.hh"
+#include "lti_bounds.hh"
+#include "signal_graph.hh"
+
+namespace itv {
+
+//------------------------------------------------------------------------------------------
+// the loops
+
+using I = interval_algebra;
+
+// the strongly connected components of a graph (Kosaraju), deps are the arguments of the nodes and users their
+// uses: comp[i] is the first node of the component of i found by the second search
+static std::vector<int> components(const std::vector<std::vector<int>>& deps,
+                                   const std::vector<std::vector<int>>& users)
+{
+    size_t                           n = deps.size();
+    std::vector<int>                 order;  // the nodes in post order of a search along deps
+    std::vector<bool>                seen(n, false);
+    std::vector<std::pair<int, int>> stack;  // node and next argument to visit
+    for (size_t s = 0; s < n; s++) {
+        if (seen[s]) continue;
+        seen[s] = true;
+        stack.emplace_back(int(s), 0);
+        while (!stack.empty()) {
+            auto& [i, a] = stack.back();
+            if (a < int(deps[i].size())) {
+                int j = deps[i][a++];
+                if (!seen[j]) {
+                    seen[j] = true;
+                    stack.emplace_back(j, 0);
+                }
+            } else {
+                order.push_back(i);
+                stack.pop_back();
+            }
+        }
+    }
+    std::vector<int> comp(n, -1);
+    std::vector<int> todo;
+    for (auto s = order.rbegin(); s != order.rend(); ++s) {
+        if (comp[*s] >= 0) continue;
+        comp[*s] = *s;
+        todo.push_back(*s);
+        while (!todo.empty()) {
+            int i = todo.back();
+            todo.pop_back();
+            for (int j : users[i]) {
+                if (comp[j] < 0) {
+                    comp[j] = *s;
+                    todo.push_back(j);
+                }
+            }
+        }
+    }
+    return comp;
+}
+
+static bool isConstant(const signal_graph& g, int i)
+{
+    return g[i].type == signal_graph::kind::constant;
+}
+
+// the delay of node i of a loop: 1 for feedback and Mem, d for Delay, 0 otherwise
+static int delayOf(const signal_graph& g, int i)
+{
+    const signal_graph::node& n = g[i];
+    if ((n.type == signal_graph::kind::feedback) || ((n.type == signal_graph::kind::unary) && (n.u == &I::Mem))) {
+        return 1;
+    }
+    if ((n.type == signal_graph::kind::binary) && (n.b == &I::Delay)) return int(g[n.y].value);
+    return 0;
+}
+
+static bool isLTI(const signal_graph& g, int i)
+{
+    const signal_graph::node& n = g[i];
+    switch (n.type) {
+        case signal_graph::kind::feedback: return true;
+        case signal_graph::kind::unary: return (n.u == &I::Neg) || (n.u == &I::Mem);
+        case signal_graph::kind::binary:
+            if ((n.b == &I::Add) || (n.b == &I::Sub)) return true;
+            if (n.b == &I::Mul) return isConstant(g, n.x) || isConstant(g, n.y);
+            if (n.b == &I::Delay) {
+                double d = g[n.y].value;
+                return isConstant(g, n.y) && (d >= 0) && (d <= kMaxImpulse) && (std::rint(d) == d);
+            }
+            return false;
+        default: return false;
+    }
+}
+
+//------------------------------------------------------------------------------------------
+// simulation of the impulse responses
+
+// The state of a loop is the values of its nodes still read by its delays: the cells (k, d) for 1 <= d <= lags[k],
+// the value of nodes[k] d samples ago. Once the entries are 0, the state evolves by s(t+1) = A*s(t) and the nodes
+// are C*s(t), for the state matrix A and output matrix C of the loop.
+class lti_sim {
+    const signal_graph&              g;
+    const lti_loop&                  l;
+    std::vector<int>                 local;  // index in l.nodes of each node of g, -1 outside of the loop
+    std::vector<int>                 lags;   // lags[k]: largest delay of l.nodes[k] read in the loop
+    std::vector<std::pair<int, int>> cells;  // the cells (k, d) of the state
+    std::vector<std::vector<double>> h;      // h[k][d-1]: value of l.nodes[k] at time -d, the initial state
+    std::vector<std::vector<double>> v;      // v[k][t]: value of l.nodes[k] at time t
+
+   public:
+    lti_sim(const signal_graph& graph, const lti_loop& loop)
+        : g(graph),
+          l(loop),
+          local(size_t(graph.size()), -1),
+          lags(loop.nodes.size(), 0),
+          h(loop.nodes.size()),
+          v(loop.nodes.size())
+    {
+        for (size_t k = 0; k < l.nodes.size(); k++) local[l.nodes[k]] = int(k);
+        for (int i : l.nodes) {
+            int d = delayOf(g, i);
+            if ((d > 0) && (local[g[i].x] >= 0)) lags[local[g[i].x]] = std::max(lags[local[g[i].x]], d);
+        }
+        for (size_t k = 0; k < l.nodes.size(); k++) {
+            for (int d = 1; d <= lags[k]; d++) cells.emplace_back(int(k), d);
+        }
+    }
+
+    int size() const { return int(cells.size()); }
+
+    void reset()
+    {
+        for (auto& x : v) x.clear();
+        for (auto& x : h) x.clear();
+    }
+
+    // the initial state: 1 in cell c, 0 elsewhere
+    void unitState(int c)
+    {
+        reset();
+        auto [k, d] = cells[c];
+        h[k].assign(size_t(d), 0);
+        h[k][d - 1] = 1;
+    }
+
+    // value of node i at time t, for an impulse on entry e at time 0
+    double value(int i, int t, int e) const
+    {
+        int k = local[i];
+        if (t < 0) return ((k >= 0) && (-t <= int(h[k].size()))) ? h[k][-t - 1] : 0;
+        if (k >= 0) return v[k][t];
+        return ((i == e) && (t == 0)) ? 1 : 0;
+    }
+
+    // computes the values of time t = v[.].size(), the feedback nodes are set to state when it isn't NAN
+    void step(int e, double state = NAN)
+    {
+        int t = int(v[0].size());
+        for (size_t k = 0; k < l.nodes.size(); k++) {
+            const signal_graph::node& n = g[l.nodes[k]];
+            double                    r = 0;
+            if (n.type == signal_graph::kind::feedback) {
+                r = std::isnan(state) ? value(n.x, t - 1, e) : state;
+            } else if (n.type == signal_graph::kind::unary) {
+                r = (n.u == &I::Neg) ? -value(n.x, t, e) : value(n.x, t - 1, e);  // Neg or Mem
+            } else if (n.b == &I::Add) {
+                r = value(n.x, t, e) + value(n.y, t, e);
+            } else if (n.b == &I::Sub) {
+                r = value(n.x, t, e) - value(n.y, t, e);
+            } else if (n.b == &I::Mul) {
+                r = isConstant(g, n.x) ? g[n.x].value * value(n.y, t, e) : value(n.x, t, e) * g[n.y].value;
+            } else {
+                r = value(n.x, t - int(g[n.y].value), e);  // Delay
+            }
+            v[k].push_back(r);
+        }
+    }
+
+    double at(size_t k, int t) const { return v[k][t]; }
+
+    // the cell c of the state of time t
+    double cell(int c, int t) const { return value(l.nodes[cells[c].first], t - cells[c].second, -1); }
+
+    // the infinity norm of the state of time t
+    double stateNorm(int t) const
+    {
+        double m = 0;
+        for (int c = 0; c < size(); c++) m = std::max(m, std::fabs(cell(c, t)));
+        return m;
+    }
+};
+
+static void accumulate(double h, double& p, double& n)
+{
+    if (h > 0) p += h;
+    if (h < 0) n -= h;
+}
+
+// the closed form of a loop with a single delay: after the first sample, the nodes are c[k]*s(t) with s(t+1) = a*s(t)
+static bool firstOrderResponse(const signal_graph& g, lti_loop& l, lti_sim& sim, int j)
+{
+    int f = 0;  // the feedback node
+    while (g[l.nodes[f]].type != signal_graph::kind::feedback) f++;
+    int src = int(std::find(l.nodes.begin(), l.nodes.end(), g[l.nodes[f]].x) - l.nodes.begin());
+
+    sim.reset();
+    sim.step(-1, 1.0);  // the response to a unit state
+    double a = sim.at(src, 0);
+    if (!(std::fabs(a) < 1)) return false;
+    std::vector<double> c(l.nodes.size());
+    for (size_t k = 0; k < l.nodes.size(); k++) c[k] = sim.at(k, 0);
+
+    sim.reset();
+    sim.step(l.entries[j]);  // the first sample of the impulse response
+    double s1 = sim.at(src, 0);
+    for (size_t k = 0; k < l.nodes.size(); k++) {
+        double& p = l.P[k][j];
+        double& n = l.N[k][j];
+        accumulate(sim.at(k, 0), p, n);
+        double m = c[k] * s1;  // the terms m*a^(t-1) for t >= 1
+        if (a >= 0) {
+            accumulate(m / (1 - a), p, n);
+        } else {
+            accumulate(m / (1 - a * a), p, n);       // even powers of a
+            accumulate(m * a / (1 - a * a), p, n);  // odd powers of a
+        }
+    }
+    return true;
+}
+
+// the state matrix A is contracting: rho = ||A^m|| < 1 for the infinity norm, computed from the responses to the
+// unit states, whose first samples also give the L1 norms C[k] of the rows of the output matrix
+struct lti_contraction {
+    int                 m{0};
+    double              rho{HUGE_VAL};
+    std::vector<double> C;
+};
+
+static bool contraction(const signal_graph& g, const lti_loop& l, lti_contraction& r)
+{
+    lti_sim base(g, l);
+    double  n    = base.size();
+    double  cost = n * (n + double(l.nodes.size()));  // per sample
+    if (cost * 2 > kMaxStateWork) return false;
+
+    std::vector<lti_sim> sims(size_t(n), base);
+    for (int c = 0; c < int(n); c++) sims[c].unitState(c);
+    r.C.assign(l.nodes.size(), 0);
+    int samples = int(std::min(double(kMaxImpulse), kMaxStateWork / cost));
+    for (int t = 1; (t <= samples) && (r.rho > 0.5); t++) {
+        for (auto& s : sims) s.step(-1);
+        if (t == 1) {
+            for (size_t k = 0; k < l.nodes.size(); k++) {
+                for (const auto& s : sims) r.C[k] += std::fabs(s.at(k, 0));
+            }
+        }
+        double a = 0;  // ||A^t||, the largest L1 norm of its rows
+        for (int c = 0; c < int(n); c++) {
+            double row = 0;
+            for (const auto& s : sims) row += std::fabs(s.cell(c, t));
+            a = std::max(a, row);
+        }
+        if (!std::isfinite(a)) break;  // diverging
+        if (a < r.rho) {
+            r.rho = a;
+            r.m   = t;
+        }
+    }
+    return r.rho < 1;
+}
+
+// the impulse response, by windows of m samples: once the entries are 0, the sum of |C[k]*s(t)| for t >= T is at
+// most C[k] * (||s(T)|| + ... + ||s(T+m-1)||) / (1-rho), the tail of the response summed in closed form, with both
+// signs, when it is negligible
+static void stateResponse(lti_loop& l, lti_sim& sim, int j, const lti_contraction& a)
+{
+    sim.reset();
+    for (int T = 0;; T += a.m) {
+        std::vector<double> p(l.nodes.size(), 0), n(l.nodes.size(), 0);
+        double              S = 0;
+        for (int t = T; t < T + a.m; t++) {
+            sim.step(l.entries[j]);
+            for (size_t k = 0; k < l.nodes.size(); k++) accumulate(sim.at(k, t), p[k], n[k]);
+            S += sim.stateNorm(t);
+        }
+        double tail = 0, total = 0;
+        for (size_t k = 0; k < l.nodes.size(); k++) {
+            tail  = std::max(tail, a.C[k] * S / (1 - a.rho));
+            total = std::max(total, l.P[k][j] + l.N[k][j] + p[k] + n[k]);
+        }
+        if ((T > 0) && ((tail <= 1e-12 * total) || (T + 2 * a.m > kMaxImpulse))) {
+            for (size_t k = 0; k < l.nodes.size(); k++) {
+                l.P[k][j] += a.C[k] * S / (1 - a.rho);
+                l.N[k][j] += a.C[k] * S / (1 - a.rho);
+            }
+            return;
+        }
+        for (size_t k = 0; k < l.nodes.size(); k++) {
+            l.P[k][j] += p[k];
+            l.N[k][j] += n[k];
+        }
+    }
+}
+
+std::vector<lti_loop> ltiLoops(const signal_graph& g)
+{
+    int                           n = g.size();
+    std::vector<std::vector<int>> deps(n), users(n);
+    for (int i = 0; i < n; i++) {
+        for (int a : {g[i].x, g[i].y}) {
+            if (a < 0) continue;
+            deps[i].push_back(a);
+            users[a].push_back(i);
+        }
+    }
+
+    std::vector<int>              comp = components(deps, users);
+    std::vector<std::vector<int>> members(n);  // the nodes of each component, in increasing order
+    for (int i = 0; i < n; i++) members[comp[i]].push_back(i);
+
+    std::vector<lti_loop> loops;
+    std::vector<bool>     done(n, false);
+    for (int f = 0; f < n; f++) {
+        if ((g[f].type != signal_graph::kind::feedback) || done[comp[f]] || (g[f].x < 0)) continue;
+        done[comp[f]] = true;
+        lti_loop l;
+        l.nodes  = members[comp[f]];
+        bool lti = true;
+        for (int i : l.nodes) lti = lti && isLTI(g, i);
+        if (!std::binary_search(l.nodes.begin(), l.nodes.end(), g[f].x)) continue;  // not closed on itself
+        if (!lti) continue;
+        for (int i : l.nodes) {
+            for (int a : deps[i]) {
+                bool inside = std::binary_search(l.nodes.begin(), l.nodes.end(), a);
+                bool gain   = (g[i].type == signal_graph::kind::binary) &&
+                            ((g[i].b == &I::Delay) ? (a == g[i].y) : ((g[i].b == &I::Mul) && isConstant(g, a)));
+                if (!inside && !gain && (std::find(l.entries.begin(), l.entries.end(), a) == l.entries.end())) {
+                    l.entries.push_back(a);
+                }
+            }
+        }
+
+        int delays = 0;
+        for (int i : l.nodes) delays += delayOf(g, i);
+        l.firstOrder = delays == 1;
+        l.P.assign(l.nodes.size(), std::vector<double>(l.entries.size(), 0));
+        l.N = l.P;
+        lti_sim        sim(g, l);
+        lti_contraction a;
+        l.stable = l.firstOrder || contraction(g, l, a);
+        for (size_t j = 0; (j < l.entries.size()) && l.stable; j++) {
+            if (l.firstOrder) {
+                l.stable = firstOrderResponse(g, l, sim, int(j));
+            } else {
+                stateResponse(l, sim, int(j), a);
+            }
+        }
+        loops.push_back(l);
+    }
+    return loops;
+}
+
+interval ltiBound(const lti_loop& l, int k, const std::vector<interval>& R)
+{
+    double lo = 0, hi = 0;
+    for (size_t j = 0; j < l.entries.size(); j++) {
+        const interval& e = R[l.entries[j]];
+        if (e.isEmpty()) return {NAN, NAN};
+        double a = std::min(e.lo(), 0.0), b = std::max(e.hi(), 0.0);  // the entries are 0 before the first sample
+        double p = l.P[k][j], n = l.N[k][j];
+        if (p > 0) {
+            lo += p * a;
+            hi += p * b;
+        }
+        if (n > 0) {
+            lo -= n * b;
+            hi -= n * a;
+        }
+    }
+    return {lo, hi, kMinLSB};
+}
+
+//------------------------------------------------------------------------------------------
+// tests
+
+void testLTIBounds()
+{
+    // a one-pole smoother y = 0.1*x + 0.9*y'
+    signal_graph g;
+    int          x = g.input(interval(-1, 1, -24));
+    int          f = g.feedback();
+    int          y = g.binary(&I::Add, g.binary(&I::Mul, x, g.constant(0.1)), g.binary(&I::Mul, f, g.constant(0.9)));
+    g.loop(f, y);
+
+    int                   iterations = 0;
+    std::vector<interval> R          = g.ranges(I(), &iterations);
+    testout() << "smoother " << R[y] << " in " << iterations << " iterations\n";
+    check("test lti smoother", (R[y].lo() >= -1 - 1e-9) && (R[y].hi() <= 1 + 1e-9) && (R[y].hi() >= 1 - 1e-9), true);
+    check("test lti smoother iterations", iterations <= 2, true);
+
+    std::vector<lti_loop> L = ltiLoops(g);
+    check("test lti first order", (L.size() == 1) && L[0].firstOrder && L[0].stable, true);
+
+    // an alternating loop y = x - 0.5*y': |h| sums to 2, the positive terms to 4/3
+    signal_graph a;
+    int          ax = a.input(interval(0, 1, -24));
+    int          af = a.feedback();
+    int          ay = a.binary(&I::Sub, ax, a.binary(&I::Mul, a.constant(0.5), af));
+    a.loop(af, ay);
+    R = a.ranges(I());
+    check("test lti alternating", (std::fabs(R[ay].hi() - 4.0 / 3) < 1e-9) && (std::fabs(R[ay].lo() + 2.0 / 3) < 1e-9),
+          true);
+
+    // a biquad y = x + 1.8*y' - 0.9*y'' (poles of radius 0.95)
+    signal_graph b;
+    int          bx = b.input(interval(-1, 1, -24));
+    int          f1 = b.feedback();
+    int          f2 = b.unary(&I::Mem, f1);
+    int by = b.binary(&I::Sub, b.binary(&I::Add, bx, b.binary(&I::Mul, b.constant(1.8), f1)),
+                      b.binary(&I::Mul, b.constant(0.9), f2));
+    b.loop(f1, by);
+    R = b.ranges(I(), &iterations);
+    L = ltiLoops(b);
+    testout() << "biquad " << R[by] << " in " << iterations << " iterations, L1 norm "
+              << L[0].P.back()[0] + L[0].N.back()[0] << '\n';
+    check("test lti biquad", R[by].isBounded() && (R[by].hi() > 10) && (R[by].hi() < 100) && !L[0].firstOrder, true);
+    check("test lti biquad iterations", iterations <= 2, true);
+
+    // a comb y = x + 0.7*delay(y,99), whose impulse response sums to 1/0.3
+    signal_graph c;
+    int          cx = c.input(interval(-1, 1, -24));
+    int          cf = c.feedback();
+    int          cd = c.binary(&I::Delay, cf, c.constant(99));
+    int          cy = c.binary(&I::Add, cx, c.binary(&I::Mul, c.constant(0.7), cd));
+    c.loop(cf, cy);
+    R = c.ranges(I());
+    testout() << "comb " << R[cy] << '\n';
+    check("test lti comb", (R[cy].hi() >= 1 / 0.3) && (R[cy].hi() < 1.001 / 0.3), true);
+
+    // a resonator y = x + 1.9*y' - y'' (poles of radius 1) and a biquad with poles of radius 1.05 are not contracting
+    for (double r2 : {1.0, 1.05 * 1.05}) {
+        signal_graph o;
+        int          of1 = o.feedback();
+        int          of2 = o.unary(&I::Mem, of1);
+        int          ox  = o.binary(&I::Add, o.input(interval(-1, 1, -24)), o.binary(&I::Mul, o.constant(1.9), of1));
+        int          oy  = o.binary(&I::Sub, ox, o.binary(&I::Mul, o.constant(r2), of2));
+        o.loop(of1, oy);
+        L = ltiLoops(o);
+        check("test lti unstable biquad", (L.size() == 1) && !L[0].stable && (o.ranges(I())[oy].hi() == HUGE_VAL),
+              true);
+    }
+
+    // unstable and non linear loops are left to the widening
+    signal_graph u;
+    int          uf = u.feedback();
+    int          uy = u.binary(&I::Add, u.input(interval(0, 1, -24)), u.binary(&I::Mul, u.constant(1.5), uf));
+    u.loop(uf, uy);
+    L = ltiLoops(u);
+    check("test lti unstable", (L.size() == 1) && !L[0].stable && (u.ranges(I())[uy].hi() == HUGE_VAL), true);
+
+    signal_graph s;
+    int          sf = s.feedback();
+    int          sy = s.unary(&I::Sin, s.binary(&I::Add, s.input(interval(0, 1, -24)), sf));
+    s.loop(sf, sy);
+    check("test lti non linear", ltiLoops(s).empty(), true);
+}
+
+}  // namespace itv
@@ -0,0 +1,72 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <vector>
+
+#include "check.hh"
+#include "interval_def.hh"
+#include "signal_graph.hh"
+
+namespace itv {
+
+//==============================================================================
+// Closed form bounds of the linear time-invariant loops of a signal graph.
+//
+// A loop is the strongly connected component of a feedback node. It is LTI
+// when its nodes are feedback nodes, Add, Sub, Neg, Mul by a constant node,
+// Mem and Delay by a constant node: one-pole smoothers, biquads, combs and
+// allpass networks. Its entries are the arguments of its nodes taken outside
+// of it, and every node of the loop is the sum of the convolutions of the
+// entries with its impulse responses h.
+//
+// A node is bounded by the sum, over the entries, of P*[lo,hi] - N*[lo,hi]
+// where P and N are the sums of the positive and negative terms of h (the
+// L1 norm of h is P+N) and [lo,hi] is the range of the entry extended to 0,
+// the value of the entries before the first sample. The bounds are finite for
+// the stable loops and don't depend on the fixpoint iterations.
+//
+// The loops with a single delay (one feedback node, no Mem or Delay) have a
+// geometric impulse response after the first sample: P and N are computed in
+// closed form from the gain of the loop. The other loops are stable when a
+// power A^m of their state matrix (the values still read by their delays) is
+// proven contracting, ||A^m|| < 1, from the responses to the unit states. Their
+// impulse responses are simulated until the tail bounded by the geometric
+// series of ||A^m|| is negligible, it is then added with both signs. Both bounds
+// are sound up to the rounding of the simulation. The loops with a state too
+// large to be checked within kMaxStateWork operations are left to the widening
+// of the fixpoint, like the unstable ones.
+//==============================================================================
+
+constexpr int    kMaxImpulse   = 1 << 20;
+constexpr double kMaxStateWork = 1 << 22;
+
+struct lti_loop {
+    std::vector<int>                 nodes;    ///< nodes of the loop, in increasing order
+    std::vector<int>                 entries;  ///< nodes outside of the loop used by it
+    std::vector<std::vector<double>> P, N;     ///< P[k][j], N[k][j]: response of nodes[k] to entries[j]
+    bool                             firstOrder{false};
+    bool                             stable{false};
+};
+
+// the LTI loops of g, with the impulse responses of their nodes
+std::vector<lti_loop> ltiLoops(const signal_graph& g);
+
+// the bound of nodes[k] of a stable loop, for the ranges R of its entries
+interval ltiBound(const lti_loop& l, int k, const std::vector<interval>& R);
+
+void testLTIBounds();
+
+}  // namespace itv
@@ -0,0 +1,128 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <type_traits>
+
+#include "interval_def.hh"
+
+// ***************************************************************************
+//
+//     A multi_interval is a union of at most kMultiPieces disjoint intervals,
+//     sorted in increasing order and stored inline. It keeps 1/[-1,1] as
+//     ]-inf,-1] U [1,+inf[ instead of ]-inf,+inf[. When a union has more
+//     pieces, the pieces separated by the smallest gaps are merged.
+//
+//****************************************************************************
+namespace itv {
+
+constexpr int kMultiPieces = 4;
+
+class multi_interval {
+   private:
+    std::array<interval, kMultiPieces> fPieces;
+    int                                fCount{0};
+
+   public:
+    multi_interval() = default;  // empty
+
+    explicit multi_interval(const interval& x)
+    {
+        if (!x.isEmpty()) fPieces[fCount++] = x;
+    }
+
+    /**
+     * @brief The normalized union of the intervals p[0..n[: the empty ones are removed,
+     * the others are sorted and merged when they overlap, then while there are more than
+     * kMultiPieces the two closest pieces are merged. The array p is used as work space.
+     */
+    static multi_interval fromPieces(interval* p, int n)
+    {
+        n = int(std::remove_if(p, p + n, [](const interval& x) { return x.isEmpty(); }) - p);
+        std::sort(p, p + n, [](const interval& a, const interval& b) { return a.lo() < b.lo(); });
+
+        auto merge = [](const interval& a, const interval& b) {
+            return interval(std::min(a.lo(), b.lo()), std::max(a.hi(), b.hi()), std::min(a.lsb(), b.lsb()));
+        };
+        int m = 0;
+        for (int i = 0; i < n; i++) {
+            if ((m > 0) && (p[i].lo() <= p[m - 1].hi())) {
+                p[m - 1] = merge(p[m - 1], p[i]);
+            } else {
+                p[m++] = p[i];
+            }
+        }
+        while (m > kMultiPieces) {
+            int k = 0;  // the gap between p[k] and p[k+1] is the smallest
+            for (int i = 1; i < m - 1; i++) {
+                if (p[i + 1].lo() - p[i].hi() < p[k + 1].lo() - p[k].hi()) k = i;
+            }
+            p[k] = merge(p[k], p[k + 1]);
+            std::copy(p + k + 2, p + m, p + k + 1);
+            m--;
+        }
+
+        multi_interval r;
+        std::copy(p, p + m, r.fPieces.begin());
+        r.fCount = m;
+        return r;
+    }
+
+    int             count() const { return fCount; }
+    const interval& operator[](int i) const { return fPieces[i]; }
+    const interval* begin() const { return fPieces.data(); }
+    const interval* end() const { return fPieces.data() + fCount; }
+
+    bool isEmpty() const { return fCount == 0; }
+    bool has(double x) const
+    {
+        return std::any_of(begin(), end(), [x](const interval& p) { return p.has(x); });
+    }
+
+    // the smallest interval containing all the pieces
+    interval hull() const
+    {
+        if (fCount == 0) return {NAN, NAN};
+        int lsb = fPieces[0].lsb();
+        for (int i = 1; i < fCount; i++) lsb = std::min(lsb, fPieces[i].lsb());
+        return {fPieces[0].lo(), fPieces[fCount - 1].hi(), lsb};
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<multi_interval>, "multi_interval must not allocate");
+
+inline std::ostream& operator<<(std::ostream& dst, const multi_interval& x)
+{
+    if (x.isEmpty()) return dst << "multi_interval()";
+    dst << "multi_interval(";
+    for (int i = 0; i < x.count(); i++) dst << ((i > 0) ? " U [" : "[") << x[i].lo() << ',' << x[i].hi() << ']';
+    return dst << ')';
+}
+
+inline bool operator==(const multi_interval& x, const multi_interval& y)
+{
+    return std::equal(x.begin(), x.end(), y.begin(), y.end());
+}
+
+inline bool operator!=(const multi_interval& x, const multi_interval& y)
+{
+    return !(x == y);
+}
+
+}  // namespace itv
@@ -0,0 +1,511 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <initializer_list>
+#include <sstream>
+#include <string>
+
+#include "check.hh"
+#include "multi_interval.hh"
+#include "multi_interval_algebra.hh"
+
+namespace itv {
+
+// work space for the pieces of a result, before their normalization: at most
+// two pieces for each pair of pieces of the arguments
+using piece_buffer = std::array<interval, 2 * kMultiPieces * kMultiPieces>;
+
+// [lo,hi] on the lsb grid, hi is rounded up instead of down
+static interval outward(double lo, double hi, int lsb)
+{
+    interval x(lo, hi, lsb);
+    return (x.hi() < hi) ? interval(x.lo(), hi + std::ldexp(1.0, x.lsb()), x.lsb()) : x;
+}
+
+multi_interval multi_interval_algebra::map(umth m, const multi_interval& x) const
+{
+    piece_buffer p;
+    int          n = 0;
+    for (const auto& a : x) p[n++] = (fAlgebra.*m)(a);
+    return multi_interval::fromPieces(p.data(), n);
+}
+
+multi_interval multi_interval_algebra::map(bmth m, const multi_interval& x, const multi_interval& y) const
+{
+    piece_buffer p;
+    int          n = 0;
+    for (const auto& a : x) {
+        for (const auto& b : y) p[n++] = (fAlgebra.*m)(a, b);
+    }
+    return multi_interval::fromPieces(p.data(), n);
+}
+
+//------------------------------------------------------------------------------------------
+// methods splitting the pieces
+
+multi_interval multi_interval_algebra::Inv(const multi_interval& x) const
+{
+    piece_buffer p;
+    int          n = 0;
+    for (const auto& a : x) {
+        if ((a.lo() < 0) && (a.hi() > 0)) {
+            // 1/[lo,hi] = ]-inf,1/lo] U [1/hi,+inf[, at the precision of the algebra like interval_algebra::Inv
+            p[n++] = outward(-HUGE_VAL, 1 / a.lo(), fAlgebra.precision());
+            p[n++] = interval(1 / a.hi(), HUGE_VAL, fAlgebra.precision());
+        } else {
+            p[n++] = fAlgebra.Inv(a);
+        }
+    }
+    return multi_interval::fromPieces(p.data(), n);
+}
+
+multi_interval multi_interval_algebra::Div(const multi_interval& x, const multi_interval& y) const
+{
+    return Mul(x, Inv(y));
+}
+
+multi_interval multi_interval_algebra::Tan(const multi_interval& x) const
+{
+    piece_buffer p;
+    int          n = 0;
+    for (const auto& a : x) {
+        if (!(a.size() < M_PI)) return multi_interval(interval(-HUGE_VAL, HUGE_VAL));
+        // the first pole pi/2 + k.pi above a.lo(), there is at most one in a
+        double pole = M_PI_2 + std::ceil((a.lo() - M_PI_2) / M_PI) * M_PI;
+        if (pole > a.hi()) {
+            p[n++] = fAlgebra.Tan(a);
+        } else {
+            p[n++] = interval(std::tan(a.lo()), HUGE_VAL, fAlgebra.precision());
+            p[n++] = outward(-HUGE_VAL, std::tan(a.hi()), fAlgebra.precision());
+        }
+    }
+    return multi_interval::fromPieces(p.data(), n);
+}
+
+// x % m for x >= 0: a piece narrower than |m| containing a multiple k of m gives
+// [x.lo % m, |m|[ U [0, x.hi % m] instead of [0, |m|[
+static int modPieces(const interval_algebra& A, const interval& x, const interval& y, interval* p)
+{
+    double m = std::fabs(y.lo());
+    if (y.isconst() && (m > 0) && (x.size() < m)) {
+        double k = std::floor(x.hi() / m) * m;
+        if ((k > x.lo()) && std::isfinite(k)) {
+            p[0] = A.Mod(interval(x.lo(), std::nextafter(k, 0.0), x.lsb()), y);
+            p[1] = A.Mod(interval(k, x.hi(), x.lsb()), y);
+            return 2;
+        }
+    }
+    p[0] = A.Mod(x, y);
+    return 1;
+}
+
+multi_interval multi_interval_algebra::Mod(const multi_interval& x, const multi_interval& y) const
+{
+    piece_buffer p;
+    int          n = 0;
+    for (const auto& a : x) {
+        for (const auto& b : y) {
+            if (a.lo() >= 0) {
+                n += modPieces(fAlgebra, a, b, &p[n]);
+            } else if (a.hi() <= 0) {
+                // the remainder has the sign of x
+                int k = modPieces(fAlgebra, fAlgebra.Neg(a), b, &p[n]);
+                for (int i = n; i < n + k; i++) p[i] = fAlgebra.Neg(p[i]);
+                n += k;
+            } else {
+                p[n++] = fAlgebra.Mod(a, b);
+            }
+        }
+    }
+    return multi_interval::fromPieces(p.data(), n);
+}
+
+//------------------------------------------------------------------------------------------
+// methods computed piece by piece
+
+multi_interval multi_interval_algebra::Label(const std::string& x) const
+{
+    return multi_interval(fAlgebra.Label(x));
+}
+
+multi_interval multi_interval_algebra::IntNum(int x) const
+{
+    return multi_interval(fAlgebra.IntNum(x));
+}
+
+multi_interval multi_interval_algebra::FloatNum(double x) const
+{
+    return multi_interval(fAlgebra.FloatNum(x));
+}
+
+multi_interval multi_interval_algebra::Button(const multi_interval& name) const
+{
+    return multi_interval(fAlgebra.Button(name.hull()));
+}
+
+multi_interval multi_interval_algebra::Checkbox(const multi_interval& name) const
+{
+    return multi_interval(fAlgebra.Checkbox(name.hull()));
+}
+
+multi_interval multi_interval_algebra::VSlider(const multi_interval& name, const multi_interval& init,
+                                               const multi_interval& lo, const multi_interval& hi,
+                                               const multi_interval& step) const
+{
+    return multi_interval(fAlgebra.VSlider(name.hull(), init.hull(), lo.hull(), hi.hull(), step.hull()));
+}
+
+multi_interval multi_interval_algebra::HSlider(const multi_interval& name, const multi_interval& init,
+                                               const multi_interval& lo, const multi_interval& hi,
+                                               const multi_interval& step) const
+{
+    return multi_interval(fAlgebra.HSlider(name.hull(), init.hull(), lo.hull(), hi.hull(), step.hull()));
+}
+
+multi_interval multi_interval_algebra::NumEntry(const multi_interval& name, const multi_interval& init,
+                                                const multi_interval& lo, const multi_interval& hi,
+                                                const multi_interval& step) const
+{
+    return multi_interval(fAlgebra.NumEntry(name.hull(), init.hull(), lo.hull(), hi.hull(), step.hull()));
+}
+
+multi_interval multi_interval_algebra::Abs(const multi_interval& x) const
+{
+    return map(&interval_algebra::Abs, x);
+}
+
+multi_interval multi_interval_algebra::Add(const multi_interval& x, const multi_interval& y) const
+{
+    return map(&interval_algebra::Add, x, y);
+}
+
+multi_interval multi_interval_algebra::Sub(const multi_interval& x, const multi_interval& y) const
+{
+    return map(&interval_algebra::Sub, x, y);
+}
+
+multi_interval multi_interval_algebra::Mul(const multi_interval& x, const multi_interval& y) const
+{
+    return map(&interval_algebra::Mul, x, y);
+}
+
+multi_interval multi_interval_algebra::Neg(const multi_interval& x) const
+{
+    return map(&interval_algebra::Neg, x);
+}
+
+multi_interval multi_interval_algebra::Acos(const multi_interval& x) const
+{
+    return map(&interval_algebra::Acos, x);
+}
+
+multi_interval multi_interval_algebra::Acosh(const multi_interval& x) const
+{
+    return map(&interval_algebra::Acosh, x);
+}
+
+multi_interval multi_interval_algebra::And(const multi_interval& x, const multi_interval& y) const
+{
+    return map(&interval_algebra::And, x, y);
+}
+
+multi_interval multi_interval_algebra::Asin(const multi_interval& x) const
+{
+    return map(&interval_algebra::Asin, x);
+}
+
+multi_interval multi_interval_algebra::Asinh(const multi_interval& x) const
+{
+    return map(&interval_algebra::Asinh, x);
+}
+
+multi_interval multi_interval_algebra::Atan(const multi_interval& x) const
+{
+    return map(&interval_algebra::Atan, x);
+}
+
+multi_interval multi_interval_algebra::Atan2(const multi_interval& x, const multi_interval& y) const
+{
+    return map(&interval_algebra::Atan2, x, y);
+}
+
+multi_interval multi_interval_algebra::Atanh(const multi_interval& x) const
+{
+    return map(&interval_algebra::Atanh, x);
+}
+
+multi_interval multi_interval_algebra::Ceil(const multi_interval& x) const
+{
+    return map(&interval_algebra::Ceil, x);
+}
+
+multi_interval multi_interval_algebra::Cos(const multi_interval& x) const
+{
+    return map(&interval_algebra::Cos, x);
+}
+
+multi_interval multi_interval_algebra::Cosh(const multi_interval& x) const
+{
+    return map(&interval_algebra::Cosh, x);
+}
+
+multi_interval multi_interval_algebra::Delay(const multi_interval& x, const multi_interval& y) const
+{
+    return map(&interval_algebra::Delay, x, y);
+}
+
+multi_interval multi_interval_algebra::Eq(const multi_interval& x, const multi_interval& y) const
+{
+    return map(&interval_algebra::Eq, x, y);
+}
+
+multi_interval multi_interval_algebra::Exp(const multi_interval& x) const
+{
+    return map(&interval_algebra::Exp, x);
+}
+
+multi_interval multi_interval_algebra::FloatCast(const multi_interval& x) const
+{
+    return map(&interval_algebra::FloatCast, x);
+}
+
+multi_interval multi_interval_algebra::Floor(const multi_interval& x) const
+{
+    return map(&interval_algebra::Floor, x);
+}
+
+multi_interval multi_interval_algebra::Ge(const multi_interval& x, const multi_interval& y) const
+{
+    return map(&interval_algebra::Ge, x, y);
+}
+
+multi_interval multi_interval_algebra::Gt(const multi_interval& x, const multi_interval& y) const
+{
+    return map(&interval_algebra::Gt, x, y);
+}
+
+multi_interval multi_interval_algebra::IntCast(const multi_interval& x) const
+{
+    return map(&interval_algebra::IntCast, x);
+}
+
+multi_interval multi_interval_algebra::Le(const multi_interval& x, const multi_interval& y) const
+{
+    return map(&interval_algebra::Le, x, y);
+}
+
+multi_interval multi_interval_algebra::Log(const multi_interval& x) const
+{
+    return map(&interval_algebra::Log, x);
+}
+
+multi_interval multi_interval_algebra::Log10(const multi_interval& x) const
+{
+    return map(&interval_algebra::Log10, x);
+}
+
+multi_interval multi_interval_algebra::Lsh(const multi_interval& x, const multi_interval& y) const
+{
+    return map(&interval_algebra::Lsh, x, y);
+}
+
+multi_interval multi_interval_algebra::Lt(const multi_interval& x, const multi_interval& y) const
+{
+    return map(&interval_algebra::Lt, x, y);
+}
+
+multi_interval multi_interval_algebra::Max(const multi_interval& x, const multi_interval& y) const
+{
+    return map(&interval_algebra::Max, x, y);
+}
+
+multi_interval multi_interval_algebra::Mem(const multi_interval& x) const
+{
+    return map(&interval_algebra::Mem, x);
+}
+
+multi_interval multi_interval_algebra::Min(const multi_interval& x, const multi_interval& y) const
+{
+    return map(&interval_algebra::Min, x, y);
+}
+
+multi_interval multi_interval_algebra::Ne(const multi_interval& x, const multi_interval& y) const
+{
+    return map(&interval_algebra::Ne, x, y);
+}
+
+multi_interval multi_interval_algebra::Not(const multi_interval& x) const
+{
+    return map(&interval_algebra::Not, x);
+}
+
+multi_interval multi_interval_algebra::Or(const multi_interval& x, const multi_interval& y) const
+{
+    return map(&interval_algebra::Or, x, y);
+}
+
+multi_interval multi_interval_algebra::Pow(const multi_interval& x, const multi_interval& y) const
+{
+    return map(&interval_algebra::Pow, x, y);
+}
+
+multi_interval multi_interval_algebra::RdTbl(const multi_interval& tbl, const multi_interval& index) const
+{
+    if (index.isEmpty()) return {};
+    return tbl;
+}
+
+multi_interval multi_interval_algebra::Remainder(const multi_interval& x) const
+{
+    return map(&interval_algebra::Remainder, x);
+}
+
+multi_interval multi_interval_algebra::Rint(const multi_interval& x) const
+{
+    return map(&interval_algebra::Rint, x);
+}
+
+multi_interval multi_interval_algebra::Rsh(const multi_interval& x, const multi_interval& y) const
+{
+    return map(&interval_algebra::Rsh, x, y);
+}
+
+// the union of the pieces of the branches reachable with the hull of the selector
+static multi_interval select(unsigned b, std::initializer_list<const multi_interval*> branches)
+{
+    std::array<interval, 3 * kMultiPieces> p;
+    int                                    n = 0;
+    for (int i = 0; i < int(branches.size()); i++) {
+        if ((b & (1U << i)) == 0) continue;
+        for (const auto& a : *branches.begin()[i]) p[n++] = a;
+    }
+    return multi_interval::fromPieces(p.data(), n);
+}
+
+multi_interval multi_interval_algebra::Select2(const multi_interval& s, const multi_interval& x,
+                                               const multi_interval& y) const
+{
+    return select(fAlgebra.selectBranches(s.hull(), 2), {&x, &y});
+}
+
+multi_interval multi_interval_algebra::Select3(const multi_interval& s, const multi_interval& x,
+                                               const multi_interval& y, const multi_interval& z) const
+{
+    return select(fAlgebra.selectBranches(s.hull(), 3), {&x, &y, &z});
+}
+
+multi_interval multi_interval_algebra::Sin(const multi_interval& x) const
+{
+    return map(&interval_algebra::Sin, x);
+}
+
+multi_interval multi_interval_algebra::Sinh(const multi_interval& x) const
+{
+    return map(&interval_algebra::Sinh, x);
+}
+
+multi_interval multi_interval_algebra::Sqrt(const multi_interval& x) const
+{
+    return map(&interval_algebra::Sqrt, x);
+}
+
+multi_interval multi_interval_algebra::Tanh(const multi_interval& x) const
+{
+    return map(&interval_algebra::Tanh, x);
+}
+
+multi_interval multi_interval_algebra::WrTbl(const multi_interval& n, const multi_interval& init,
+                                             const multi_interval& index, const multi_interval& value) const
+{
+    if (n.isEmpty()) return {};
+    if (index.isEmpty() || value.isEmpty()) return init;  // read only table
+    std::array<interval, 2 * kMultiPieces> p;
+    int                                    k = 0;
+    for (const auto& a : init) p[k++] = a;
+    for (const auto& a : value) p[k++] = a;
+    return multi_interval::fromPieces(p.data(), k);
+}
+
+multi_interval multi_interval_algebra::Xor(const multi_interval& x, const multi_interval& y) const
+{
+    return map(&interval_algebra::Xor, x, y);
+}
+
+//------------------------------------------------------------------------------------------
+// tests
+
+static void check(const std::string& testname, const multi_interval& exp, const multi_interval& res)
+{
+    std::ostringstream e, r;
+    e << exp;
+    r << res;
+    ::check(testname + " " + e.str() + " == " + r.str(), exp == res, true);
+}
+
+static multi_interval pieces(std::initializer_list<interval> l)
+{
+    piece_buffer p;
+    std::copy(l.begin(), l.end(), p.begin());
+    return multi_interval::fromPieces(p.data(), int(l.size()));
+}
+
+void testMultiInterval()
+{
+    multi_interval_algebra A;
+    multi_interval         x(interval(-1, 1));
+
+    // 1/[-1,1] keeps its gap, and the clamps recover finite bounds
+    multi_interval v = A.Inv(x);
+    check("test multi Inv", v, pieces({interval(-HUGE_VAL, -1), interval(1, HUGE_VAL)}));
+    multi_interval c = A.Min(A.Max(v, A.FloatNum(-10)), A.FloatNum(10));
+    check("test multi clamp", c, pieces({interval(-10, -1), interval(1, 10)}));
+    ::check("test multi Div", A.Div(A.FloatNum(2), x).has(0), false);
+
+    // the pieces of an integer argument are not integers
+    multi_interval vi = A.Inv(multi_interval(interval(-3, 3, 0)));
+    ::check("test multi Inv integer", (vi.count() == 2) && !vi.has(0) && vi.has(1.0 / 3) && vi.has(-1.0 / 3), true);
+    ::check("test multi Inv integer lsb", vi.hull().lsb() < 0, true);
+
+    // a pole splits tan([1,2]) in two pieces
+    multi_interval t = A.Tan(multi_interval(interval(1, 2)));
+    ::check("test multi Tan", (t.count() == 2) && t.has(std::tan(1.0)) && t.has(std::tan(2.0)) && !t.has(0), true);
+    ::check("test multi Tan no pole", A.Tan(multi_interval(interval(-1, 1))).count() == 1, true);
+    multi_interval ti = A.Tan(multi_interval(interval(1, 2, 0)));
+    ::check("test multi Tan integer", (ti.count() == 2) && ti.has(std::tan(1.0)) && !ti.has(1) && (ti.hull().lsb() < 0),
+            true);
+
+    // [0.9,1.1] % 1 is [0.9,1[ U [0,0.1]
+    multi_interval m = A.Mod(multi_interval(interval(0.9, 1.1)), A.FloatNum(1));
+    ::check("test multi Mod", (m.count() == 2) && !m.has(0.5), true);
+
+    // the closest pieces are merged beyond kMultiPieces
+    multi_interval u = pieces({interval(0), interval(1), interval(10), interval(11), interval(100), interval(1000)});
+    check("test multi merge", u, pieces({interval(0, 1), interval(10, 11), interval(100), interval(1000)}));
+    ::check("test multi hull", u.hull() == interval(0, 1000), true);
+
+    // the other methods are computed piece by piece
+    check("test multi Add", A.Add(v, A.FloatNum(1)), pieces({interval(-HUGE_VAL, 0), interval(2, HUGE_VAL)}));
+    ::check("test multi Button", A.Button(multi_interval()).hull() == interval(0, 1), true);
+
+    check("test multi Select2", A.Select2(multi_interval(interval(0, 1, 0)), A.FloatNum(0), A.FloatNum(10)),
+          pieces({interval(0), interval(10)}));
+
+    multi_interval tbl = A.WrTbl(A.FloatNum(8), A.FloatNum(0), multi_interval(interval(0, 7, 0)), A.FloatNum(10));
+    check("test multi WrTbl", A.RdTbl(tbl, A.FloatNum(3)), pieces({interval(0), interval(10)}));
+}
+
+}  // namespace itv
@@ -0,0 +1,110 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <string>
+
+#include "check.hh"
+#include "faust_algebra.hh"
+#include "interval_algebra.hh"
+#include "multi_interval.hh"
+
+namespace itv {
+
+// The faust algebra on multi intervals. Every method is computed by
+// interval_algebra on each piece, or each pair of pieces, of its arguments and
+// the results are united. Inv and Div split the pieces containing 0 in their
+// negative and positive parts, Tan splits the pieces containing a pole and Mod
+// the pieces containing a multiple of a constant modulus, so that their
+// results keep the gaps instead of covering them.
+class multi_interval_algebra : public faust_algebra<multi_interval> {
+   private:
+    interval_algebra fAlgebra;
+
+   public:
+    multi_interval Label(const std::string& x) const;
+    multi_interval IntNum(int x) const;
+    multi_interval FloatNum(double x) const;
+    multi_interval Button(const multi_interval& name) const;
+    multi_interval Checkbox(const multi_interval& name) const;
+    multi_interval VSlider(const multi_interval& name, const multi_interval& init, const multi_interval& lo,
+                           const multi_interval& hi, const multi_interval& step) const;
+    multi_interval HSlider(const multi_interval& name, const multi_interval& init, const multi_interval& lo,
+                           const multi_interval& hi, const multi_interval& step) const;
+    multi_interval NumEntry(const multi_interval& name, const multi_interval& init, const multi_interval& lo,
+                            const multi_interval& hi, const multi_interval& step) const;
+    multi_interval Abs(const multi_interval& x) const;
+    multi_interval Add(const multi_interval& x, const multi_interval& y) const;
+    multi_interval Sub(const multi_interval& x, const multi_interval& y) const;
+    multi_interval Mul(const multi_interval& x, const multi_interval& y) const;
+    multi_interval Div(const multi_interval& x, const multi_interval& y) const;
+    multi_interval Inv(const multi_interval& x) const;
+    multi_interval Neg(const multi_interval& x) const;
+    multi_interval Mod(const multi_interval& x, const multi_interval& y) const;
+    multi_interval Acos(const multi_interval& x) const;
+    multi_interval Acosh(const multi_interval& x) const;
+    multi_interval And(const multi_interval& x, const multi_interval& y) const;
+    multi_interval Asin(const multi_interval& x) const;
+    multi_interval Asinh(const multi_interval& x) const;
+    multi_interval Atan(const multi_interval& x) const;
+    multi_interval Atan2(const multi_interval& x, const multi_interval& y) const;
+    multi_interval Atanh(const multi_interval& x) const;
+    multi_interval Ceil(const multi_interval& x) const;
+    multi_interval Cos(const multi_interval& x) const;
+    multi_interval Cosh(const multi_interval& x) const;
+    multi_interval Delay(const multi_interval& x, const multi_interval& y) const;
+    multi_interval Eq(const multi_interval& x, const multi_interval& y) const;
+    multi_interval Exp(const multi_interval& x) const;
+    multi_interval FloatCast(const multi_interval& x) const;
+    multi_interval Floor(const multi_interval& x) const;
+    multi_interval Ge(const multi_interval& x, const multi_interval& y) const;
+    multi_interval Gt(const multi_interval& x, const multi_interval& y) const;
+    multi_interval IntCast(const multi_interval& x) const;
+    multi_interval Le(const multi_interval& x, const multi_interval& y) const;
+    multi_interval Log(const multi_interval& x) const;
+    multi_interval Log10(const multi_interval& x) const;
+    multi_interval Lsh(const multi_interval& x, const multi_interval& y) const;
+    multi_interval Lt(const multi_interval& x, const multi_interval& y) const;
+    multi_interval Max(const multi_interval& x, const multi_interval& y) const;
+    multi_interval Mem(const multi_interval& x) const;
+    multi_interval Min(const multi_interval& x, const multi_interval& y) const;
+    multi_interval Ne(const multi_interval& x, const multi_interval& y) const;
+    multi_interval Not(const multi_interval& x) const;
+    multi_interval Or(const multi_interval& x, const multi_interval& y) const;
+    multi_interval Pow(const multi_interval& x, const multi_interval& y) const;
+    multi_interval RdTbl(const multi_interval& tbl, const multi_interval& index) const;
+    multi_interval Remainder(const multi_interval& x) const;
+    multi_interval Rint(const multi_interval& x) const;
+    multi_interval Rsh(const multi_interval& x, const multi_interval& y) const;
+    multi_interval Select2(const multi_interval& s, const multi_interval& x, const multi_interval& y) const;
+    multi_interval Select3(const multi_interval& s, const multi_interval& x, const multi_interval& y,
+                           const multi_interval& z) const;
+    multi_interval Sin(const multi_interval& x) const;
+    multi_interval Sinh(const multi_interval& x) const;
+    multi_interval Sqrt(const multi_interval& x) const;
+    multi_interval Tan(const multi_interval& x) const;
+    multi_interval Tanh(const multi_interval& x) const;
+    multi_interval WrTbl(const multi_interval& n, const multi_interval& init,
+                         const multi_interval& index, const multi_interval& value) const;
+    multi_interval Xor(const multi_interval& x, const multi_interval& y) const;
+
+   private:
+    multi_interval map(umth m, const multi_interval& x) const;
+    multi_interval map(bmth m, const multi_interval& x, const multi_interval& y) const;
+};
+
+void testMultiInterval();
+
+}  // namespace itv
@@ -0,0 +1,503 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <random>
+#include <string>
+
+#include "check.hh"
+#include "interval_def.hh"
+#include "outward_interval_algebra.hh"
+
+namespace itv {
+
+// maximal error of the libm functions, in ulps. The glibc manual lists at most
+// 2 ulps for the double precision functions used here ("Known Maximum Errors in
+// Math Functions"), the margin covers the other usual implementations.
+static constexpr int kLibmUlps = 4;
+
+//------------------------------------------------------------------------------------------
+// outward rounding of a bound
+
+static double down(double x, int ulps = 1)
+{
+    for (int i = 0; i < ulps; i++) x = std::nextafter(x, -HUGE_VAL);
+    return x;
+}
+
+static double up(double x, int ulps = 1)
+{
+    for (int i = 0; i < ulps; i++) x = std::nextafter(x, HUGE_VAL);
+    return x;
+}
+
+// the interval [lo,hi] at the given lsb. The constructor truncates both bounds
+// to multiples of 2^lsb, the high bound is moved up by one lsb if it was lowered.
+static interval outward(double lo, double hi, int lsb)
+{
+    interval r(lo, hi, lsb);
+    if (r.isEmpty() || !(r.hi() < hi)) return r;
+    return {r.lo(), hi + std::ldexp(1.0, lsb), lsb};
+}
+
+// a result of interval_algebra, widened by the error of the libm function which computed it.
+// Its high bound may have been lowered by up to one lsb when it was truncated.
+static interval widen(const interval& r, int ulps)
+{
+    if (r.isEmpty()) return r;
+    return outward(down(r.lo(), ulps), up(r.hi(), ulps) + std::ldexp(1.0, r.lsb()), r.lsb());
+}
+
+//------------------------------------------------------------------------------------------
+// sound bounds of a sum and of a product, using error free transformations
+
+// a + b = s + e exactly (TwoSum), for finite a, b and s
+static double sumError(double a, double b, double s)
+{
+    double bb = s - a;
+    return (a - (s - bb)) + (b - bb);
+}
+
+// a lower bound of a + b. inf-inf is undefined, as in interval_algebra it gives an unbounded result.
+static double addDown(double a, double b)
+{
+    double s = a + b;
+    if (std::isnan(s)) return -HUGE_VAL;
+    if (std::isinf(s)) return (std::isinf(a) || std::isinf(b) || (s < 0)) ? s : DBL_MAX;  // overflow
+    return (sumError(a, b, s) < 0) ? down(s) : s;
+}
+
+// an upper bound of a + b
+static double addUp(double a, double b)
+{
+    double s = a + b;
+    if (std::isnan(s)) return HUGE_VAL;
+    if (std::isinf(s)) return (std::isinf(a) || std::isinf(b) || (s > 0)) ? s : -DBL_MAX;
+    return (sumError(a, b, s) > 0) ? up(s) : s;
+}
+
+// a * b = p + e exactly (TwoProd), for finite a, b and p far enough from the subnormals
+static bool exactProduct(double a, double b, double p, double& e)
+{
+    if (std::fabs(p) < 0x1p-969) return false;  // the error may not be representable
+    e = std::fma(a, b, -p);
+    return true;
+}
+
+// a lower bound of a * b, with 0 * inf = 0 as in interval_algebra
+static double mulDown(double a, double b)
+{
+    if ((a == 0.0) || (b == 0.0)) return 0.0;
+    double p = a * b;
+    double e = 0;
+    if (std::isinf(p)) return (std::isinf(a) || std::isinf(b) || (p < 0)) ? p : DBL_MAX;
+    if (!exactProduct(a, b, p, e)) return down(p);
+    return (e < 0) ? down(p) : p;
+}
+
+// an upper bound of a * b
+static double mulUp(double a, double b)
+{
+    if ((a == 0.0) || (b == 0.0)) return 0.0;
+    double p = a * b;
+    double e = 0;
+    if (std::isinf(p)) return (std::isinf(a) || std::isinf(b) || (p > 0)) ? p : -DBL_MAX;
+    if (!exactProduct(a, b, p, e)) return up(p);
+    return (e > 0) ? up(p) : p;
+}
+
+static int finerLSB(const interval& x, const interval& y)
+{
+    return std::max(kMinLSB, std::min(x.lsb(), y.lsb()));
+}
+
+//------------------------------------------------------------------------------------------
+// methods with error free transformations
+
+interval outward_interval_algebra::Add(const interval& x, const interval& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return {};
+    return outward(addDown(x.lo(), y.lo()), addUp(x.hi(), y.hi()), finerLSB(x, y));
+}
+
+interval outward_interval_algebra::Sub(const interval& x, const interval& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return {};
+    return outward(addDown(x.lo(), -y.hi()), addUp(x.hi(), -y.lo()), finerLSB(x, y));
+}
+
+interval outward_interval_algebra::Mul(const interval& x, const interval& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return {};
+    double lo = std::min(std::min(mulDown(x.lo(), y.lo()), mulDown(x.lo(), y.hi())),
+                         std::min(mulDown(x.hi(), y.lo()), mulDown(x.hi(), y.hi())));
+    double hi = std::max(std::max(mulUp(x.lo(), y.lo()), mulUp(x.lo(), y.hi())),
+                         std::max(mulUp(x.hi(), y.lo()), mulUp(x.hi(), y.hi())));
+    return outward(lo, hi, std::max(kMinLSB, x.lsb() + y.lsb()));
+}
+
+interval outward_interval_algebra::Inv(const interval& x) const
+{
+    // the division is correctly rounded, one ulp is enough
+    interval r = fAlgebra.Inv(x);
+    if (r.isEmpty()) return r;
+    return outward(down(r.lo()), up(r.hi()), std::max(kMinLSB, r.lsb()));
+}
+
+interval outward_interval_algebra::Div(const interval& x, const interval& y) const
+{
+    return Mul(x, Inv(y));
+}
+
+interval outward_interval_algebra::Sqrt(const interval& x) const
+{
+    return widen(fAlgebra.Sqrt(x), 1);  // correctly rounded
+}
+
+//------------------------------------------------------------------------------------------
+// methods computed by interval_algebra
+
+interval outward_interval_algebra::Label(const std::string& x) const
+{
+    return fAlgebra.Label(x);
+}
+
+interval outward_interval_algebra::IntNum(int x) const
+{
+    return fAlgebra.IntNum(x);
+}
+
+interval outward_interval_algebra::FloatNum(double x) const
+{
+    return fAlgebra.FloatNum(x);
+}
+
+interval outward_interval_algebra::Button(const interval& name) const
+{
+    return fAlgebra.Button(name);
+}
+
+interval outward_interval_algebra::Checkbox(const interval& name) const
+{
+    return fAlgebra.Checkbox(name);
+}
+
+interval outward_interval_algebra::VSlider(const interval& name, const interval& init, const interval& lo,
+                                           const interval& hi, const interval& step) const
+{
+    return fAlgebra.VSlider(name, init, lo, hi, step);
+}
+
+interval outward_interval_algebra::HSlider(const interval& name, const interval& init, const interval& lo,
+                                           const interval& hi, const interval& step) const
+{
+    return fAlgebra.HSlider(name, init, lo, hi, step);
+}
+
+interval outward_interval_algebra::NumEntry(const interval& name, const interval& init, const interval& lo,
+                                            const interval& hi, const interval& step) const
+{
+    return fAlgebra.NumEntry(name, init, lo, hi, step);
+}
+
+interval outward_interval_algebra::Abs(const interval& x) const
+{
+    return fAlgebra.Abs(x);
+}
+
+interval outward_interval_algebra::Neg(const interval& x) const
+{
+    return fAlgebra.Neg(x);
+}
+
+interval outward_interval_algebra::Mod(const interval& x, const interval& y) const
+{
+    return fAlgebra.Mod(x, y);
+}
+
+interval outward_interval_algebra::Acos(const interval& x) const
+{
+    return widen(fAlgebra.Acos(x), kLibmUlps);
+}
+
+interval outward_interval_algebra::Acosh(const interval& x) const
+{
+    return widen(fAlgebra.Acosh(x), kLibmUlps);
+}
+
+interval outward_interval_algebra::And(const interval& x, const interval& y) const
+{
+    return fAlgebra.And(x, y);
+}
+
+interval outward_interval_algebra::Asin(const interval& x) const
+{
+    return widen(fAlgebra.Asin(x), kLibmUlps);
+}
+
+interval outward_interval_algebra::Asinh(const interval& x) const
+{
+    return widen(fAlgebra.Asinh(x), kLibmUlps);
+}
+
+interval outward_interval_algebra::Atan(const interval& x) const
+{
+    return widen(fAlgebra.Atan(x), kLibmUlps);
+}
+
+interval outward_interval_algebra::Atan2(const interval& x, const interval& y) const
+{
+    return widen(fAlgebra.Atan2(x, y), kLibmUlps);
+}
+
+interval outward_interval_algebra::Atanh(const interval& x) const
+{
+    return widen(fAlgebra.Atanh(x), kLibmUlps);
+}
+
+interval outward_interval_algebra::Ceil(const interval& x) const
+{
+    return fAlgebra.Ceil(x);
+}
+
+interval outward_interval_algebra::Cos(const interval& x) const
+{
+    return widen(fAlgebra.Cos(x), kLibmUlps);
+}
+
+interval outward_interval_algebra::Cosh(const interval& x) const
+{
+    return widen(fAlgebra.Cosh(x), kLibmUlps);
+}
+
+interval outward_interval_algebra::Delay(const interval& x, const interval& y) const
+{
+    return fAlgebra.Delay(x, y);
+}
+
+interval outward_interval_algebra::Eq(const interval& x, const interval& y) const
+{
+    return fAlgebra.Eq(x, y);
+}
+
+interval outward_interval_algebra::Exp(const interval& x) const
+{
+    return widen(fAlgebra.Exp(x), kLibmUlps);
+}
+
+interval outward_interval_algebra::FloatCast(const interval& x) const
+{
+    return fAlgebra.FloatCast(x);
+}
+
+interval outward_interval_algebra::Floor(const interval& x) const
+{
+    return fAlgebra.Floor(x);
+}
+
+interval outward_interval_algebra::Ge(const interval& x, const interval& y) const
+{
+    return fAlgebra.Ge(x, y);
+}
+
+interval outward_interval_algebra::Gt(const interval& x, const interval& y) const
+{
+    return fAlgebra.Gt(x, y);
+}
+
+interval outward_interval_algebra::IntCast(const interval& x) const
+{
+    return fAlgebra.IntCast(x);
+}
+
+interval outward_interval_algebra::Le(const interval& x, const interval& y) const
+{
+    return fAlgebra.Le(x, y);
+}
+
+interval outward_interval_algebra::Log(const interval& x) const
+{
+    return widen(fAlgebra.Log(x), kLibmUlps);
+}
+
+interval outward_interval_algebra::Log10(const interval& x) const
+{
+    return widen(fAlgebra.Log10(x), kLibmUlps);
+}
+
+interval outward_interval_algebra::Lsh(const interval& x, const interval& y) const
+{
+    return fAlgebra.Lsh(x, y);
+}
+
+interval outward_interval_algebra::Lt(const interval& x, const interval& y) const
+{
+    return fAlgebra.Lt(x, y);
+}
+
+interval outward_interval_algebra::Max(const interval& x, const interval& y) const
+{
+    return fAlgebra.Max(x, y);
+}
+
+interval outward_interval_algebra::Mem(const interval& x) const
+{
+    return fAlgebra.Mem(x);
+}
+
+interval outward_interval_algebra::Min(const interval& x, const interval& y) const
+{
+    return fAlgebra.Min(x, y);
+}
+
+interval outward_interval_algebra::Ne(const interval& x, const interval& y) const
+{
+    return fAlgebra.Ne(x, y);
+}
+
+interval outward_interval_algebra::Not(const interval& x) const
+{
+    return fAlgebra.Not(x);
+}
+
+interval outward_interval_algebra::Or(const interval& x, const interval& y) const
+{
+    return fAlgebra.Or(x, y);
+}
+
+interval outward_interval_algebra::Pow(const interval& x, const interval& y) const
+{
+    return widen(fAlgebra.Pow(x, y), kLibmUlps);
+}
+
+interval outward_interval_algebra::RdTbl(const interval& tbl, const interval& index) const
+{
+    return fAlgebra.RdTbl(tbl, index);
+}
+
+interval outward_interval_algebra::Remainder(const interval& x) const
+{
+    return fAlgebra.Remainder(x);
+}
+
+interval outward_interval_algebra::Rint(const interval& x) const
+{
+    return fAlgebra.Rint(x);
+}
+
+interval outward_interval_algebra::Rsh(const interval& x, const interval& y) const
+{
+    return fAlgebra.Rsh(x, y);
+}
+
+interval outward_interval_algebra::Select2(const interval& s, const interval& x, const interval& y) const
+{
+    return fAlgebra.Select2(s, x, y);
+}
+
+interval outward_interval_algebra::Select3(const interval& s, const interval& x, const interval& y,
+                                           const interval& z) const
+{
+    return fAlgebra.Select3(s, x, y, z);
+}
+
+interval outward_interval_algebra::Sin(const interval& x) const
+{
+    return widen(fAlgebra.Sin(x), kLibmUlps);
+}
+
+interval outward_interval_algebra::Sinh(const interval& x) const
+{
+    return widen(fAlgebra.Sinh(x), kLibmUlps);
+}
+
+interval outward_interval_algebra::Tan(const interval& x) const
+{
+    return widen(fAlgebra.Tan(x), kLibmUlps);
+}
+
+interval outward_interval_algebra::Tanh(const interval& x) const
+{
+    return widen(fAlgebra.Tanh(x), kLibmUlps);
+}
+
+interval outward_interval_algebra::WrTbl(const interval& n, const interval& init,
+                                         const interval& index, const interval& value) const
+{
+    return fAlgebra.WrTbl(n, init, index, value);
+}
+
+interval outward_interval_algebra::Xor(const interval& x, const interval& y) const
+{
+    return fAlgebra.Xor(x, y);
+}
+
+//------------------------------------------------------------------------------------------
+// tests
+
+void testOutward()
+{
+    outward_interval_algebra O;
+    interval_algebra         A;
+
+    // 0.1 + 0.2 is rounded up to 0.30000000000000004, above the exact sum
+    interval a(0.1, 0.1, kMinLSB);
+    interval b(0.2, 0.2, kMinLSB);
+    interval s = O.Add(a, b);
+    check("test outward Add lo", s.lo() < 0.1 + 0.2, true);
+    check("test outward Add hi", s.hi() == 0.1 + 0.2, true);
+    check("test outward Add tight", up(s.lo()) == 0.1 + 0.2, true);
+    check("test outward Add exact", O.Add(interval(1, 2, 0), interval(3, 4, 0)), interval(4, 6, 0));
+    check("test outward Add overflow", O.Add(interval(DBL_MAX, DBL_MAX, 0), interval(DBL_MAX, DBL_MAX, 0)).lo() == DBL_MAX,
+          true);
+
+    // 0.1 * 3 is rounded up as well, the exact product is between the bounds
+    interval p = O.Mul(a, interval(3, 3, 0));
+    check("test outward Mul", (p.lo() < 0.1 * 3) && (p.hi() == 0.1 * 3), true);
+    check("test outward Mul exact", O.Mul(interval(-2, 3, 0), interval(-50, 10, 0)), interval(-150, 100, 0));
+    check("test outward Mul inf", O.Mul(interval(0, 0, 0), interval(-HUGE_VAL, HUGE_VAL, 0)), interval(0, 0, 0));
+
+    interval d = O.Div(interval(1, 1, 0), interval(3, 3, 0));
+    check("test outward Div", (d.lo() < 1.0 / 3) && (d.hi() > 1.0 / 3), true);
+
+    // the sound results contain the fast ones, whose low bounds may be lower by one lsb when
+    // the sound result has a finer lsb
+    std::default_random_engine             generator(0);
+    std::uniform_real_distribution<double> rd(-100, 100);
+    bool                                   contained = true;
+    for (int i = 0; i < 1000; i++) {
+        interval x(rd(generator), rd(generator));
+        interval y(rd(generator), rd(generator));
+        for (auto [f, o] : {std::pair{A.Add(x, y), O.Add(x, y)}, std::pair{A.Mul(x, y), O.Mul(x, y)},
+                            std::pair{A.Exp(x), O.Exp(x)}, std::pair{A.Sin(x), O.Sin(x)}}) {
+            contained = contained && (o.lo() <= f.lo() + std::ldexp(1.0, f.lsb())) && (f.hi() <= o.hi());
+        }
+    }
+    check("test outward contains fast", contained, true);
+    interval e = O.Exp(interval(1, 1, kMinLSB));
+    check("test outward Exp", (e.lo() < std::exp(1.0)) && (e.hi() > std::exp(1.0)), true);
+
+    // Select2 and Select3 gather the reachable branches
+    check("test outward Select2", O.Select2(interval(1, 3, 0), interval(0, 1), interval(2, 3)), interval(2, 3));
+    check("test outward Select3", O.Select3(interval(0, 1, 0), interval(0, 1), interval(2, 3), interval(9)),
+          interval(0, 3));
+
+    check("test outward WrTbl", O.RdTbl(O.WrTbl(interval(8), interval(0), interval(0, 7, 0), interval(-1, 1)),
+                                        interval(0, 7, 0)),
+          interval(-1, 1));
+}
+
+}  // namespace itv
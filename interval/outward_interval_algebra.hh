@@ -0,0 +1,107 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <string>
+
+#include "faust_algebra.hh"
+#include "interval_algebra.hh"
+#include "interval_def.hh"
+
+namespace itv {
+
+// The sound mode of the faust algebra: the bounds of the results are rounded
+// outward, so that they contain the exact real results. Add, Sub, Mul and Inv
+// (hence Div) use error free transformations (TwoSum, and TwoProd with an fma)
+// to round a bound only when its computation was inexact. The other methods are
+// computed by interval_algebra and widened by the maximal error of the libm
+// function they use. The results have the finer lsb of the arguments instead of
+// the default one, which would otherwise hide the rounding errors.
+class outward_interval_algebra : public faust_algebra<interval> {
+   private:
+    interval_algebra fAlgebra;
+
+   public:
+    interval Label(const std::string& x) const;
+    interval IntNum(int x) const;
+    interval FloatNum(double x) const;
+    interval Button(const interval& name) const;
+    interval Checkbox(const interval& name) const;
+    interval VSlider(const interval& name, const interval& init, const interval& lo, const interval& hi,
+                     const interval& step) const;
+    interval HSlider(const interval& name, const interval& init, const interval& lo, const interval& hi,
+                     const interval& step) const;
+    interval NumEntry(const interval& name, const interval& init, const interval& lo, const interval& hi,
+                      const interval& step) const;
+    interval Abs(const interval& x) const;
+    interval Add(const interval& x, const interval& y) const;
+    interval Sub(const interval& x, const interval& y) const;
+    interval Mul(const interval& x, const interval& y) const;
+    interval Div(const interval& x, const interval& y) const;
+    interval Inv(const interval& x) const;
+    interval Neg(const interval& x) const;
+    interval Mod(const interval& x, const interval& y) const;
+    interval Acos(const interval& x) const;
+    interval Acosh(const interval& x) const;
+    interval And(const interval& x, const interval& y) const;
+    interval Asin(const interval& x) const;
+    interval Asinh(const interval& x) const;
+    interval Atan(const interval& x) const;
+    interval Atan2(const interval& x, const interval& y) const;
+    interval Atanh(const interval& x) const;
+    interval Ceil(const interval& x) const;
+    interval Cos(const interval& x) const;
+    interval Cosh(const interval& x) const;
+    interval Delay(const interval& x, const interval& y) const;
+    interval Eq(const interval& x, const interval& y) const;
+    interval Exp(const interval& x) const;
+    interval FloatCast(const interval& x) const;
+    interval Floor(const interval& x) const;
+    interval Ge(const interval& x, const interval& y) const;
+    interval Gt(const interval& x, const interval& y) const;
+    interval IntCast(const interval& x) const;
+    interval Le(const interval& x, const interval& y) const;
+    interval Log(const interval& x) const;
+    interval Log10(const interval& x) const;
+    interval Lsh(const interval& x, const interval& y) const;
+    interval Lt(const interval& x, const interval& y) const;
+    interval Max(const interval& x, const interval& y) const;
+    interval Mem(const interval& x) const;
+    interval Min(const interval& x, const interval& y) const;
+    interval Ne(const interval& x, const interval& y) const;
+    interval Not(const interval& x) const;
+    interval Or(const interval& x, const interval& y) const;
+    interval Pow(const interval& x, const interval& y) const;
+    interval RdTbl(const interval& tbl, const interval& index) const;
+    interval Remainder(const interval& x) const;
+    interval Rint(const interval& x) const;
+    interval Rsh(const interval& x, const interval& y) const;
+    interval Select2(const interval& s, const interval& x, const interval& y) const;
+    interval Select3(const interval& s, const interval& x, const interval& y, const interval& z) const;
+    interval Sin(const interval& x) const;
+    interval Sinh(const interval& x) const;
+    interval Sqrt(const interval& x) const;
+    interval Tan(const interval& x) const;
+    interval Tanh(const interval& x) const;
+    interval WrTbl(const interval& n, const interval& init, const interval& index, const interval& value) const;
+    interval Xor(const interval& x, const interval& y) const;
+};
+
+using oumth = interval (outward_interval_algebra::*)(const interval&) const;
+using obmth = interval (outward_interval_algebra::*)(const interval&, const interval&) const;
+
+void testOutward();
+
+}  // namespace itv
@@ -0,0 +1,159 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <climits>
+#include <cmath>
+#include <vector>
+
+#include "check.hh"
+#include "interval_algebra.hh"
+#include "interval_def.hh"
+#include "redundancy.hh"
+#include "signal_graph.hh"
+
+namespace itv {
+
+static const simplification kNeeded{};
+
+static simplification identity(int argument)
+{
+    return {redundancy::identity, 0, argument};
+}
+
+// a constant, when the result z of the operation is a single finite value: z must be computed at the finest
+// precision, a result truncated to a coarser lsb would collapse a tiny variation to a constant
+static bool constant(const interval& z, simplification& s)
+{
+    if (!z.isconst() || !std::isfinite(z.lo())) return false;
+    s = {redundancy::constant, z.lo(), 0};
+    return true;
+}
+
+// integer values that IntCast keeps unchanged
+static bool isInteger(const interval& x)
+{
+    return (x.lsb() >= 0) && (x.lo() >= INT_MIN) && (x.hi() <= INT_MAX);
+}
+
+simplification simplify(umth m, const interval& x)
+{
+    interval_algebra A(kMinLSB);
+    simplification   s;
+    if (x.isEmpty()) return kNeeded;
+    if (constant((A.*m)(x), s)) return s;
+
+    using I = interval_algebra;
+    if ((m == &I::Abs) && (x.lo() >= 0)) return identity(0);
+    if ((m == &I::IntCast) && isInteger(x)) return identity(0);
+    if (((m == &I::Floor) || (m == &I::Ceil) || (m == &I::Rint)) && (x.lsb() >= 0)) return identity(0);
+    // Remainder has no divisor in this algebra, nothing is known of its result
+    return kNeeded;
+}
+
+simplification simplify(bmth m, const interval& x, const interval& y)
+{
+    interval_algebra A(kMinLSB);
+    simplification   s;
+    if (x.isEmpty() || y.isEmpty()) return kNeeded;
+    if (constant((A.*m)(x, y), s)) return s;
+
+    using I = interval_algebra;
+    if (m == &I::Min) {
+        if (x.hi() <= y.lo()) return identity(0);
+        if (y.hi() <= x.lo()) return identity(1);
+    } else if (m == &I::Max) {
+        if (x.lo() >= y.hi()) return identity(0);
+        if (y.lo() >= x.hi()) return identity(1);
+    } else if (m == static_cast<bmth>(&I::Mod)) {
+        // fmod(x,y) == x when |x| < |y|
+        double ymin = y.hasZero() ? 0 : std::min(std::fabs(y.lo()), std::fabs(y.hi()));
+        if (std::max(std::fabs(x.lo()), std::fabs(x.hi())) < ymin) return identity(0);
+    } else if (m == &I::Add) {
+        if (y.isZero()) return identity(0);
+        if (x.isZero()) return identity(1);
+    } else if (m == &I::Sub) {
+        if (y.isZero()) return identity(0);
+    } else if (m == &I::Mul) {
+        if (y.is(1)) return identity(0);
+        if (x.is(1)) return identity(1);
+    } else if (m == &I::Div) {
+        if (y.is(1)) return identity(0);
+    }
+    return kNeeded;
+}
+
+std::vector<simplification> simplifications(const signal_graph& g, const std::vector<interval>& R)
+{
+    std::vector<simplification> r(size_t(g.size()));
+    for (int i = 0; i < g.size(); i++) {
+        const signal_graph::node& n = g[i];
+        if (n.type == signal_graph::kind::unary) r[i] = simplify(n.u, R[n.x]);
+        if (n.type == signal_graph::kind::binary) r[i] = simplify(n.b, R[n.x], R[n.y]);
+    }
+    return r;
+}
+
+std::ostream& operator<<(std::ostream& dst, const simplification& s)
+{
+    switch (s.kind) {
+        case redundancy::identity: return dst << "identity " << (s.argument == 0 ? "x" : "y");
+        case redundancy::constant: return dst << "constant " << s.value;
+        default: return dst << "needed";
+    }
+}
+
+void testRedundancy()
+{
+    using I = interval_algebra;
+
+    auto is = [](const simplification& s, redundancy k, int argument = 0) {
+        return (s.kind == k) && ((k != redundancy::identity) || (s.argument == argument));
+    };
+    interval unit(0, 1, -24);
+    interval sym(-1, 1, -24);
+
+    check("test redundancy Abs", is(simplify(&I::Abs, unit), redundancy::identity), true);
+    check("test redundancy Abs needed", is(simplify(&I::Abs, sym), redundancy::needed), true);
+    check("test redundancy Min clamp", is(simplify(&I::Min, unit, interval(2)), redundancy::identity, 0), true);
+    check("test redundancy Max clamp", is(simplify(&I::Max, interval(-2), sym), redundancy::identity, 1), true);
+    check("test redundancy Max needed", is(simplify(&I::Max, sym, interval(0)), redundancy::needed), true);
+    check("test redundancy Mod", is(simplify(&I::Mod, interval(0, 99, 0), interval(100)), redundancy::identity), true);
+    check("test redundancy Mod needed", is(simplify(&I::Mod, interval(0, 100, 0), interval(100)), redundancy::needed),
+          true);
+    check("test redundancy IntCast", is(simplify(&I::IntCast, interval(-8, 8, 0)), redundancy::identity), true);
+    check("test redundancy IntCast needed", is(simplify(&I::IntCast, sym), redundancy::needed), true);
+    check("test redundancy Remainder", is(simplify(&I::Remainder, unit), redundancy::needed), true);
+    check("test redundancy Add 0", is(simplify(&I::Add, interval(0), sym), redundancy::identity, 1), true);
+
+    simplification c = simplify(&I::IntCast, interval(0.25, 0.75, -2));
+    check("test redundancy constant", is(c, redundancy::constant) && (c.value == 0), true);
+    check("test redundancy Gt constant", simplify(&I::Gt, interval(2, 3), unit).value == 1, true);
+    check("test redundancy Sin tiny", is(simplify(&I::Sin, interval(0, 1e-8, -40)), redundancy::needed), true);
+    check("test redundancy Exp tiny", is(simplify(&I::Exp, interval(0, 1e-9, -60)), redundancy::needed), true);
+
+    // a clamped and wrapped phase in a graph
+    signal_graph g;
+    int          x = g.input(interval(0, 0.5, -24));
+    int          k = g.binary(&I::Min, x, g.constant(1));
+    int          p = g.binary(&I::Mod, k, g.constant(1));
+    int          a = g.unary(&I::Abs, g.binary(&I::Sub, x, g.constant(0.25)));
+
+    std::vector<simplification> s = simplifications(g, g.ranges(I()));
+    for (int i = 0; i < g.size(); i++) testout() << "node " << i << ": " << s[i] << '\n';
+    check("test redundancy graph clamp", is(s[k], redundancy::identity, 0), true);
+    check("test redundancy graph wrap", is(s[p], redundancy::identity, 0), true);
+    check("test redundancy graph Abs", is(s[a], redundancy::needed), true);
+}
+
+}  // namespace itv
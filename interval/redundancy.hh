@@ -0,0 +1,56 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <iostream>
+#include <vector>
+
+#include "check.hh"
+#include "interval_def.hh"
+#include "signal_graph.hh"
+
+namespace itv {
+
+//==============================================================================
+// Range based redundancy oracle.
+//
+// Given a primitive and the ranges of its arguments, the oracle tells whether
+// the operation can be removed from the per-sample loop: it is a constant when
+// its range (computed by interval_algebra) is a single value, an identity when
+// it provably returns one of its arguments unchanged (Abs of a non-negative
+// value, a Min/Max clamp that never binds, Mod by m of values within ]-m,m[,
+// IntCast, Floor, Ceil and Rint of integers, Add/Sub of 0, Mul/Div by 1),
+// and needed otherwise.
+//==============================================================================
+
+enum class redundancy { identity, constant, needed };
+
+struct simplification {
+    redundancy kind{redundancy::needed};
+    double     value{0};     ///< the value of a constant
+    int        argument{0};  ///< the argument returned by an identity, 0 for x, 1 for y
+};
+
+simplification simplify(umth m, const interval& x);
+simplification simplify(bmth m, const interval& x, const interval& y);
+
+// the simplification of every node of g, for the ranges R of its nodes
+std::vector<simplification> simplifications(const signal_graph& g, const std::vector<interval>& R);
+
+std::ostream& operator<<(std::ostream& dst, const simplification& s);
+
+void testRedundancy();
+
+}  // namespace itv
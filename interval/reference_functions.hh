@@ -0,0 +1,120 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "interval_def.hh"
+
+// ***************************************************************************
+//
+//     The numerical functions of reference of the methods that have no
+//     function of the standard library, shared by the enumeration of the
+//     finite sets and the soundness checks of the fuzzer.
+//
+//****************************************************************************
+namespace itv {
+
+inline double myId(double x)
+{
+    return x;
+}
+inline double myIntCast(double x)
+{
+    return double(saturatedIntCast(x));
+}
+inline double myInv(double x)
+{
+    return 1.0 / x;
+}
+inline double myNeg(double x)
+{
+    return -x;
+}
+inline double myNot(double x)
+{
+    return double(~saturatedIntCast(x));
+}
+inline double myAdd(double x, double y)
+{
+    return x + y;
+}
+inline double mySub(double x, double y)
+{
+    return x - y;
+}
+inline double myMul(double x, double y)
+{
+    return ((x == 0.0) || (y == 0.0)) ? 0.0 : x * y;
+}
+inline double myDiv(double x, double y)
+{
+    return x / y;
+}
+inline double myMin(double x, double y)
+{
+    return std::min(x, y);
+}
+inline double myMax(double x, double y)
+{
+    return std::max(x, y);
+}
+inline double myAnd(double x, double y)
+{
+    return double(saturatedIntCast(x) & saturatedIntCast(y));
+}
+inline double myOr(double x, double y)
+{
+    return double(saturatedIntCast(x) | saturatedIntCast(y));
+}
+inline double myXor(double x, double y)
+{
+    return double(saturatedIntCast(x) ^ saturatedIntCast(y));
+}
+inline double myLsh(double x, double y)
+{
+    return x * std::pow(2.0, y);
+}
+inline double myRsh(double x, double y)
+{
+    return x * std::pow(2.0, -y);
+}
+inline double myLt(double x, double y)
+{
+    return double(x < y);
+}
+inline double myLe(double x, double y)
+{
+    return double(x <= y);
+}
+inline double myGt(double x, double y)
+{
+    return double(x > y);
+}
+inline double myGe(double x, double y)
+{
+    return double(x >= y);
+}
+inline double myEq(double x, double y)
+{
+    return double(x == y);
+}
+inline double myNe(double x, double y)
+{
+    return double(x != y);
+}
+
+}  // namespace itv
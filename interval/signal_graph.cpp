@@ -0,0 +1,149 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "interval_algebra.hh"
+#include "interval_def.hh"
+#include "lti_bounds.hh"
+#include "signal_graph.hh"
+
+namespace itv {
+
+int signal_graph::add(const node& n)
+{
+    fNodes.push_back(n);
+    return int(fNodes.size()) - 1;
+}
+
+int signal_graph::input(const interval& range, double error)
+{
+    return add({kind::input, range, 0, error});
+}
+
+int signal_graph::constant(double value)
+{
+    return add({kind::constant, interval(value, value, (value == 0) ? 0 : exactLSB(value)), value});
+}
+
+int signal_graph::unary(umth m, int x)
+{
+    return add({kind::unary, {}, 0, 0, m, nullptr, x});
+}
+
+int signal_graph::binary(bmth m, int x, int y)
+{
+    return add({kind::binary, {}, 0, 0, nullptr, m, x, y});
+}
+
+int signal_graph::feedback()
+{
+    return add({kind::feedback, interval(0, 0, 0)});
+}
+
+void signal_graph::loop(int f, int y)
+{
+    fNodes[f].x = y;
+}
+
+bool signal_graph::hasFeedback() const
+{
+    for (const node& n : fNodes) {
+        if (n.type == kind::feedback) return true;
+    }
+    return false;
+}
+
+// the thresholds of the widening: 0 and the powers of 2
+static double widenUp(double v)
+{
+    if (v <= 0) return 0;
+    double p = std::ldexp(1.0, std::ilogb(v));
+    return (p == v) ? v : 2 * p;  // infinity beyond DBL_MAX
+}
+
+static double widenDown(double v)
+{
+    return -widenUp(-v);
+}
+
+// the next range of a feedback node, from its current range r and the range y of its node
+static interval widen(const interval& r, const interval& y, bool last)
+{
+    interval z = reunion(r, y);
+    if (z.isEmpty()) return z;
+    double lo  = (z.lo() == r.lo()) ? r.lo() : (last ? -HUGE_VAL : widenDown(z.lo()));
+    double hi  = (z.hi() == r.hi()) ? r.hi() : (last ? HUGE_VAL : widenUp(z.hi()));
+    int    lsb = (z.lsb() == r.lsb()) ? r.lsb() : kMinLSB;
+    return {lo, hi, lsb};
+}
+
+std::vector<interval> signal_graph::ranges(const interval_algebra& A, int* iterations) const
+{
+    // the bounds of the nodes of the stable LTI loops, they replace the widening
+    std::vector<lti_loop>            loops = ltiLoops(*this);
+    std::vector<std::pair<int, int>> lti(fNodes.size(), {-1, -1});  // loop and index in the loop of each node
+    for (size_t l = 0; l < loops.size(); l++) {
+        if (!loops[l].stable) continue;
+        for (size_t k = 0; k < loops[l].nodes.size(); k++) lti[loops[l].nodes[k]] = {int(l), int(k)};
+    }
+
+    std::vector<interval> r(fNodes.size());
+    for (size_t i = 0; i < fNodes.size(); i++) {
+        if (fNodes[i].type == kind::feedback) r[i] = fNodes[i].range;  // the delay lines start at 0
+    }
+    for (int k = 1;; k++) {
+        for (size_t i = 0; i < fNodes.size(); i++) {
+            const node& n = fNodes[i];
+            switch (n.type) {
+                case kind::input:
+                case kind::constant: r[i] = n.range; break;
+                case kind::unary: r[i] = (A.*n.u)(r[n.x]); break;
+                case kind::binary: r[i] = (A.*n.b)(r[n.x], r[n.y]); break;
+                case kind::feedback: break;
+            }
+            if ((lti[i].first >= 0) && !r[i].isEmpty()) {
+                interval b = ltiBound(loops[lti[i].first], lti[i].second, r);
+                if (n.type == kind::feedback) {
+                    r[i] = b.isEmpty() ? b : interval(b.lo(), b.hi(), r[i].lsb());  // a loop is bounded in one pass
+                } else if (!b.isEmpty()) {
+                    r[i] = interval(std::max(r[i].lo(), b.lo()), std::min(r[i].hi(), b.hi()), r[i].lsb());
+                }
+            }
+        }
+        bool stable = true;
+        for (size_t i = 0; i < fNodes.size(); i++) {
+            const node& n = fNodes[i];
+            if (n.type != kind::feedback) continue;
+            interval z = widen(r[i], r[n.x], k >= kMaxIterations);
+            if (lti[i].first >= 0) {
+                interval b = ltiBound(loops[lti[i].first], lti[i].second, r);
+                z          = b.isEmpty() ? b : interval(b.lo(), b.hi(), z.lsb());
+            }
+            if (!((z == r[i]) && (z.lsb() == r[i].lsb()))) {
+                stable = false;
+                r[i]   = z;
+            }
+        }
+        if (stable) {
+            if (iterations != nullptr) *iterations = k;
+            return r;
+        }
+    }
+}
+
+}  // namespace itv
@@ -0,0 +1,80 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <vector>
+
+#include "check.hh"
+#include "interval_algebra.hh"
+#include "interval_def.hh"
+
+namespace itv {
+
+//==============================================================================
+// The signal graphs analysed by the word-length optimizer and the reports.
+//
+// A graph is a list of nodes in topological order: inputs, with a range (and
+// its lsb) and an error, constants and interval methods applied to previous
+// nodes.
+//
+// A feedback node is the previous sample of a node defined after it (the
+// recursion of Faust, whose delay line starts at 0), it is closed by loop()
+// once that node is defined. The ranges of the graphs with feedback are the
+// fixpoint of the evaluation of the graph: the range of each feedback node
+// starts at 0 and is extended by the range of its node until it is stable. To
+// reach it in a few iterations, a bound still moving is widened to the next
+// power of 2 (to infinity after kMaxIterations) and a lsb still decreasing is
+// widened to kMinLSB. The bounds of the stable linear loops (see lti_bounds.hh)
+// are computed in closed form instead of being widened.
+//==============================================================================
+
+constexpr int kMaxIterations = 64;
+
+class signal_graph {
+   public:
+    enum class kind { input, constant, unary, binary, feedback };
+
+    struct node {
+        kind     type;
+        interval range;         ///< range of an input, with its lsb
+        double   value{0};      ///< value of a constant
+        double   error{0};      ///< error of an input
+        umth     u{nullptr};    ///< method of an unary node
+        bmth     b{nullptr};    ///< method of a binary node
+        int      x{-1}, y{-1};  ///< arguments, indices of previous nodes (of the next one for a feedback node)
+    };
+
+   private:
+    std::vector<node> fNodes;
+
+    int add(const node& n);
+
+   public:
+    int  input(const interval& range, double error = 0);
+    int  constant(double value);
+    int  unary(umth m, int x);
+    int  binary(bmth m, int x, int y);
+    int  feedback();
+    void loop(int f, int y);  // closes the feedback node f: it is the previous sample of node y
+
+    int         size() const { return int(fNodes.size()); }
+    const node& operator[](int i) const { return fNodes[i]; }
+    bool        hasFeedback() const;
+
+    // the range of every node, computed by A, and the number of iterations of the fixpoint
+    std::vector<interval> ranges(const interval_algebra& A, int* iterations = nullptr) const;
+};
+
+}  // namespace itv
@@ -0,0 +1,171 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <climits>
+#include <cmath>
+#include <vector>
+
+#include "check.hh"
+#include "interval_algebra.hh"
+#include "interval_def.hh"
+#include "signal_graph.hh"
+#include "strength_reduction.hh"
+
+namespace itv {
+
+// the exponent k when c is a single value 2^k (positive)
+static bool powerOf2(const interval& c, int& k)
+{
+    if (!c.isconst() || !(c.lo() > 0) || !std::isfinite(c.lo())) return false;
+    int e;
+    if (std::frexp(c.lo(), &e) != 0.5) return false;
+    k = e - 1;
+    return true;
+}
+
+// integer values that fit in an int
+static bool isInt(const interval& x)
+{
+    return (x.lsb() >= 0) && (x.lo() >= INT_MIN) && (x.hi() <= INT_MAX);
+}
+
+static strength_hint hint(reduction kind, int amount, int argument, const char* obligation, bool proved)
+{
+    strength_hint h;
+    h.kind       = kind;
+    h.amount     = amount;
+    h.argument   = argument;
+    h.obligation = obligation;
+    h.proved     = proved;
+    return h;
+}
+
+// x * 2^k: a shift of integers, an ldexp otherwise
+static strength_hint scale(const interval& x, int k, int argument)
+{
+    interval_algebra A;
+    if (isInt(x) && (k >= 0)) {
+        bool          fits = isInt(A.Lsh(x, interval(k)));
+        strength_hint h    = hint(reduction::shift, k, argument, "x integer and x*2^k in int", fits);
+        if (h.proved) return h;
+    }
+    return hint(reduction::ldexp, k, argument, "the constant is exactly 2^k", true);
+}
+
+strength_hint strengthHint(umth m, const interval& x)
+{
+    using I = interval_algebra;
+    if (x.isEmpty()) return {};
+    if ((m == &I::Floor) || (m == &I::IntCast)) {
+        return hint(reduction::trunc, 0, 0, "0 <= x <= INT_MAX", (x.lo() >= 0) && (x.hi() <= INT_MAX));
+    }
+    return {};
+}
+
+strength_hint strengthHint(bmth m, const interval& x, const interval& y)
+{
+    using I = interval_algebra;
+    int k   = 0;
+    if (x.isEmpty() || y.isEmpty()) return {};
+    if (m == &I::Mul) {
+        if (powerOf2(y, k)) return scale(x, k, 0);
+        if (powerOf2(x, k)) return scale(y, k, 1);
+    } else if ((m == &I::Div) && powerOf2(y, k)) {
+        // Div is the real division: a right shift only when the quotient is exact, x a multiple of 2^k
+        if (isInt(x) && (k >= 0) && (x.lsb() >= k)) {
+            return hint(reduction::shift, -k, 0, "x integer multiple of 2^k", true);
+        }
+        return hint(reduction::ldexp, -k, 0, "the constant is exactly 2^k", true);
+    } else if ((m == static_cast<bmth>(&I::Mod)) && y.ispowerof2()) {
+        interval mask(y.lo() - 1);
+        return hint(reduction::mask, int(mask.lo()), 0, "x integer and x >= 0",
+                    mask.isbitmask() && isInt(x) && (x.lo() >= 0));
+    } else if ((m == &I::Pow) && y.isconst() && (std::rint(y.lo()) == y.lo()) && (std::fabs(y.lo()) >= 2) &&
+               (std::fabs(y.lo()) <= kMaxChain)) {
+        int n = int(y.lo());
+        return (n > 0) ? hint(reduction::mulchain, n, 0, "n integer in [2,kMaxChain]", true)
+                       : hint(reduction::mulchain, n, 0, "n integer in [-kMaxChain,-2] and x != 0", !x.hasZero());
+    }
+    return {};
+}
+
+std::vector<strength_hint> strengthHints(const signal_graph& g, const std::vector<interval>& R)
+{
+    std::vector<strength_hint> r;
+    for (int i = 0; i < g.size(); i++) {
+        const signal_graph::node& n = g[i];
+        strength_hint             h;
+        if (n.type == signal_graph::kind::unary) h = strengthHint(n.u, R[n.x]);
+        if (n.type == signal_graph::kind::binary) h = strengthHint(n.b, R[n.x], R[n.y]);
+        if (h.kind == reduction::none) continue;
+        h.node = i;
+        r.push_back(h);
+    }
+    return r;
+}
+
+std::ostream& operator<<(std::ostream& dst, const strength_hint& h)
+{
+    static const char* names[] = {"none", "shift", "ldexp", "mask", "multiplication chain", "truncating cast"};
+    dst << "node " << h.node << ": " << names[int(h.kind)] << ' ' << h.amount << ", " << h.obligation
+        << (h.proved ? " (proved)" : " (not proved)");
+    return dst;
+}
+
+void testStrengthReduction()
+{
+    using I = interval_algebra;
+
+    interval byte(0, 255, 0);
+    interval sym(-1, 1, -24);
+
+    strength_hint h = strengthHint(&I::Mul, byte, interval(8));
+    check("test strength Mul shift", (h.kind == reduction::shift) && (h.amount == 3) && h.proved, true);
+    h = strengthHint(&I::Mul, interval(0.25), sym);
+    check("test strength Mul ldexp", (h.kind == reduction::ldexp) && (h.amount == -2) && (h.argument == 1), true);
+    h = strengthHint(&I::Mul, interval(0, 1e10, 0), interval(2));
+    check("test strength Mul overflow", (h.kind == reduction::ldexp) && h.proved, true);
+    h = strengthHint(&I::Div, byte, interval(4));
+    check("test strength Div not multiple", (h.kind == reduction::ldexp) && (h.amount == -2) && h.proved, true);
+    h = strengthHint(&I::Div, interval(-8, 8, 2), interval(4));
+    check("test strength Div exact", (h.kind == reduction::shift) && (h.amount == -2) && h.proved, true);
+    h = strengthHint(&I::Mod, byte, interval(16));
+    check("test strength Mod mask", (h.kind == reduction::mask) && (h.amount == 15) && h.proved, true);
+    h = strengthHint(&I::Mod, interval(-8, 8, 0), interval(16));
+    check("test strength Mod negative", (h.kind == reduction::mask) && !h.proved, true);
+    h = strengthHint(&I::Mod, byte, interval(10));
+    check("test strength Mod 10", h.kind == reduction::none, true);
+    h = strengthHint(&I::Pow, sym, interval(3));
+    check("test strength Pow", (h.kind == reduction::mulchain) && (h.amount == 3) && h.proved, true);
+    h = strengthHint(&I::Pow, sym, interval(-2));
+    check("test strength Pow negative", (h.kind == reduction::mulchain) && !h.proved, true);
+    h = strengthHint(&I::Pow, sym, interval(0.5));
+    check("test strength Pow fractional", h.kind == reduction::none, true);
+    h = strengthHint(&I::Floor, interval(0, 100, -24));
+    check("test strength Floor", (h.kind == reduction::trunc) && h.proved, true);
+    h = strengthHint(&I::IntCast, sym);
+    check("test strength IntCast negative", (h.kind == reduction::trunc) && !h.proved, true);
+
+    // the index of a wavetable: int(phase * 1024) % 1024
+    signal_graph g;
+    int          p = g.input(interval(0, 1, -24));
+    int          i = g.unary(&I::IntCast, g.binary(&I::Mul, p, g.constant(1024)));
+    int          w = g.binary(&I::Mod, i, g.constant(1024));
+
+    std::vector<strength_hint> s = strengthHints(g, g.ranges(I()));
+    for (const strength_hint& e : s) testout() << e << '\n';
+    check("test strength graph", (s.size() == 3) && (s[2].node == w) && s[2].proved && s[1].proved, true);
+}
+
+}  // namespace itv
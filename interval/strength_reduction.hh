@@ -0,0 +1,61 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <iostream>
+#include <vector>
+
+#include "check.hh"
+#include "interval_def.hh"
+#include "signal_graph.hh"
+
+namespace itv {
+
+//==============================================================================
+// Strength reduction hints derived from the ranges.
+//
+// A hint proposes a cheaper equivalent of an operation with a constant
+// argument: a shift or an ldexp for Mul/Div by a power of 2, an And mask for
+// Mod by a power of 2, a chain of multiplications for Pow by a small integer,
+// a truncating cast for Floor/IntCast. Each hint comes with the obligation
+// making it sound (integer values, no overflow, a non-negative range, ...),
+// and the obligation is checked against the ranges of the arguments: only
+// the proved hints can be applied.
+//==============================================================================
+
+constexpr int kMaxChain = 8;  // largest exponent of Pow replaced by multiplications
+
+enum class reduction { none, shift, ldexp, mask, mulchain, trunc };
+
+struct strength_hint {
+    int         node{0};
+    reduction   kind{reduction::none};
+    int         amount{0};       ///< shift (left if positive), exponent of ldexp, mask, exponent of the chain
+    int         argument{0};     ///< the argument kept, 0 for x, 1 for y
+    const char* obligation{""};  ///< the condition making the reduction sound
+    bool        proved{false};   ///< the obligation holds for the ranges of the arguments
+};
+
+strength_hint strengthHint(umth m, const interval& x);
+strength_hint strengthHint(bmth m, const interval& x, const interval& y);
+
+// the hints for the nodes of g, for the ranges R of its nodes
+std::vector<strength_hint> strengthHints(const signal_graph& g, const std::vector<interval>& R);
+
+std::ostream& operator<<(std::ostream& dst, const strength_hint& h);
+
+void testStrengthReduction();
+
+}  // namespace itv
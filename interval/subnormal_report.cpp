@@ -0,0 +1,172 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+#include "check.hh"
+#include "interval_algebra.hh"
+#include "interval_def.hh"
+#include "signal_graph.hh"
+#include "subnormal_report.hh"
+
+namespace itv {
+
+// the smallest magnitude of the non-zero values of x: its bound nearest to 0, or the lsb when x contains 0
+static double minMagnitude(const interval& x)
+{
+    if (x.isEmpty() || x.isZero()) return HUGE_VAL;
+    if (x.lo() > 0) return x.lo();
+    if (x.hi() < 0) return -x.hi();
+    return std::ldexp(1.0, x.lsb());
+}
+
+// true when x meets ]-2^minExp,2^minExp[ with non-zero values of magnitude at least gap
+static bool reachesBelow(const interval& x, double gap, int minExp)
+{
+    double m = std::ldexp(1.0, minExp);
+    return !x.isEmpty() && (gap < m) && (x.lo() < m) && (x.hi() > -m);
+}
+
+bool reachesBelow(const interval& x, int minExp)
+{
+    return reachesBelow(x, minMagnitude(x), minExp);
+}
+
+// the smallest magnitude of the non-zero values of each node: the lsb of a product is the sum of the lsb of its
+// arguments, but the gap around 0 of x*c is the gap of x times |c|
+static std::vector<double> minMagnitudes(const signal_graph& g, const std::vector<interval>& R)
+{
+    std::vector<double> gap(size_t(g.size()));
+    for (int i = 0; i < g.size(); i++) {
+        const signal_graph::node& n = g[i];
+        gap[i]                      = minMagnitude(R[i]);
+        if (n.type == signal_graph::kind::constant) {
+            gap[i] = (n.value == 0) ? HUGE_VAL : std::fabs(n.value);
+        } else if ((n.type == signal_graph::kind::binary) && (n.b == &interval_algebra::Mul)) {
+            gap[i] = std::max(gap[i], gap[n.x] * gap[n.y]);
+        }
+    }
+    return gap;
+}
+
+// the feedback nodes node i depends on
+static std::vector<bool> dependencies(const signal_graph& g, int i)
+{
+    std::vector<bool> seen(size_t(g.size()), false);
+    std::vector<int>  todo{i};
+    while (!todo.empty()) {
+        int j = todo.back();
+        todo.pop_back();
+        if ((j < 0) || seen[j]) continue;
+        seen[j] = true;
+        todo.push_back(g[j].x);
+        todo.push_back(g[j].y);
+    }
+    return seen;
+}
+
+std::vector<subnormal_hazard> subnormalHazards(const signal_graph& g, int precision)
+{
+    std::vector<interval>         R = g.ranges(interval_algebra(precision));
+    std::vector<double>           gap = minMagnitudes(g, R);
+    std::vector<subnormal_hazard> h;
+    for (int i = 0; i < g.size(); i++) {
+        subnormal_hazard s;
+        s.node  = i;
+        s.range = R[i];
+        s.dbl   = reachesBelow(R[i], gap[i], DBL_MIN_EXP - 1);
+        s.flt   = reachesBelow(R[i], gap[i], FLT_MIN_EXP - 1);
+        if (!s.dbl && !s.flt) continue;
+        std::vector<bool> d = dependencies(g, i);
+        for (int j = 0; j < g.size(); j++) {
+            if (d[j] && (g[j].type == signal_graph::kind::feedback) &&
+                reachesBelow(R[j], gap[j], s.dbl ? DBL_MIN_EXP - 1 : FLT_MIN_EXP - 1)) {
+                s.loops.push_back(j);
+            }
+        }
+        h.push_back(s);
+    }
+    return h;
+}
+
+void printSubnormalHazards(std::ostream& dst, const std::vector<subnormal_hazard>& h)
+{
+    for (const subnormal_hazard& s : h) {
+        dst << "node " << s.node << ": " << s.range << ", subnormal " << (s.dbl ? "double and float" : "float");
+        if (s.loops.empty()) {
+            dst << ", without feedback";
+        } else {
+            dst << ", loops";
+            for (int f : s.loops) dst << ' ' << f;
+        }
+        dst << '\n';
+    }
+}
+
+static bool hazard(const std::vector<subnormal_hazard>& h, int i, subnormal_hazard& s)
+{
+    for (const subnormal_hazard& t : h) {
+        if (t.node == i) {
+            s = t;
+            return true;
+        }
+    }
+    return false;
+}
+
+void testSubnormalReport()
+{
+    using I = interval_algebra;
+
+    // a decaying one pole filter y = x + 0.5*y', a counter n = 1 + n', and a tiny gain
+    signal_graph g;
+    int          x = g.input(interval(-1, 1, -24));
+    int          f = g.feedback();
+    int          y = g.binary(&I::Add, x, g.binary(&I::Mul, g.constant(0.5), f));
+    g.loop(f, y);
+    int o = g.binary(&I::Mul, y, g.constant(2));
+    int c = g.feedback();
+    int n = g.binary(&I::Add, g.constant(1), c);
+    g.loop(c, n);
+    int t = g.binary(&I::Mul, x, g.constant(1e-300));  // every non-zero value is at least 2^-24*1e-300 > DBL_MIN
+    int u = g.binary(&I::Mul, x, g.constant(1e-310));
+
+    int                   iterations = 0;
+    std::vector<interval> R          = g.ranges(I(), &iterations);
+    testout() << "fixpoint in " << iterations << " iterations\n";
+    check("test subnormal fixpoint", R[y], interval(-2, 2));
+    check("test subnormal lsb", R[y].lsb() == kMinLSB, true);
+    check("test subnormal counter", (R[n].lsb() == 0) && (R[n].hi() >= 0x1p53), true);  // until c + 1 == c
+
+    std::vector<subnormal_hazard> h = subnormalHazards(g);
+    printSubnormalHazards(testout(), h);
+    subnormal_hazard s;
+    check("test subnormal filter", hazard(h, y, s) && s.dbl && s.flt, true);
+    check("test subnormal loop", s.loops == std::vector<int>{f}, true);
+    check("test subnormal output", hazard(h, o, s) && s.loops == std::vector<int>{f}, true);
+    check("test subnormal input", hazard(h, x, s), false);
+    check("test subnormal no loop", hazard(h, n, s), false);
+    check("test subnormal gain", hazard(h, t, s) && !s.dbl && s.flt, true);
+    check("test subnormal tiny gain", hazard(h, u, s) && s.dbl && s.loops.empty(), true);
+
+    check("test subnormal below", reachesBelow(interval(0, 1, -1074), -1022), true);
+    check("test subnormal zero", reachesBelow(interval(0, 0, -1074), -1022), false);
+    check("test subnormal far", reachesBelow(interval(1, 2, -1074), -1022), false);
+    check("test subnormal gap", reachesBelow(interval(-1, 1, -1000), -1022), false);
+}
+
+}  // namespace itv
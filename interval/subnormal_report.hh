@@ -0,0 +1,66 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <iostream>
+#include <vector>
+
+#include "interval_def.hh"
+#include "signal_graph.hh"
+
+namespace itv {
+
+//==============================================================================
+// Reachability of the subnormal numbers in a signal graph.
+//
+// A node can take non-zero values below DBL_MIN (resp. FLT_MIN) when its range
+// meets ]-DBL_MIN,DBL_MIN[ and the gap around 0 of its values is below DBL_MIN:
+// a lsb of at least -1022 (resp. -126) proves that every non-zero value is
+// normal. The gap of a product is the product of the gaps of its arguments (the
+// gap of a constant is its magnitude), which is larger than the 2^lsb of its
+// range when an argument is a small constant: x*1e-300 of lsb(x) = -24 is never
+// subnormal although its lsb is below -1022.
+// The ranges are the fixpoint computed by signal_graph::ranges(), so that the
+// decaying tails of the feedback loops (whose lsb decreases at each iteration
+// and is widened to kMinLSB) are found. The loops responsible for a hazard are
+// the hazardous feedback nodes the node depends on, through its arguments and
+// the nodes closing the loops; none for a hazard created without feedback.
+//==============================================================================
+
+struct subnormal_hazard {
+    int              node{0};
+    interval         range;
+    bool             dbl{false};  ///< can take subnormal double values
+    bool             flt{false};  ///< can take subnormal float values
+    std::vector<int> loops;       ///< the feedback nodes responsible
+};
+
+// true when x can contain non-zero values of magnitude below 2^minExp
+bool reachesBelow(const interval& x, int minExp);
+
+/**
+ * @brief The nodes of a graph that can take subnormal values.
+ *
+ * @param g the graph
+ * @param precision the precision of the algebra computing the ranges (the lsb
+ * of the transcendental functions)
+ */
+std::vector<subnormal_hazard> subnormalHazards(const signal_graph& g, int precision = -24);
+
+void printSubnormalHazards(std::ostream& dst, const std::vector<subnormal_hazard>& h);
+
+void testSubnormalReport();
+
+}  // namespace itv
@@ -0,0 +1,655 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <initializer_list>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "affine_algebra.hh"
+#include "check.hh"
+#include "taylor_algebra.hh"
+#include "taylor_model.hh"
+
+namespace itv {
+
+static constexpr double kSlack    = 4 * DBL_EPSILON;  // relative rounding error of a coefficient
+static constexpr size_t kMaxTerms = 64;               // the smallest monomials beyond are moved to the remainder
+static constexpr int    kMaxDegree = 8;
+
+bool taylor_algebra::budgetSpent() const
+{
+    return (fBudget.count() > 0) && (std::chrono::steady_clock::now() - fStart > fBudget);
+}
+
+//------------------------------------------------------------------------------------------
+// construction of the results
+
+// the model poly +/- rem, with at most kMaxTerms monomials
+taylor_model taylor_algebra::truncate(std::map<monomial, double> poly, double rem) const
+{
+    while (poly.size() > kMaxTerms) {
+        auto smallest = poly.begin();
+        for (auto i = poly.begin(); i != poly.end(); ++i) {
+            if (!i->first.empty() && (std::fabs(i->second) < std::fabs(smallest->second) || smallest->first.empty())) {
+                smallest = i;
+            }
+        }
+        rem += std::fabs(smallest->second);
+        poly.erase(smallest);
+    }
+    return {std::move(poly), rem * (1 + kSlack)};
+}
+
+taylor_model taylor_algebra::apply(umth m, const taylor_model& x) const
+{
+    return taylor_model::fromInterval((fAlgebra.*m)(x.toInterval()));
+}
+
+taylor_model taylor_algebra::apply(bmth m, const taylor_model& x, const taylor_model& y) const
+{
+    return taylor_model::fromInterval((fAlgebra.*m)(x.toInterval(), y.toInterval()));
+}
+
+// upper bound of |P| for the polynomial of x
+static double magnitude(const taylor_model& x)
+{
+    double lo, hi;
+    x.range(lo, hi);
+    return std::max(std::fabs(x.constant() + lo), std::fabs(x.constant() + hi)) * (1 + kSlack);
+}
+
+// a.x + b
+taylor_model taylor_algebra::scale(const taylor_model& x, double a, double b) const
+{
+    std::map<monomial, double> poly;
+    double                     err = 0;
+    for (const auto& [m, c] : x.poly()) {
+        poly[m] = a * c;
+        err += std::fabs(a * c);
+    }
+    poly[{}] += b;
+    err += std::fabs(poly[{}]);
+    if (poly[{}] == 0) poly.erase(monomial{});
+    return truncate(std::move(poly), std::fabs(a) * x.remainder() + kSlack * err);
+}
+
+/**
+ * @brief The model of f(x) from the Taylor coefficients f^(k)(c)/k!, k = 0..degree, of f
+ * at the constant term c of x, and the bound max|f^(degree+1)|/(degree+1)! of f on the
+ * range of x. The polynomial is evaluated by the Horner scheme on x-c. When the range of x
+ * is too wide for the expansion, the interval method m of f gives a tighter result.
+ */
+taylor_model taylor_algebra::expand(const taylor_model& x, const double* coefs, double lagrange, umth m) const
+{
+    taylor_model h = scale(x, 1, -x.constant());
+    double       b = magnitude(h) + h.remainder();  // |x-c| <= b
+
+    taylor_model r(coefs[fDegree]);
+    for (int k = fDegree - 1; k >= 0; k--) r = Add(Mul(r, h), FloatNum(coefs[k]));
+
+    double err = lagrange * std::pow(b, fDegree + 1);
+    for (int k = 0; k <= fDegree; k++) err += kSlack * std::fabs(coefs[k]) * std::pow(b, k);
+    r = truncate(r.poly(), r.remainder() + err);
+
+    interval f = (fAlgebra.*m)(x.toInterval());
+    return (f.size() < r.toInterval().size()) ? taylor_model::fromInterval(f) : r;
+}
+
+//------------------------------------------------------------------------------------------
+// polynomial methods
+
+taylor_model taylor_algebra::IntNum(int x) const
+{
+    return taylor_model(x);
+}
+
+taylor_model taylor_algebra::FloatNum(double x) const
+{
+    return taylor_model(x);
+}
+
+taylor_model taylor_algebra::Add(const taylor_model& x, const taylor_model& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return taylor_model(NAN);
+    if (!x.isBounded() || !y.isBounded()) return apply(&interval_algebra::Add, x, y);
+    std::map<monomial, double> poly = x.poly();
+    double                     err  = 0;
+    for (const auto& [m, c] : y.poly()) {
+        double& p = poly[m];
+        p += c;
+        err += std::fabs(p);
+        if (p == 0) poly.erase(m);
+    }
+    return truncate(std::move(poly), x.remainder() + y.remainder() + kSlack * err);
+}
+
+taylor_model taylor_algebra::Sub(const taylor_model& x, const taylor_model& y) const
+{
+    return Add(x, Neg(y));
+}
+
+taylor_model taylor_algebra::Neg(const taylor_model& x) const
+{
+    if (x.isEmpty()) return x;
+    std::map<monomial, double> poly = x.poly();
+    for (auto& [m, c] : poly) c = -c;
+    return {std::move(poly), x.remainder()};
+}
+
+taylor_model taylor_algebra::Mul(const taylor_model& x, const taylor_model& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return taylor_model(NAN);
+    if (!x.isBounded() || !y.isBounded() || budgetSpent()) return apply(&interval_algebra::Mul, x, y);
+
+    std::map<monomial, double> poly;
+    double                     err = 0;
+    for (const auto& [mx, cx] : x.poly()) {
+        for (const auto& [my, cy] : y.poly()) {
+            double p = cx * cy;
+            err += kSlack * std::fabs(p);
+            if (int(mx.size() + my.size()) > fDegree) {
+                err += std::fabs(p);  // a monomial is in [-1,1]
+                continue;
+            }
+            monomial m(mx.size() + my.size());
+            std::merge(mx.begin(), mx.end(), my.begin(), my.end(), m.begin());
+            poly[m] += p;
+        }
+    }
+    for (auto i = poly.begin(); i != poly.end();) i = (i->second == 0) ? poly.erase(i) : std::next(i);
+
+    // (Px + Rx)(Py + Ry) = Px.Py + Px.Ry + Py.Rx + Rx.Ry
+    double rx = x.remainder(), ry = y.remainder();
+    err += magnitude(x) * ry + magnitude(y) * rx + rx * ry;
+    return truncate(std::move(poly), err);
+}
+
+//------------------------------------------------------------------------------------------
+// Taylor expansions
+
+// range [lo,hi] of the values of x, not rounded
+static void bounds(const taylor_model& x, double& lo, double& hi)
+{
+    x.range(lo, hi);
+    double c = x.constant(), r = x.remainder() + kSlack * (std::fabs(c) + hi - lo);
+    lo       = c + lo - r;
+    hi       = c + hi + r;
+}
+
+static double factorial(int n)
+{
+    double f = 1;
+    for (int k = 2; k <= n; k++) f *= k;
+    return f;
+}
+
+taylor_model taylor_algebra::Exp(const taylor_model& x) const
+{
+    double lo, hi;
+    bounds(x, lo, hi);
+    if (!x.isBounded() || (hi > 700) || budgetSpent()) return apply(&interval_algebra::Exp, x);
+    double c = x.constant(), coefs[kMaxDegree + 1];
+    for (int k = 0; k <= fDegree; k++) coefs[k] = std::exp(c) / factorial(k);
+    return expand(x, coefs, std::exp(hi) / factorial(fDegree + 1), &interval_algebra::Exp);
+}
+
+taylor_model taylor_algebra::Log(const taylor_model& x) const
+{
+    double lo, hi;
+    bounds(x, lo, hi);
+    if (!x.isBounded() || (lo <= 0) || budgetSpent()) return apply(&interval_algebra::Log, x);
+    // log^(k)(c) / k! = (-1)^(k-1) / (k.c^k), |log^(n)| = (n-1)! / x^n
+    double c = x.constant(), coefs[kMaxDegree + 1];
+    coefs[0] = std::log(c);
+    for (int k = 1; k <= fDegree; k++) coefs[k] = ((k % 2 == 0) ? -1.0 : 1.0) / (k * std::pow(c, k));
+    return expand(x, coefs, 1 / ((fDegree + 1) * std::pow(lo, fDegree + 1)), &interval_algebra::Log);
+}
+
+taylor_model taylor_algebra::Inv(const taylor_model& x) const
+{
+    double lo, hi;
+    bounds(x, lo, hi);
+    if (!x.isBounded() || ((lo <= 0) && (hi >= 0)) || budgetSpent()) return apply(&interval_algebra::Inv, x);
+    // (1/x)^(k)(c) / k! = (-1)^k / c^(k+1), |(1/x)^(n)| = n! / |x|^(n+1)
+    double c = x.constant(), coefs[kMaxDegree + 1];
+    for (int k = 0; k <= fDegree; k++) coefs[k] = ((k % 2 == 0) ? 1.0 : -1.0) / std::pow(c, k + 1);
+    double m = std::min(std::fabs(lo), std::fabs(hi));
+    return expand(x, coefs, 1 / std::pow(m, fDegree + 2), &interval_algebra::Inv);
+}
+
+taylor_model taylor_algebra::Sqrt(const taylor_model& x) const
+{
+    double lo, hi;
+    bounds(x, lo, hi);
+    if (!x.isBounded() || (lo <= 0) || budgetSpent()) return apply(&interval_algebra::Sqrt, x);
+    // sqrt^(k)(c) / k! = binomial(1/2, k) . c^(1/2-k), maximal on the range at lo
+    double c = x.constant(), coefs[kMaxDegree + 2];
+    double binomial = 1;
+    for (int k = 0; k <= fDegree + 1; k++) {
+        coefs[k] = binomial * std::pow(c, 0.5 - k);
+        binomial *= (0.5 - k) / (k + 1);
+    }
+    double n        = fDegree + 1;
+    double lagrange = std::fabs(coefs[fDegree + 1] / std::pow(c, 0.5 - n)) * std::pow(lo, 0.5 - n);
+    return expand(x, coefs, lagrange, &interval_algebra::Sqrt);
+}
+
+taylor_model taylor_algebra::Sin(const taylor_model& x) const
+{
+    if (!x.isBounded() || budgetSpent()) return apply(&interval_algebra::Sin, x);
+    // the derivatives of sin cycle through sin, cos, -sin, -cos, all bounded by 1 (c + k.pi/2 would be rounded)
+    double c = x.constant(), coefs[kMaxDegree + 1];
+    double d[4]{std::sin(c), std::cos(c), -std::sin(c), -std::cos(c)};
+    for (int k = 0; k <= fDegree; k++) coefs[k] = d[k % 4] / factorial(k);
+    return expand(x, coefs, 1 / factorial(fDegree + 1), &interval_algebra::Sin);
+}
+
+taylor_model taylor_algebra::Cos(const taylor_model& x) const
+{
+    if (!x.isBounded() || budgetSpent()) return apply(&interval_algebra::Cos, x);
+    double c = x.constant(), coefs[kMaxDegree + 1];
+    double d[4]{std::cos(c), -std::sin(c), -std::cos(c), std::sin(c)};
+    for (int k = 0; k <= fDegree; k++) coefs[k] = d[k % 4] / factorial(k);
+    return expand(x, coefs, 1 / factorial(fDegree + 1), &interval_algebra::Cos);
+}
+
+//------------------------------------------------------------------------------------------
+// compositions
+
+taylor_model taylor_algebra::Div(const taylor_model& x, const taylor_model& y) const
+{
+    return Mul(x, Inv(y));
+}
+
+// the polynomials P_n such that tanh^(n)(x) = P_n(tanh(x)): P_0(t) = t and P_n+1 = P_n'.(1 - t^2)
+static std::vector<std::vector<double>> tanhDerivatives(int n)
+{
+    std::vector<std::vector<double>> P{{0, 1}};
+    for (int k = 0; k < n; k++) {
+        const auto&         p = P.back();
+        std::vector<double> q(p.size() + 1, 0.0);
+        for (size_t i = 1; i < p.size(); i++) {
+            q[i - 1] += i * p[i];
+            q[i + 1] -= i * p[i];
+        }
+        P.push_back(q);
+    }
+    return P;
+}
+
+taylor_model taylor_algebra::Tanh(const taylor_model& x) const
+{
+    if (!x.isBounded() || budgetSpent()) return apply(&interval_algebra::Tanh, x);
+    double lo, hi;
+    bounds(x, lo, hi);
+
+    auto   P = tanhDerivatives(fDegree + 1);
+    double t = std::tanh(x.constant()), coefs[kMaxDegree + 1];
+    for (int k = 0; k <= fDegree; k++) {
+        double v = 0;
+        for (size_t i = P[k].size(); i-- > 0;) v = v * t + P[k][i];
+        coefs[k] = v / factorial(k);
+    }
+    // |P_n(t)| <= sum |p_i|.m^i for |t| <= m on the range of x
+    double m = std::max(std::fabs(std::tanh(lo)), std::fabs(std::tanh(hi))), bound = 0;
+    for (size_t i = 0; i < P[fDegree + 1].size(); i++) bound += std::fabs(P[fDegree + 1][i]) * std::pow(m, i);
+    return expand(x, coefs, bound / factorial(fDegree + 1), &interval_algebra::Tanh);
+}
+
+taylor_model taylor_algebra::WrTbl(const taylor_model& n, const taylor_model& init,
+                                   const taylor_model& index, const taylor_model& value) const
+{
+    return taylor_model::fromInterval(
+        fAlgebra.WrTbl(n.toInterval(), init.toInterval(), index.toInterval(), value.toInterval()));
+}
+
+taylor_model taylor_algebra::Sinh(const taylor_model& x) const
+{
+    double lo, hi;
+    bounds(x, lo, hi);
+    if (!x.isBounded() || (std::max(-lo, hi) > 700) || budgetSpent()) return apply(&interval_algebra::Sinh, x);
+    return scale(Sub(Exp(x), Exp(Neg(x))), 0.5, 0);
+}
+
+taylor_model taylor_algebra::Cosh(const taylor_model& x) const
+{
+    double lo, hi;
+    bounds(x, lo, hi);
+    if (!x.isBounded() || (std::max(-lo, hi) > 700) || budgetSpent()) return apply(&interval_algebra::Cosh, x);
+    return scale(Add(Exp(x), Exp(Neg(x))), 0.5, 0);
+}
+
+taylor_model taylor_algebra::Tan(const taylor_model& x) const
+{
+    // Inv falls back to the intervals when the cosine can be 0
+    return Mul(Sin(x), Inv(Cos(x)));
+}
+
+taylor_model taylor_algebra::Log10(const taylor_model& x) const
+{
+    double lo, hi;
+    bounds(x, lo, hi);
+    if (!x.isBounded() || (lo <= 0)) return apply(&interval_algebra::Log10, x);
+    return scale(Log(x), 1 / M_LN10, 0);
+}
+
+taylor_model taylor_algebra::Pow(const taylor_model& x, const taylor_model& y) const
+{
+    // x^y = exp(y.log(x)) for x > 0
+    double lo, hi;
+    bounds(x, lo, hi);
+    if (!x.isBounded() || !y.isBounded() || (lo <= 0)) return apply(&interval_algebra::Pow, x, y);
+    return Exp(Mul(y, Log(x)));
+}
+
+// the values read at different indices are independent, the summary of the table gets a fresh symbol
+taylor_model taylor_algebra::RdTbl(const taylor_model& tbl, const taylor_model& index) const
+{
+    return apply(&interval_algebra::RdTbl, tbl, index);
+}
+
+//------------------------------------------------------------------------------------------
+// methods computed on the ranges of the arguments
+
+taylor_model taylor_algebra::Label(const std::string& x) const
+{
+    return taylor_model::fromInterval(fAlgebra.Label(x));
+}
+
+taylor_model taylor_algebra::Button(const taylor_model& name) const
+{
+    return apply(&interval_algebra::Button, name);
+}
+
+taylor_model taylor_algebra::Checkbox(const taylor_model& name) const
+{
+    return apply(&interval_algebra::Checkbox, name);
+}
+
+taylor_model taylor_algebra::VSlider(const taylor_model& name, const taylor_model& init, const taylor_model& lo,
+                                     const taylor_model& hi, const taylor_model& step) const
+{
+    return taylor_model::fromInterval(
+        fAlgebra.VSlider(name.toInterval(), init.toInterval(), lo.toInterval(), hi.toInterval(), step.toInterval()));
+}
+
+taylor_model taylor_algebra::HSlider(const taylor_model& name, const taylor_model& init, const taylor_model& lo,
+                                     const taylor_model& hi, const taylor_model& step) const
+{
+    return taylor_model::fromInterval(
+        fAlgebra.HSlider(name.toInterval(), init.toInterval(), lo.toInterval(), hi.toInterval(), step.toInterval()));
+}
+
+taylor_model taylor_algebra::NumEntry(const taylor_model& name, const taylor_model& init, const taylor_model& lo,
+                                      const taylor_model& hi, const taylor_model& step) const
+{
+    return taylor_model::fromInterval(
+        fAlgebra.NumEntry(name.toInterval(), init.toInterval(), lo.toInterval(), hi.toInterval(), step.toInterval()));
+}
+
+taylor_model taylor_algebra::Abs(const taylor_model& x) const
+{
+    return apply(&interval_algebra::Abs, x);
+}
+
+taylor_model taylor_algebra::Mod(const taylor_model& x, const taylor_model& y) const
+{
+    return apply(static_cast<bmth>(&interval_algebra::Mod), x, y);
+}
+
+taylor_model taylor_algebra::Acos(const taylor_model& x) const
+{
+    return apply(&interval_algebra::Acos, x);
+}
+
+taylor_model taylor_algebra::Acosh(const taylor_model& x) const
+{
+    return apply(&interval_algebra::Acosh, x);
+}
+
+taylor_model taylor_algebra::And(const taylor_model& x, const taylor_model& y) const
+{
+    return apply(&interval_algebra::And, x, y);
+}
+
+taylor_model taylor_algebra::Asin(const taylor_model& x) const
+{
+    return apply(&interval_algebra::Asin, x);
+}
+
+taylor_model taylor_algebra::Asinh(const taylor_model& x) const
+{
+    return apply(&interval_algebra::Asinh, x);
+}
+
+taylor_model taylor_algebra::Atan(const taylor_model& x) const
+{
+    return apply(&interval_algebra::Atan, x);
+}
+
+taylor_model taylor_algebra::Atan2(const taylor_model& x, const taylor_model& y) const
+{
+    return apply(&interval_algebra::Atan2, x, y);
+}
+
+taylor_model taylor_algebra::Atanh(const taylor_model& x) const
+{
+    return apply(&interval_algebra::Atanh, x);
+}
+
+taylor_model taylor_algebra::Ceil(const taylor_model& x) const
+{
+    return apply(&interval_algebra::Ceil, x);
+}
+
+taylor_model taylor_algebra::Delay(const taylor_model& x, const taylor_model& y) const
+{
+    return apply(&interval_algebra::Delay, x, y);
+}
+
+taylor_model taylor_algebra::Eq(const taylor_model& x, const taylor_model& y) const
+{
+    return apply(&interval_algebra::Eq, x, y);
+}
+
+taylor_model taylor_algebra::FloatCast(const taylor_model& x) const
+{
+    return apply(&interval_algebra::FloatCast, x);
+}
+
+taylor_model taylor_algebra::Floor(const taylor_model& x) const
+{
+    return apply(&interval_algebra::Floor, x);
+}
+
+taylor_model taylor_algebra::Ge(const taylor_model& x, const taylor_model& y) const
+{
+    return apply(&interval_algebra::Ge, x, y);
+}
+
+taylor_model taylor_algebra::Gt(const taylor_model& x, const taylor_model& y) const
+{
+    return apply(&interval_algebra::Gt, x, y);
+}
+
+taylor_model taylor_algebra::IntCast(const taylor_model& x) const
+{
+    return apply(&interval_algebra::IntCast, x);
+}
+
+taylor_model taylor_algebra::Le(const taylor_model& x, const taylor_model& y) const
+{
+    return apply(&interval_algebra::Le, x, y);
+}
+
+taylor_model taylor_algebra::Lsh(const taylor_model& x, const taylor_model& y) const
+{
+    return apply(&interval_algebra::Lsh, x, y);
+}
+
+taylor_model taylor_algebra::Lt(const taylor_model& x, const taylor_model& y) const
+{
+    return apply(&interval_algebra::Lt, x, y);
+}
+
+taylor_model taylor_algebra::Max(const taylor_model& x, const taylor_model& y) const
+{
+    return apply(&interval_algebra::Max, x, y);
+}
+
+taylor_model taylor_algebra::Mem(const taylor_model& x) const
+{
+    return apply(&interval_algebra::Mem, x);
+}
+
+taylor_model taylor_algebra::Min(const taylor_model& x, const taylor_model& y) const
+{
+    return apply(&interval_algebra::Min, x, y);
+}
+
+taylor_model taylor_algebra::Ne(const taylor_model& x, const taylor_model& y) const
+{
+    return apply(&interval_algebra::Ne, x, y);
+}
+
+taylor_model taylor_algebra::Not(const taylor_model& x) const
+{
+    return apply(&interval_algebra::Not, x);
+}
+
+taylor_model taylor_algebra::Or(const taylor_model& x, const taylor_model& y) const
+{
+    return apply(&interval_algebra::Or, x, y);
+}
+
+taylor_model taylor_algebra::Remainder(const taylor_model& x) const
+{
+    return apply(&interval_algebra::Remainder, x);
+}
+
+taylor_model taylor_algebra::Rint(const taylor_model& x) const
+{
+    return apply(&interval_algebra::Rint, x);
+}
+
+taylor_model taylor_algebra::Rsh(const taylor_model& x, const taylor_model& y) const
+{
+    return apply(&interval_algebra::Rsh, x, y);
+}
+
+// a single reachable branch is kept with its noise symbols, several ones are gathered in their hull
+static taylor_model select(unsigned b, std::initializer_list<const taylor_model*> branches)
+{
+    interval r(NAN, NAN);
+    int      n = 0, last = 0;
+    for (int i = 0; i < int(branches.size()); i++) {
+        if ((b & (1U << i)) == 0) continue;
+        r    = reunion(r, branches.begin()[i]->toInterval());
+        last = i;
+        n++;
+    }
+    return (n == 1) ? *branches.begin()[last] : taylor_model::fromInterval(r);
+}
+
+taylor_model taylor_algebra::Select2(const taylor_model& s, const taylor_model& x, const taylor_model& y) const
+{
+    return select(fAlgebra.selectBranches(s.toInterval(), 2), {&x, &y});
+}
+
+taylor_model taylor_algebra::Select3(const taylor_model& s, const taylor_model& x, const taylor_model& y,
+                                     const taylor_model& z) const
+{
+    return select(fAlgebra.selectBranches(s.toInterval(), 3), {&x, &y, &z});
+}
+
+taylor_model taylor_algebra::Xor(const taylor_model& x, const taylor_model& y) const
+{
+    return apply(&interval_algebra::Xor, x, y);
+}
+
+//------------------------------------------------------------------------------------------
+// tests
+
+void testTaylor()
+{
+    taylor_algebra   T;
+    interval_algebra I;
+    affine_algebra   A;
+
+    taylor_model x = taylor_model::fromInterval(interval(0, 1));
+    interval     u = x.toInterval();
+    check("test taylor fromInterval", u.has(0) && u.has(1) && (u.size() < 1 + 1e-6), true);
+
+    // x*(1-x) on [0,1] is [0,1/4], exactly represented by a polynomial of degree 2
+    interval p = T.Mul(x, T.Sub(T.FloatNum(1), x)).toInterval();
+    check("test taylor Mul", (p.lo() <= 0) && (p.hi() >= 0.25) && (p.size() < 0.5), true);
+
+    // exp(log(x)) on [1,2], at degree 5
+    taylor_algebra T5(5);
+    taylor_model   y = taylor_model::fromInterval(interval(1, 2));
+    interval       e = T5.Exp(T5.Log(y)).toInterval();
+    testout() << "exp(log([1,2])): taylor " << e << ", interval " << I.Exp(I.Log(interval(1, 2))) << '\n';
+    check("test taylor Exp(Log)", (e.lo() <= 1) && (e.hi() >= 2) && (e.size() < 1.02), true);
+
+    // a sine oscillator phase x.(1-x) is tighter than with intervals and affine forms
+    interval s = T.Sin(T.Mul(x, T.Sub(T.FloatNum(1), x))).toInterval();
+    interval a = A.Sin(A.Mul(affine_form::fromInterval(interval(0, 1)),
+                             A.Sub(A.FloatNum(1), affine_form::fromInterval(interval(0, 1)))))
+                     .toInterval();
+    testout() << "sin(x(1-x)): taylor " << s << ", affine " << a << '\n';
+    check("test taylor Sin contains", (s.lo() <= 0) && (s.hi() >= std::sin(0.25)), true);
+    check("test taylor Sin tight", s.hi() < 0.3, true);
+
+    // around a large constant, where c + k.pi/2 isn't exact
+    taylor_model w  = taylor_model::fromInterval(interval(1e6, 1e6 + 0.5));
+    interval     sw = T.Sin(w).toInterval();
+    interval     cw = T.Cos(w).toInterval();
+    bool         in = true;
+    for (int k = 0; k <= 64; k++) {
+        double v = 1e6 + k / 128.0;
+        in       = in && sw.has(std::sin(v)) && cw.has(std::cos(v));
+    }
+    check("test taylor Sin Cos large", in, true);
+
+    // tanh(x - x/2) on [-1,1]
+    taylor_model z = taylor_model::fromInterval(interval(-1, 1));
+    interval     t = T.Tanh(T.Sub(z, T.Mul(z, T.FloatNum(0.5)))).toInterval();
+    check("test taylor Tanh", (t.lo() <= std::tanh(-0.5)) && (t.hi() >= std::tanh(0.5)) && (t.hi() < 0.6), true);
+
+    // the degree and the time budget
+    taylor_algebra T1(1);
+    check("test taylor degree", T1.Mul(x, x).poly().size() <= 2, true);
+    taylor_algebra T0(3, std::chrono::microseconds(1));
+    while (!T0.budgetSpent()) {
+    }
+    check("test taylor budget", T0.Exp(x).toInterval().size() >= I.Exp(interval(0, 1)).size(), true);
+
+    // a single reachable branch keeps its polynomial
+    check("test taylor Select2", T.Sub(T.Select2(T.FloatNum(3), T.FloatNum(5), x), x).toInterval().size() < 1e-12,
+          true);
+    taylor_model sel = T.Select3(taylor_model::fromInterval(interval(1, 2, 0)), x, x, T.FloatNum(7));
+    check("test taylor Select3", sel.toInterval().has(7), true);
+
+    // two reads of a table are independent values
+    taylor_model tbl = T.WrTbl(T.FloatNum(8), T.FloatNum(0), taylor_model::fromInterval(interval(0, 7, 0)), x);
+    taylor_model idx = taylor_model::fromInterval(interval(0, 7, 0));
+    check("test taylor RdTbl", T.Sub(T.RdTbl(tbl, idx), T.RdTbl(tbl, idx)).toInterval().has(1), true);
+}
+
+}  // namespace itv
@@ -0,0 +1,130 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <chrono>
+#include <string>
+
+#include "check.hh"
+#include "faust_algebra.hh"
+#include "interval_algebra.hh"
+#include "taylor_model.hh"
+
+namespace itv {
+
+// The faust algebra on Taylor models. The polynomial operations are computed
+// up to the degree of the algebra, the monomials of higher degree are moved to
+// the remainder. Exp, Log, Sin, Cos, Tanh, Inv and Sqrt are expanded at the
+// constant term of their argument with a Lagrange bound of the remainder, and
+// Div, Sinh, Cosh, Tan, Log10 and Pow are composed from them. The other methods, and
+// all of them once the time budget is spent, are computed by interval_algebra
+// on the ranges of their arguments.
+//
+// The models are meant for the subgraphs where intervals and affine forms
+// overestimate: oscillators, waveshapers, chains of transcendental functions.
+class taylor_algebra : public faust_algebra<taylor_model> {
+   private:
+    interval_algebra                      fAlgebra;
+    int                                   fDegree;  ///< maximal degree of the polynomials
+    std::chrono::steady_clock::duration   fBudget;  ///< time allowed since the start, 0 for no limit
+    std::chrono::steady_clock::time_point fStart;
+
+   public:
+    explicit taylor_algebra(int degree = 3, std::chrono::microseconds budget = std::chrono::microseconds(0))
+        : fDegree(std::clamp(degree, 1, 8)), fBudget(budget), fStart(std::chrono::steady_clock::now())
+    {
+    }
+
+    int  degree() const { return fDegree; }
+    void restartBudget() { fStart = std::chrono::steady_clock::now(); }
+    bool budgetSpent() const;
+
+    taylor_model Label(const std::string& x) const;
+    taylor_model IntNum(int x) const;
+    taylor_model FloatNum(double x) const;
+    taylor_model Button(const taylor_model& name) const;
+    taylor_model Checkbox(const taylor_model& name) const;
+    taylor_model VSlider(const taylor_model& name, const taylor_model& init, const taylor_model& lo,
+                         const taylor_model& hi, const taylor_model& step) const;
+    taylor_model HSlider(const taylor_model& name, const taylor_model& init, const taylor_model& lo,
+                         const taylor_model& hi, const taylor_model& step) const;
+    taylor_model NumEntry(const taylor_model& name, const taylor_model& init, const taylor_model& lo,
+                          const taylor_model& hi, const taylor_model& step) const;
+    taylor_model Abs(const taylor_model& x) const;
+    taylor_model Add(const taylor_model& x, const taylor_model& y) const;
+    taylor_model Sub(const taylor_model& x, const taylor_model& y) const;
+    taylor_model Mul(const taylor_model& x, const taylor_model& y) const;
+    taylor_model Div(const taylor_model& x, const taylor_model& y) const;
+    taylor_model Inv(const taylor_model& x) const;
+    taylor_model Neg(const taylor_model& x) const;
+    taylor_model Mod(const taylor_model& x, const taylor_model& y) const;
+    taylor_model Acos(const taylor_model& x) const;
+    taylor_model Acosh(const taylor_model& x) const;
+    taylor_model And(const taylor_model& x, const taylor_model& y) const;
+    taylor_model Asin(const taylor_model& x) const;
+    taylor_model Asinh(const taylor_model& x) const;
+    taylor_model Atan(const taylor_model& x) const;
+    taylor_model Atan2(const taylor_model& x, const taylor_model& y) const;
+    taylor_model Atanh(const taylor_model& x) const;
+    taylor_model Ceil(const taylor_model& x) const;
+    taylor_model Cos(const taylor_model& x) const;
+    taylor_model Cosh(const taylor_model& x) const;
+    taylor_model Delay(const taylor_model& x, const taylor_model& y) const;
+    taylor_model Eq(const taylor_model& x, const taylor_model& y) const;
+    taylor_model Exp(const taylor_model& x) const;
+    taylor_model FloatCast(const taylor_model& x) const;
+    taylor_model Floor(const taylor_model& x) const;
+    taylor_model Ge(const taylor_model& x, const taylor_model& y) const;
+    taylor_model Gt(const taylor_model& x, const taylor_model& y) const;
+    taylor_model IntCast(const taylor_model& x) const;
+    taylor_model Le(const taylor_model& x, const taylor_model& y) const;
+    taylor_model Log(const taylor_model& x) const;
+    taylor_model Log10(const taylor_model& x) const;
+    taylor_model Lsh(const taylor_model& x, const taylor_model& y) const;
+    taylor_model Lt(const taylor_model& x, const taylor_model& y) const;
+    taylor_model Max(const taylor_model& x, const taylor_model& y) const;
+    taylor_model Mem(const taylor_model& x) const;
+    taylor_model Min(const taylor_model& x, const taylor_model& y) const;
+    taylor_model Ne(const taylor_model& x, const taylor_model& y) const;
+    taylor_model Not(const taylor_model& x) const;
+    taylor_model Or(const taylor_model& x, const taylor_model& y) const;
+    taylor_model Pow(const taylor_model& x, const taylor_model& y) const;
+    taylor_model RdTbl(const taylor_model& tbl, const taylor_model& index) const;
+    taylor_model Remainder(const taylor_model& x) const;
+    taylor_model Rint(const taylor_model& x) const;
+    taylor_model Rsh(const taylor_model& x, const taylor_model& y) const;
+    taylor_model Select2(const taylor_model& s, const taylor_model& x, const taylor_model& y) const;
+    taylor_model Select3(const taylor_model& s, const taylor_model& x, const taylor_model& y,
+                         const taylor_model& z) const;
+    taylor_model Sin(const taylor_model& x) const;
+    taylor_model Sinh(const taylor_model& x) const;
+    taylor_model Sqrt(const taylor_model& x) const;
+    taylor_model Tan(const taylor_model& x) const;
+    taylor_model Tanh(const taylor_model& x) const;
+    taylor_model WrTbl(const taylor_model& n, const taylor_model& init,
+                       const taylor_model& index, const taylor_model& value) const;
+    taylor_model Xor(const taylor_model& x, const taylor_model& y) const;
+
+   private:
+    taylor_model truncate(std::map<monomial, double> poly, double rem) const;
+    taylor_model expand(const taylor_model& x, const double* coefs, double lagrange, umth m) const;
+    taylor_model scale(const taylor_model& x, double a, double b) const;
+    taylor_model apply(umth m, const taylor_model& x) const;
+    taylor_model apply(bmth m, const taylor_model& x, const taylor_model& y) const;
+};
+
+void testTaylor();
+
+}  // namespace itv
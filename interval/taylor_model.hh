@@ -0,0 +1,143 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "affine_form.hh"
+#include "interval_def.hh"
+
+// ***************************************************************************
+//
+//     A taylor_model is a polynomial P of variables ranging independently over
+//     [-1,1], plus a remainder interval [-r,r]: it represents the values
+//     P(v1,...,vn) + e with |e| <= r. A monomial is the sorted list of its
+//     variables, repeated according to their powers: v1^2.v3 is {1,1,3} and
+//     the constant term is {}. The variables are identified like the noise
+//     symbols of the affine forms, and an input interval is c + r.v for a
+//     fresh variable v. An empty model has a NAN remainder.
+//
+//****************************************************************************
+namespace itv {
+
+using monomial = std::vector<uint64_t>;
+
+class taylor_model {
+   private:
+    std::map<monomial, double> fPoly;       ///< coefficients of the monomials, without zeroes
+    double                     fRem{0};     ///< radius of the remainder
+
+   public:
+    taylor_model() = default;  // 0
+
+    explicit taylor_model(double c)
+    {
+        if (std::isnan(c)) {
+            fRem = NAN;
+        } else if (c != 0) {
+            fPoly[{}] = c;
+        }
+    }
+
+    taylor_model(std::map<monomial, double> poly, double rem) : fPoly(std::move(poly)), fRem(rem) {}
+
+    static taylor_model fromInterval(const interval& x)
+    {
+        if (x.isEmpty()) return taylor_model(NAN);
+        if (x.isUnbounded()) return {{}, HUGE_VAL};
+        double       c = x.lo() + (x.hi() - x.lo()) / 2;
+        double       r = std::max(c - x.lo(), x.hi() - c);
+        taylor_model m(c);
+        if (r > 0) m.fPoly[{newNoiseSymbol()}] = r;
+        return m;
+    }
+
+    const std::map<monomial, double>& poly() const { return fPoly; }
+    double                            remainder() const { return fRem; }
+
+    double constant() const
+    {
+        auto c = fPoly.find({});
+        return (c == fPoly.end()) ? 0.0 : c->second;
+    }
+
+    bool isEmpty() const { return std::isnan(fRem); }
+
+    bool isBounded() const
+    {
+        if (isEmpty() || !std::isfinite(fRem)) return false;
+        for (const auto& [m, c] : fPoly) {
+            if (!std::isfinite(c)) return false;
+        }
+        return true;
+    }
+
+    // a monomial with only even powers is in [0,1], the others are in [-1,1]
+    static bool isEven(const monomial& m)
+    {
+        for (size_t i = 0; i < m.size(); i++) {
+            size_t j = i;
+            while ((j < m.size()) && (m[j] == m[i])) j++;
+            if ((j - i) % 2 != 0) return false;
+            i = j - 1;
+        }
+        return true;
+    }
+
+    // bounds of the non constant part of the polynomial, not rounded
+    void range(double& lo, double& hi) const
+    {
+        lo = hi = 0;
+        for (const auto& [m, c] : fPoly) {
+            if (m.empty()) continue;
+            lo += isEven(m) ? std::min(0.0, c) : -std::fabs(c);
+            hi += isEven(m) ? std::max(0.0, c) : std::fabs(c);
+        }
+    }
+
+    // the interval of the values of the model, rounded outward
+    interval toInterval() const
+    {
+        if (isEmpty()) return {NAN, NAN};
+        if (!isBounded()) return {-HUGE_VAL, HUGE_VAL};
+        double lo, hi;
+        range(lo, hi);
+        double c     = constant();
+        double slack = 4 * DBL_EPSILON * (std::fabs(c) + hi - lo);
+        double h     = c + hi + fRem + slack;
+        interval x(c + lo - fRem - slack, h);
+        return (x.hi() < h) ? interval(x.lo(), h + std::ldexp(1.0, x.lsb())) : x;
+    }
+};
+
+inline std::ostream& operator<<(std::ostream& dst, const taylor_model& x)
+{
+    if (x.isEmpty()) return dst << "taylor_model()";
+    dst << "taylor_model(" << x.constant();
+    for (const auto& [m, c] : x.poly()) {
+        if (m.empty()) continue;
+        dst << (c < 0 ? " - " : " + ") << std::fabs(c);
+        for (auto v : m) dst << ".v" << v;
+    }
+    return dst << " +/- " << x.remainder() << ')';
+}
+
+}  // namespace itv
@@ -0,0 +1,234 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "check.hh"
+#include "error_algebra.hh"
+#include "interval_algebra.hh"
+#include "interval_def.hh"
+#include "signal_graph.hh"
+#include "wordlength.hh"
+
+namespace itv {
+
+//------------------------------------------------------------------------------------------
+// error propagation
+
+static double mag(const interval& x)
+{
+    return std::max(std::fabs(x.lo()), std::fabs(x.hi()));
+}
+
+// the symmetric error interval [-e,e]
+static interval sym(double e)
+{
+    return {-e, e, kMinLSB};
+}
+
+//------------------------------------------------------------------------------------------
+// evaluation of an assignment of lsb
+
+struct wl_eval {
+    const signal_graph&   g;
+    interval_algebra      A{kMinLSB};
+    error_algebra         EA{kMinLSB};
+    std::vector<interval> range;  // exact range of each node, after A
+
+    explicit wl_eval(const signal_graph& graph) : g(graph), range(graph.ranges(A)) {}
+
+    // lsb of the exact result of node i, for the lsb L of its arguments
+    int exact(const std::vector<int>& L, int i) const
+    {
+        const signal_graph::node& n = g[i];
+        auto                      q = [&](int j) { return interval(range[j].lo(), range[j].hi(), L[j]); };
+        switch (n.type) {
+            case signal_graph::kind::input: return n.range.lsb();
+            case signal_graph::kind::constant: return exactLSB(n.value);
+            case signal_graph::kind::unary: return (A.*n.u)(q(n.x)).lsb();
+            default: return (A.*n.b)(q(n.x), q(n.y)).lsb();
+        }
+    }
+
+    // error of node i rounded to L[i], from the errors E of the previous nodes
+    double error(const std::vector<int>& L, const std::vector<double>& E, int i) const
+    {
+        const signal_graph::node& n = g[i];
+        if (n.type == signal_graph::kind::input) return n.error;
+        if (n.type == signal_graph::kind::constant) {
+            double u = std::ldexp(1.0, L[i]);
+            return std::fabs(n.value - std::rint(n.value / u) * u);
+        }
+        double e = mag((n.type == signal_graph::kind::unary)
+                           ? EA.propagate(n.u, range[n.x], sym(E[n.x]))
+                           : EA.propagate(n.b, range[n.x], sym(E[n.x]), range[n.y], sym(E[n.y])));
+        return (L[i] > exact(L, i)) ? e + std::ldexp(1.0, L[i] - 1) : e;
+    }
+
+    // msb of node i, and its word length with the sign bit, 64 for unbounded values
+    int msb(const std::vector<double>& E, int i) const
+    {
+        double m = mag(range[i]) + E[i];
+        return (m > 0) && std::isfinite(m) ? int(std::floor(std::log2(m))) : INT_MIN;
+    }
+
+    int bits(const std::vector<int>& L, const std::vector<double>& E, int i) const
+    {
+        double m = mag(range[i]) + E[i];
+        if (!std::isfinite(m)) return 64;
+        if (m == 0) return 0;
+        int sign = (range[i].lo() - E[i] < 0) ? 1 : 0;
+        return std::max(0, msb(E, i) - L[i] + 1) + sign;
+    }
+
+    int bits(const std::vector<int>& L, const std::vector<double>& E) const
+    {
+        int b = 0;
+        for (int i = 0; i < g.size(); i++) {
+            if (g[i].type != signal_graph::kind::input) b += bits(L, E, i);
+        }
+        return b;
+    }
+};
+
+// run task(i) for i in [0,count[ on several threads
+static void parallelFor(int count, unsigned int threads, const std::function<void(int)>& task)
+{
+    if (threads == 0) threads = std::max(1U, std::thread::hardware_concurrency());
+    threads = std::min(threads, unsigned(std::max(count, 1)));
+
+    std::atomic<int>         next{0};
+    std::vector<std::thread> workers;
+    auto                     work = [&]() {
+        for (int i = next++; i < count; i = next++) task(i);
+    };
+    for (unsigned int t = 1; t < threads; t++) workers.emplace_back(work);
+    work();
+    for (auto& w : workers) w.join();
+}
+
+wl_result optimizeWordLengths(const signal_graph& g, int output, double budget, int start, unsigned int threads)
+{
+    if (g.hasFeedback()) return {};  // infeasible, the errors are propagated in a single pass
+    wl_eval           ev(g);
+    std::atomic<long> evaluations{0};
+    int               N = g.size();
+
+    // the initial assignment: start, or the exact lsb of the results when it is coarser
+    std::vector<int>    L(size_t(N), start);
+    std::vector<double> E(size_t(N), 0.0);
+    for (int i = 0; i < N; i++) {
+        if (g[i].type == signal_graph::kind::input) L[i] = g[i].range.lsb();
+        else L[i] = std::max(start, std::min(ev.exact(L, i), 1023));
+        E[i] = ev.error(L, E, i);
+    }
+    evaluations += N;
+
+    wl_result r;
+    while (E[output] <= budget) {
+        // the candidates: one bit less on a node that still has bits
+        std::vector<int> cand;
+        for (int i = 0; i <= output; i++) {
+            if ((g[i].type != signal_graph::kind::input) && (ev.bits(L, E, i) > 0)) cand.push_back(i);
+        }
+        std::vector<double> err(cand.size());
+        parallelFor(int(cand.size()), threads, [&](int k) {
+            int                 c = cand[k];
+            std::vector<int>    Lc(L);
+            std::vector<double> Ec(E);  // the errors of the nodes before c are reused
+            Lc[c]++;
+            for (int i = c; i <= output; i++) Ec[i] = ev.error(Lc, Ec, i);
+            evaluations += output - c + 1;
+            err[k] = Ec[output];
+        });
+
+        int best = -1;
+        for (size_t k = 0; k < cand.size(); k++) {
+            if ((err[k] <= budget) && ((best < 0) || (err[k] < err[best]))) best = int(k);
+        }
+        if (best < 0) break;
+        L[cand[best]]++;
+        for (int i = cand[best]; i < N; i++) E[i] = ev.error(L, E, i);
+        r.steps++;
+    }
+
+    r.lsb         = L;
+    r.error       = E;
+    r.outputError = E[output];
+    r.feasible    = E[output] <= budget;
+    r.bits        = ev.bits(L, E);
+    r.evaluations = evaluations;
+    for (int i = 0; i < N; i++) r.msb.push_back(ev.msb(E, i));
+    return r;
+}
+
+double snrBudget(const interval& range, double snr)
+{
+    return mag(range) * std::pow(10.0, -snr / 20);
+}
+
+std::ostream& operator<<(std::ostream& dst, const wl_result& r)
+{
+    dst << (r.feasible ? "feasible" : "infeasible") << ", " << r.bits << " bits, output error " << r.outputError
+        << ", " << r.steps << " steps, " << r.evaluations << " evaluations, formats";
+    for (size_t i = 0; i < r.lsb.size(); i++) dst << " [" << r.msb[i] << ":" << r.lsb[i] << "]";
+    return dst;
+}
+
+//------------------------------------------------------------------------------------------
+// tests
+
+void testWordLength()
+{
+    using I = interval_algebra;
+
+    // y = sin(0.3*x + 0.5*mem(0.3*x)) with a 16 bits input
+    signal_graph g;
+    int          x = g.input(interval(-1, 1, -15));
+    int          a = g.binary(&I::Mul, x, g.constant(0.3));
+    int          b = g.binary(&I::Mul, g.unary(&I::Mem, a), g.constant(0.5));
+    int          y = g.unary(&I::Sin, g.binary(&I::Add, a, b));
+
+    wl_result r1 = optimizeWordLengths(g, y, std::ldexp(1.0, -8), -32, 1);
+    wl_result r2 = optimizeWordLengths(g, y, std::ldexp(1.0, -12), -32, 1);
+    testout() << r1 << '\n' << r2 << '\n';
+    check("test wordlength feasible", r1.feasible && (r1.outputError <= std::ldexp(1.0, -8)), true);
+    check("test wordlength budget", r2.feasible && (r2.bits > r1.bits), true);
+    check("test wordlength descent", r1.steps > 0, true);
+
+    // the candidates are evaluated in parallel with the same result
+    wl_result r3 = optimizeWordLengths(g, y, std::ldexp(1.0, -8), -32, 4);
+    check("test wordlength parallel", (r3.lsb == r1.lsb) && (r3.bits == r1.bits), true);
+
+    // the error of the input alone exceeds the budget
+    signal_graph h;
+    int          z = h.binary(&I::Add, h.input(interval(-1, 1, -15), 0.01), h.constant(1));
+    check("test wordlength infeasible", optimizeWordLengths(h, z, 0.001).feasible, false);
+
+    // integer paths are exact and need no fractional bits
+    signal_graph k;
+    int          i = k.input(interval(0, 255, 0));
+    int          s = k.binary(&I::Add, i, k.binary(&I::Mul, i, k.constant(4)));
+    wl_result    ri = optimizeWordLengths(k, s, 0, -32, 1);
+    check("test wordlength integer", ri.feasible && (ri.lsb[s] >= 0) && (ri.outputError == 0), true);
+
+    check("test wordlength snr", std::fabs(snrBudget(interval(-1, 1), 60) - 0.001) < 1e-12, true);
+}
+
+}  // namespace itv
@@ -0,0 +1,74 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "check.hh"
+#include "interval_def.hh"
+#include "signal_graph.hh"
+
+namespace itv {
+
+//==============================================================================
+// Word-length optimization of a fixed-point signal graph.
+//
+// The inputs of a signal graph have a fixed lsb and error. Every other node of
+// the graph is given a fixed-point format: its msb is deduced from its range
+// and its lsb is chosen by the optimizer. Rounding a node to its lsb adds an
+// error of 2^(lsb-1), unless the exact result is already a multiple of 2^lsb,
+// and the errors of the arguments are propagated to the result by the rules of
+// error_algebra.
+//
+// The optimizer starts from a fine lsb for every node and removes bits by
+// greedy descent: at each step, the candidate assignments (one bit less on one
+// node) are evaluated in parallel and the one keeping the smallest output
+// error is chosen, as long as the error stays within the budget. Only the
+// changed node and the nodes after it are evaluated again, the values and
+// errors of the nodes before it are reused from the current assignment.
+//==============================================================================
+
+struct wl_result {
+    std::vector<int>    lsb;    ///< lsb of each node
+    std::vector<int>    msb;    ///< msb of each node (without the sign bit)
+    std::vector<double> error;  ///< bound of the absolute error of each node
+    double              outputError{0};
+    int                 bits{0};         ///< sum of the word lengths of the nodes that aren't inputs
+    bool                feasible{false};  ///< the output error is within the budget
+    int                 steps{0};        ///< number of bits removed by the descent
+    long                evaluations{0};  ///< number of node evaluations
+};
+
+/**
+ * @brief Search minimal word lengths for the nodes of a graph, keeping the
+ * error of the output node within a budget.
+ *
+ * @param g the graph, without feedback (the loops are unrolled)
+ * @param output index of the output node
+ * @param budget bound of the absolute error of the output
+ * @param start lsb of the nodes at the beginning of the descent
+ * @param threads number of threads evaluating the candidates (0 for all hardware threads)
+ */
+wl_result optimizeWordLengths(const signal_graph& g, int output, double budget, int start = -32, unsigned int threads = 0);
+
+// the absolute error budget giving a signal to noise ratio of snr dB to a signal of peak amplitude range
+double snrBudget(const interval& range, double snr);
+
+std::ostream& operator<<(std::ostream& dst, const wl_result& r);
+
+void testWordLength();
+
+}  // namespace itv
@@ -0,0 +1,129 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+
+// ***************************************************************************
+//
+//     A wrapped_interval is an arc of the circle of the 2^32 int32 values:
+//     the values start, start+1, ..., start+span computed modulo 2^32. It
+//     models the two's complement wraparound of the int arithmetic of the
+//     generated code exactly: [INT_MAX-1, INT_MAX] + 1 is the arc
+//     {INT_MAX, INT_MIN}, not the whole int32 range.
+//
+//     The wrap flag tells that the operation which produced the interval can
+//     overflow, i.e. that its exact integer result can be outside of the int32
+//     range. It is not propagated, so that it points to the operations where
+//     the wraparound happens.
+//
+//****************************************************************************
+namespace itv {
+
+class wrapped_interval {
+   private:
+    uint32_t fStart{0};           ///< first value, as a two's complement bit pattern
+    uint32_t fSpan{UINT32_MAX};   ///< number of values minus one
+    bool     fEmpty{false};       ///< no value at all
+    bool     fWrap{false};        ///< the operation can overflow
+
+   public:
+    wrapped_interval() = default;  // the full circle
+
+    wrapped_interval(uint32_t start, uint32_t span, bool wrap = false) noexcept
+        : fStart(start), fSpan(span), fWrap(wrap)
+    {
+    }
+
+    explicit wrapped_interval(int32_t n) noexcept : fStart(uint32_t(n)), fSpan(0) {}
+
+    // the arc [lo,hi] of signed values, empty when lo > hi
+    static wrapped_interval range(int32_t lo, int32_t hi)
+    {
+        if (lo > hi) return empty();
+        return {uint32_t(lo), uint32_t(hi) - uint32_t(lo)};
+    }
+
+    static wrapped_interval empty()
+    {
+        wrapped_interval e(0, 0);
+        e.fEmpty = true;
+        return e;
+    }
+
+    bool     isEmpty() const { return fEmpty; }
+    bool     isFull() const { return !fEmpty && (fSpan == UINT32_MAX); }
+    bool     wrap() const { return fWrap; }
+    uint32_t start() const { return fStart; }
+    uint32_t span() const { return fSpan; }
+    uint32_t end() const { return fStart + fSpan; }
+    bool     has(int32_t x) const { return !fEmpty && (uint32_t(x) - fStart <= fSpan); }
+
+    // the arc crosses the boundary between INT_MAX and INT_MIN
+    bool crossesSignedBoundary() const
+    {
+        uint32_t d = 0x80000000U - fStart;  // distance from the start to INT_MIN
+        return !fEmpty && (d != 0) && (d <= fSpan);
+    }
+
+    // the smallest signed interval containing the arc
+    int32_t lo() const { return crossesSignedBoundary() ? INT32_MIN : int32_t(fStart); }
+    int32_t hi() const { return crossesSignedBoundary() ? INT32_MAX : int32_t(end()); }
+};
+
+inline std::ostream& operator<<(std::ostream& dst, const wrapped_interval& i)
+{
+    if (i.isEmpty()) return dst << "wrapped_interval()";
+    if (i.isFull()) return dst << "wrapped_interval(full" << (i.wrap() ? ",wrap)" : ")");
+    return dst << "wrapped_interval(" << int32_t(i.start()) << ',' << int32_t(i.end()) << (i.wrap() ? ",wrap)" : ")");
+}
+
+inline bool operator==(const wrapped_interval& i, const wrapped_interval& j)
+{
+    if (i.isEmpty() || j.isEmpty()) return i.isEmpty() && j.isEmpty();
+    if (i.isFull() || j.isFull()) return i.isFull() && j.isFull() && (i.wrap() == j.wrap());
+    return (i.start() == j.start()) && (i.span() == j.span()) && (i.wrap() == j.wrap());
+}
+
+inline bool operator!=(const wrapped_interval& i, const wrapped_interval& j)
+{
+    return !(i == j);
+}
+
+/**
+ * @brief The smallest arc containing i and j. The union of two arcs is not
+ * always an arc, the shortest of the two candidate covers is chosen.
+ */
+inline wrapped_interval reunion(const wrapped_interval& i, const wrapped_interval& j)
+{
+    if (i.isEmpty()) return j;
+    if (j.isEmpty()) return i;
+    bool wrap = i.wrap() || j.wrap();
+    if (i.isFull() || j.isFull()) return {0, UINT32_MAX, wrap};
+
+    // the arc starting at a.start() and covering b
+    auto cover = [](const wrapped_interval& a, const wrapped_interval& b) -> uint64_t {
+        return std::max<uint64_t>(a.span(), uint64_t(b.start() - a.start()) + b.span());
+    };
+    uint64_t ij = cover(i, j);
+    uint64_t ji = cover(j, i);
+    if (std::min(ij, ji) > UINT32_MAX) return {0, UINT32_MAX, wrap};
+    if (ij <= ji) return {i.start(), uint32_t(ij), wrap};
+    return {j.start(), uint32_t(ji), wrap};
+}
+
+}  // namespace itv
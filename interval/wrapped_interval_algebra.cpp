@@ -0,0 +1,267 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <sstream>
+#include <string>
+
+#include "check.hh"
+#include "wrapped_interval.hh"
+#include "wrapped_interval_algebra.hh"
+#include "interval_algebra.hh"
+
+namespace itv {
+
+//------------------------------------------------------------------------------------------
+// exact int64 computations on the signed pieces of the arcs
+
+// a piece of an arc that doesn't cross the signed boundary
+struct piece {
+    int64_t lo;
+    int64_t hi;
+};
+
+// the one or two signed pieces of a non empty arc, returns their number
+static int pieces(const wrapped_interval& x, piece* p)
+{
+    if (!x.crossesSignedBoundary()) {
+        p[0] = {int32_t(x.start()), int32_t(x.end())};
+        return 1;
+    }
+    p[0] = {int32_t(x.start()), INT32_MAX};
+    p[1] = {INT32_MIN, int32_t(x.end())};
+    return 2;
+}
+
+// the arc of the exact values [lo,hi] modulo 2^32, flagged when they leave the int32 range
+static wrapped_interval wrapExact(int64_t lo, int64_t hi)
+{
+    bool wrap = (lo < INT32_MIN) || (hi > INT32_MAX);
+    if (uint64_t(hi - lo) > UINT32_MAX) return {0, UINT32_MAX, wrap};
+    return {uint32_t(lo), uint32_t(hi - lo), wrap};
+}
+
+// the union of op(a,b) for all the pieces a of x and b of y, where op returns exact int64 bounds
+template <typename Op>
+static wrapped_interval combine(const wrapped_interval& x, const wrapped_interval& y, Op op)
+{
+    if (x.isEmpty() || y.isEmpty()) return wrapped_interval::empty();
+    piece            px[2], py[2];
+    int              nx = pieces(x, px);
+    int              ny = pieces(y, py);
+    wrapped_interval r  = wrapped_interval::empty();
+    for (int i = 0; i < nx; i++) {
+        for (int j = 0; j < ny; j++) {
+            piece p = op(px[i], py[j]);
+            r       = reunion(r, wrapExact(p.lo, p.hi));
+        }
+    }
+    return r;
+}
+
+// the exact product of two pieces, int32 x int32 products fit in int64
+static piece multiply(const piece& a, const piece& b)
+{
+    int64_t c[4]{a.lo * b.lo, a.lo * b.hi, a.hi * b.lo, a.hi * b.hi};
+    return {*std::min_element(c, c + 4), *std::max_element(c, c + 4)};
+}
+
+//------------------------------------------------------------------------------------------
+// injections and conversions
+
+wrapped_interval wrapped_interval_algebra::IntNum(int x) const
+{
+    return wrapped_interval(x);
+}
+
+wrapped_interval wrapped_interval_algebra::Button(const wrapped_interval& name) const
+{
+    return wrapped_interval::range(0, 1);
+}
+
+wrapped_interval wrapped_interval_algebra::Checkbox(const wrapped_interval& name) const
+{
+    return wrapped_interval::range(0, 1);
+}
+
+wrapped_interval wrapped_interval_algebra::IntCast(const interval& x) const
+{
+    if (x.isEmpty()) return wrapped_interval::empty();
+    return wrapped_interval::range(saturatedIntCast(x.lo()), saturatedIntCast(x.hi()));
+}
+
+interval wrapped_interval_algebra::FloatCast(const wrapped_interval& x) const
+{
+    if (x.isEmpty()) return {NAN, NAN, 0};
+    return {double(x.lo()), double(x.hi()), 0};
+}
+
+wrapped_interval wrapped_interval_algebra::Wrap(const int_interval& x) const
+{
+    if (x.isEmpty()) return wrapped_interval::empty();
+    if (uint64_t(x.hi()) - uint64_t(x.lo()) > UINT32_MAX) return {0, UINT32_MAX, true};
+    return wrapExact(x.lo(), x.hi());
+}
+
+//------------------------------------------------------------------------------------------
+// arithmetic
+
+wrapped_interval wrapped_interval_algebra::Neg(const wrapped_interval& x) const
+{
+    if (x.isEmpty()) return x;
+    return {uint32_t(0) - x.end(), x.span(), x.has(INT32_MIN)};  // -INT_MIN wraps to INT_MIN
+}
+
+wrapped_interval wrapped_interval_algebra::Add(const wrapped_interval& x, const wrapped_interval& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return wrapped_interval::empty();
+    // the sum of the pieces only tells where it wraps, the sum of the arcs is tighter than their union
+    bool wrap = combine(x, y, [](const piece& a, const piece& b) { return piece{a.lo + b.lo, a.hi + b.hi}; }).wrap();
+    uint64_t span = uint64_t(x.span()) + y.span();
+    if (span > UINT32_MAX) return {0, UINT32_MAX, wrap};
+    return {x.start() + y.start(), uint32_t(span), wrap};
+}
+
+wrapped_interval wrapped_interval_algebra::Sub(const wrapped_interval& x, const wrapped_interval& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return wrapped_interval::empty();
+    bool wrap = combine(x, y, [](const piece& a, const piece& b) { return piece{a.lo - b.hi, a.hi - b.lo}; }).wrap();
+    uint64_t span = uint64_t(x.span()) + y.span();
+    if (span > UINT32_MAX) return {0, UINT32_MAX, wrap};
+    return {x.start() - y.end(), uint32_t(span), wrap};
+}
+
+wrapped_interval wrapped_interval_algebra::Mul(const wrapped_interval& x, const wrapped_interval& y) const
+{
+    return combine(x, y, multiply);
+}
+
+wrapped_interval wrapped_interval_algebra::Lsh(const wrapped_interval& x, const wrapped_interval& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return wrapped_interval::empty();
+    // x << s is x * 2^s modulo 2^32, for each of the (at most 32) shift amounts
+    int              s0 = std::clamp(y.lo(), 0, 31);
+    int              s1 = std::clamp(y.hi(), 0, 31);
+    wrapped_interval r  = wrapped_interval::empty();
+    for (int s = s0; s <= s1; s++) {
+        int64_t p = int64_t(1) << s;
+        r         = reunion(r, combine(x, wrapped_interval(0, 0),
+                                       [p](const piece& a, const piece&) { return multiply(a, {p, p}); }));
+    }
+    return r;
+}
+
+wrapped_interval wrapped_interval_algebra::Mem(const wrapped_interval& x) const
+{
+    if (x.isEmpty()) return x;
+    return reunion(x, wrapped_interval(0));
+}
+
+wrapped_interval wrapped_interval_algebra::Delay(const wrapped_interval& x, const wrapped_interval& y) const
+{
+    if (x.isEmpty() || y.isEmpty()) return wrapped_interval::empty();
+    if (y == wrapped_interval(0)) return x;
+    return reunion(x, wrapped_interval(0));
+}
+
+// the smallest arc containing the branches reachable with the selector, see interval_algebra::selectBranches
+wrapped_interval wrapped_interval_algebra::Select2(const wrapped_interval& s, const wrapped_interval& x,
+                                                   const wrapped_interval& y) const
+{
+    unsigned         b = interval_algebra().selectBranches(FloatCast(s), 2);
+    wrapped_interval r = wrapped_interval::empty();
+    if ((b & 1U) != 0) r = reunion(r, x);
+    if ((b & 2U) != 0) r = reunion(r, y);
+    return r;
+}
+
+wrapped_interval wrapped_interval_algebra::Select3(const wrapped_interval& s, const wrapped_interval& x,
+                                                   const wrapped_interval& y, const wrapped_interval& z) const
+{
+    unsigned         b = interval_algebra().selectBranches(FloatCast(s), 3);
+    wrapped_interval r = wrapped_interval::empty();
+    if ((b & 1U) != 0) r = reunion(r, x);
+    if ((b & 2U) != 0) r = reunion(r, y);
+    if ((b & 4U) != 0) r = reunion(r, z);
+    return r;
+}
+
+// a table is summarized by the interval of its values, see interval_algebra::RdTbl
+wrapped_interval wrapped_interval_algebra::RdTbl(const wrapped_interval& tbl, const wrapped_interval& index) const
+{
+    if (index.isEmpty()) return wrapped_interval::empty();
+    return tbl;
+}
+
+wrapped_interval wrapped_interval_algebra::WrTbl(const wrapped_interval& n, const wrapped_interval& init,
+                                                 const wrapped_interval& index, const wrapped_interval& value) const
+{
+    if (n.isEmpty()) return wrapped_interval::empty();
+    if (index.isEmpty() || value.isEmpty()) return init;  // read only table
+    return reunion(init, value);
+}
+
+//------------------------------------------------------------------------------------------
+// tests
+
+static void check(const std::string& testname, const wrapped_interval& exp, const wrapped_interval& res)
+{
+    std::ostringstream e, r;
+    e << exp;
+    r << res;
+    ::check(testname + " " + e.str() + " == " + r.str(), exp == res, true);
+}
+
+void testWrappedInterval()
+{
+    wrapped_interval_algebra A;
+    wrapped_interval         top = wrapped_interval::range(INT_MAX - 1, INT_MAX);
+
+    check("test wrapped Add", A.Add(wrapped_interval::range(0, 10), A.IntNum(5)), wrapped_interval::range(5, 15));
+    check("test wrapped Add wrap", A.Add(top, A.IntNum(1)), {uint32_t(INT_MAX), 1, true});
+    ::check("test wrapped Add wrap has INT_MIN", A.Add(top, A.IntNum(1)).has(INT_MIN), true);
+    ::check("test wrapped Add wrap exact", A.Add(top, A.IntNum(1)).has(0), false);
+    check("test wrapped Add counter", A.Add(wrapped_interval(), A.IntNum(1)), {0, UINT32_MAX, true});
+    check("test wrapped Sub wrap", A.Sub(A.IntNum(INT_MIN), A.IntNum(1)), {uint32_t(INT_MAX), 0, true});
+    check("test wrapped Neg wrap", A.Neg(A.IntNum(INT_MIN)), {uint32_t(INT_MIN), 0, true});
+    check("test wrapped Neg", A.Neg(wrapped_interval::range(-3, 5)), wrapped_interval::range(-5, 3));
+    check("test wrapped Mul", A.Mul(wrapped_interval::range(-2, 2), wrapped_interval::range(-3, 3)),
+          wrapped_interval::range(-6, 6));
+    check("test wrapped Mul wrap", A.Mul(A.Add(top, A.IntNum(1)), A.IntNum(2)), {uint32_t(-2), 2, true});
+    check("test wrapped Lsh", A.Lsh(wrapped_interval::range(1, 3), A.IntNum(4)), wrapped_interval::range(16, 48));
+    check("test wrapped Lsh wrap", A.Lsh(A.IntNum(1), wrapped_interval::range(0, 31)), {1, uint32_t(INT_MAX), true});
+    check("test wrapped reunion", reunion(top, A.IntNum(INT_MIN)), {uint32_t(INT_MAX - 1), 2});
+    check("test wrapped Mem", A.Mem(wrapped_interval::range(5, 7)), wrapped_interval::range(0, 7));
+
+    // conversions
+    check("test wrapped Wrap", A.Wrap({int64_t(INT_MAX), int64_t(INT_MAX) + 2}), {uint32_t(INT_MAX), 2, true});
+    check("test wrapped IntCast", A.IntCast(interval(-3.5, 1e20)), wrapped_interval::range(-3, INT_MAX));
+    ::check("test wrapped FloatCast", A.FloatCast(top), interval(INT_MAX - 1, INT_MAX, 0));
+
+    // the real valued Add of interval_algebra leaves the int32 range instead
+    interval_algebra R;
+    ::check("test wrapped real Add", R.Add(interval(INT_MAX - 1, INT_MAX, 0), interval(1, 1, 0)).hi() > INT_MAX, true);
+
+    check("test wrapped Select2", A.Select2(A.IntNum(0), wrapped_interval::range(0, 10), top),
+          wrapped_interval::range(0, 10));
+    check("test wrapped Select3", A.Select3(wrapped_interval::range(1, 2), A.IntNum(0), A.IntNum(1), A.IntNum(2)),
+          wrapped_interval::range(1, 2));
+
+    check("test wrapped WrTbl", A.WrTbl(A.IntNum(8), A.IntNum(0), wrapped_interval::range(0, 7), A.IntNum(3)),
+          wrapped_interval::range(0, 3));
+}
+
+}  // namespace itv
@@ -0,0 +1,59 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "faust_algebra.hh"
+#include "int_interval.hh"
+#include "interval_def.hh"
+#include "wrapped_interval.hh"
+
+namespace itv {
+
+// The modular int32 arithmetic of the generated code, on wrapped intervals.
+// Every result whose exact value can leave the int32 range is marked by its
+// wrap flag, the wrapped result itself stays exact.
+class wrapped_interval_algebra : public faust_algebra<wrapped_interval> {
+   public:
+    // Injections of external values
+    wrapped_interval IntNum(int x) const;
+
+    // User interface elements
+    wrapped_interval Button(const wrapped_interval& name) const;
+    wrapped_interval Checkbox(const wrapped_interval& name) const;
+
+    // Conversions with the other domains
+    wrapped_interval IntCast(const interval& x) const;  // saturated, as the int cast of interval_algebra
+    interval         FloatCast(const wrapped_interval& x) const;
+    wrapped_interval Wrap(const int_interval& x) const;  // x modulo 2^32
+
+    // Operations
+    wrapped_interval Neg(const wrapped_interval& x) const;
+    wrapped_interval Add(const wrapped_interval& x, const wrapped_interval& y) const;
+    wrapped_interval Sub(const wrapped_interval& x, const wrapped_interval& y) const;
+    wrapped_interval Mul(const wrapped_interval& x, const wrapped_interval& y) const;
+    wrapped_interval Lsh(const wrapped_interval& x, const wrapped_interval& y) const;  // shifts restricted to [0,31]
+    wrapped_interval Mem(const wrapped_interval& x) const;
+    wrapped_interval Delay(const wrapped_interval& x, const wrapped_interval& y) const;
+    wrapped_interval Select2(const wrapped_interval& s, const wrapped_interval& x, const wrapped_interval& y) const;
+    wrapped_interval Select3(const wrapped_interval& s, const wrapped_interval& x, const wrapped_interval& y,
+                             const wrapped_interval& z) const;
+    wrapped_interval RdTbl(const wrapped_interval& tbl, const wrapped_interval& index) const;
+    wrapped_interval WrTbl(const wrapped_interval& n, const wrapped_interval& init,
+                           const wrapped_interval& index, const wrapped_interval& value) const;
+};
+
+void testWrappedInterval();
+
+}  // namespace itv
@@ -13,23 +13,49 @@
  * limitations under the License.
  */
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 #include <string>
 
+#include "interval/affine_algebra.hh"
+#include "interval/benchmark.hh"
 #include "interval/check.hh"
+#include "interval/delay_planner.hh"
+#include "interval/domain_report.hh"
+#include "interval/error_algebra.hh"
+#include "interval/exhaustive.hh"
+#include "interval/finite_set_algebra.hh"
+#include "interval/float_report.hh"
+#include "interval/int_interval_algebra.hh"
+#include "interval/interval32_algebra.hh"
 #include "interval/interval_algebra.hh"
 #include "interval/interval_def.hh"
+#include "interval/lti_bounds.hh"
+#include "interval/multi_interval_algebra.hh"
+#include "interval/outward_interval_algebra.hh"
+#include "interval/redundancy.hh"
+#include "interval/strength_reduction.hh"
+#include "interval/subnormal_report.hh"
+#include "interval/taylor_algebra.hh"
+#include "interval/wordlength.hh"
+#include "interval/wrapped_interval_algebra.hh"
 
 using namespace itv;
 
-int main()
+// usage: TestInterval [-j threads] [-v]
+//  -j N : number of threads running the tests (default: all hardware threads)
+//  -v   : print the log of every test, not only of the failed ones
+// The exit status is 1 when a test fails.
+
+static void testRepresentation()
 {
     // test interval representation
-    check("interval()", interval());
-    check("interval(0,100)", interval(100.0, 0.0));
-    check("interval(0)", interval(0, 0));
-    check("interval(-10,0)", interval(0, -10));
+    check("interval(-1.79769e+308,1.79769e+308,-24)", interval());
+    check("interval(0,100,-24)", interval(100.0, 0.0));
+    check("interval(0,0,-24)", interval(0, 0));
+    check("interval(-10,0,-24)", interval(0, -10));
 
     // test union intersection
 
@@ -37,60 +63,61 @@ int main()
     check("test3", intersection(interval(10, 100), interval(-10, 0)), interval());
     check("test4", reunion(interval(0, 100), interval(-100, 50)), interval(-100, 100));
     check("test5", reunion(interval(0, 100), interval(10, 500)), interval(0, 500));
+}
 
+static void testPredicates()
+{
     // test predicates
-    interval a(1, 100), b(10, 20), c(-10, 0), n;
+    interval a(1, 100), b(10, 20), c(-10, 0), n(NAN, NAN);  // n is empty
 
-    std::cout << a << " == " << b << " = " << (a == b) << std::endl;
-    std::cout << a << " <= " << b << " = " << (a <= b) << std::endl;
-    std::cout << a << " < " << b << " = " << (a < b) << std::endl;
+    testout() << a << " == " << b << " = " << (a == b) << '\n';
+    testout() << a << " <= " << b << " = " << (a <= b) << '\n';
+    testout() << a << " < " << b << " = " << (a < b) << '\n';
 
-    std::cout << std::endl;
+    testout() << '\n';
 
-    std::cout << a << " != " << b << " = " << (a != b) << std::endl;
-    std::cout << a << " > " << b << " = " << (a > b) << std::endl;
-    std::cout << a << " >= " << b << " = " << (a >= b) << std::endl;
+    testout() << a << " != " << b << " = " << (a != b) << '\n';
+    testout() << a << " > " << b << " = " << (a > b) << '\n';
+    testout() << a << " >= " << b << " = " << (a >= b) << '\n';
 
-    std::cout << std::endl;
+    testout() << '\n';
 
-    std::cout << a << " == " << a << " = " << (a == a) << std::endl;
-    std::cout << a << " <= " << a << " = " << (a <= a) << std::endl;
-    std::cout << a << " < " << a << " = " << (a < a) << std::endl;
+    testout() << a << " == " << a << " = " << (a == a) << '\n';
+    testout() << a << " <= " << a << " = " << (a <= a) << '\n';
+    testout() << a << " < " << a << " = " << (a < a) << '\n';
 
-    std::cout << std::endl;
+    testout() << '\n';
 
-    std::cout << a << " != " << a << " = " << (a != a) << std::endl;
-    std::cout << a << " > " << a << " = " << (a > a) << std::endl;
-    std::cout << a << " >= " << a << " = " << (a >= a) << std::endl;
+    testout() << a << " != " << a << " = " << (a != a) << '\n';
+    testout() << a << " > " << a << " = " << (a > a) << '\n';
+    testout() << a << " >= " << a << " = " << (a >= a) << '\n';
 
-    std::cout << std::endl;
+    testout() << '\n';
 
-    std::cout << a << " != " << n << " = " << (a != n) << std::endl;
-    std::cout << a << " > " << n << " = " << (a > n) << std::endl;
-    std::cout << a << " >= " << n << " = " << (a >= n) << std::endl;
+    testout() << a << " != " << n << " = " << (a != n) << '\n';
+    testout() << a << " > " << n << " = " << (a > n) << '\n';
+    testout() << a << " >= " << n << " = " << (a >= n) << '\n';
 
-    std::cout << std::endl;
+    testout() << '\n';
 
-    std::cout << "must be true " << (reunion(a, n) == a) << std::endl;
-    std::cout << "must be true " << (intersection(a, n) == n) << std::endl;
+    check("must be true", reunion(a, n) == a, true);
+    check("must be true", intersection(a, n) == n, true);
 
-    std::cout << std::endl;
-
-    interval_algebra A;
-    A.testAll();
+    check("ispowerof2", interval(64).ispowerof2() && !interval(2.5).ispowerof2() && !interval(0).ispowerof2(), true);
+    check("isbitmask", interval(63).isbitmask() && interval(0).isbitmask() && !interval(62).isbitmask(), true);
+}
 
-    {
-        double u = 0.0;
-        double v = nextafter(u, -HUGE_VAL);
-        double w = nextafter(v, -HUGE_VAL);
+static void testOrder()
+{
+    double u = 0.0;
+    double v = nextafter(u, -HUGE_VAL);
+    double w = nextafter(v, -HUGE_VAL);
 
-        if ((u != v) && (v != w) && (u > v) && (v > w)) {
-            std::cout << "Order OK" << std::endl;
-        } else {
-            std::cout << "Order NOT OK" << std::endl;
-        }
-    }
+    check("Order OK", (u != v) && (v != w) && (u > v) && (v > w), true);
+}
 
+static void testAnalyzeMod()
+{
     analyzemod(interval(9), interval(10));
     analyzemod(interval(8, 9), interval(10));
     analyzemod(interval(8, 9), interval(1, 10));
@@ -101,8 +128,55 @@ int main()
     analyzemod(interval(-9, 0), interval(9, 10));
     analyzemod(interval(0, 100), interval(1));
     analyzemod(interval(-100, 100), interval(1));
+}
 
+static void testAnalyzeRounding()
+{
     analyzeUnaryFunction(10, 1000, "rint", interval(-10000, 10000), rint);
     analyzeUnaryFunction(10, 1000, "floor", interval(-10000, 10000), floor);
     analyzeUnaryFunction(10, 1000, "ceil", interval(-10000, 10000), ceil);
-}
\ No newline at end of file
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned int threads = 0;
+    bool         verbose = false;
+    for (int i = 1; i < argc; i++) {
+        if ((std::strcmp(argv[i], "-j") == 0) && (i + 1 < argc)) {
+            threads = unsigned(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "-v") == 0) {
+            verbose = true;
+        }
+    }
+
+    registerTest("representation", testRepresentation);
+    registerTest("predicates", testPredicates);
+
+    interval_algebra A;
+    A.registerTests();
+    registerTest("interval32", testInterval32);
+    registerTest("int_interval", testIntInterval);
+    registerTest("wrapped_interval", testWrappedInterval);
+    registerTest("outward", testOutward);
+    registerTest("affine", testAffine);
+    registerTest("taylor", testTaylor);
+    registerTest("multi_interval", testMultiInterval);
+    registerTest("finite_set", testFiniteSet);
+    registerTest("error", testErrorAlgebra);
+
+    registerTest("exhaustive", testExhaustive);
+    registerTest("benchmark", testBenchmark);
+    registerTest("wordlength", testWordLength);
+    registerTest("float_report", testFloatReport);
+    registerTest("subnormal", testSubnormalReport);
+    registerTest("domain", testDomainReport);
+    registerTest("redundancy", testRedundancy);
+    registerTest("strength", testStrengthReduction);
+    registerTest("delay_planner", testDelayPlanner);
+    registerTest("lti", testLTIBounds);
+    registerTest("order", testOrder);
+    registerTest("analyze mod", testAnalyzeMod);
+    registerTest("analyze rounding", testAnalyzeRounding);
+
+    return (runTests(threads, verbose) == 0) ? 0 : 1;
+}
@@ -0,0 +1,158 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "interval/benchmark.hh"
+#include "interval/interval_algebra.hh"
+#include "interval/outward_interval_algebra.hh"
+
+// Precision versus throughput benchmark of the primitives.
+//
+// usage: BenchInterval [-csv] [-outward] [-E intervals] [-M samples] [primitive...]
+//
+//  -csv : print csv lines instead of a table, to track the results over time
+//  -outward : measure the sound mode (outward_interval_algebra) next to the fast mode
+//  -E N : number of random input intervals per input class (default: 1000)
+//  -M N : number of random samples per interval to estimate its image (default: 100)
+//
+// All the primitives are measured when none is given.
+
+using namespace itv;
+
+struct unary_case {
+    const char* name;
+    const char* input;
+    ufun        f;
+    umth        m;
+    oumth       o;
+    interval    D;
+};
+
+struct binary_case {
+    const char* name;
+    const char* input;
+    bfun        f;
+    bmth        m;
+    obmth       o;
+    interval    Dx;
+    interval    Dy;
+};
+
+static double myAdd(double x, double y)
+{
+    return x + y;
+}
+static double mySub(double x, double y)
+{
+    return x - y;
+}
+static double myMul(double x, double y)
+{
+    return x * y;
+}
+static double myDiv(double x, double y)
+{
+    return x / y;
+}
+static double myiPow(double x, double y)
+{
+    return std::pow(x, int(y));
+}
+static double myAnd(double x, double y)
+{
+    return double(saturatedIntCast(x) & saturatedIntCast(y));
+}
+static double myOr(double x, double y)
+{
+    return double(saturatedIntCast(x) | saturatedIntCast(y));
+}
+
+static const std::vector<unary_case> gUnary = {
+    {"abs", "[-100,100]", fabs, &interval_algebra::Abs, &outward_interval_algebra::Abs, {-100, 100}},
+    {"acos", "[-1,1]", acos, &interval_algebra::Acos, &outward_interval_algebra::Acos, {-1, 1}},
+    {"atan", "[-100,100]", atan, &interval_algebra::Atan, &outward_interval_algebra::Atan, {-100, 100}},
+    {"cos", "[-2pi,2pi]", cos, &interval_algebra::Cos, &outward_interval_algebra::Cos, {-2 * M_PI, 2 * M_PI}},
+    {"cos", "[1e6,1e6+10]", cos, &interval_algebra::Cos, &outward_interval_algebra::Cos, {1e6, 1e6 + 10}},
+    {"exp", "[-10,10]", exp, &interval_algebra::Exp, &outward_interval_algebra::Exp, {-10, 10}},
+    {"floor", "[-100,100]", floor, &interval_algebra::Floor, &outward_interval_algebra::Floor, {-100, 100}},
+    {"log", "]0,1000]", log, &interval_algebra::Log, &outward_interval_algebra::Log, {1e-3, 1000}},
+    {"sin", "[-2pi,2pi]", sin, &interval_algebra::Sin, &outward_interval_algebra::Sin, {-2 * M_PI, 2 * M_PI}},
+    {"sin", "[1e6,1e6+10]", sin, &interval_algebra::Sin, &outward_interval_algebra::Sin, {1e6, 1e6 + 10}},
+    {"sqrt", "[0,1000]", sqrt, &interval_algebra::Sqrt, &outward_interval_algebra::Sqrt, {0, 1000}},
+    {"tan", "]-pi/2,pi/2[", tan, &interval_algebra::Tan, &outward_interval_algebra::Tan, {-1.5, 1.5}},
+    {"tanh", "[-10,10]", tanh, &interval_algebra::Tanh, &outward_interval_algebra::Tanh, {-10, 10}},
+};
+
+static const std::vector<binary_case> gBinary = {
+    {"add", "[-100,100]^2", myAdd, &interval_algebra::Add, &outward_interval_algebra::Add, {-100, 100}, {-100, 100}},
+    {"sub", "[-100,100]^2", mySub, &interval_algebra::Sub, &outward_interval_algebra::Sub, {-100, 100}, {-100, 100}},
+    {"mul", "[-100,100]^2", myMul, &interval_algebra::Mul, &outward_interval_algebra::Mul, {-100, 100}, {-100, 100}},
+    {"div", "[-100,100]/[1,100]", myDiv, &interval_algebra::Div, &outward_interval_algebra::Div, {-100, 100}, {1, 100}},
+    {"div", "[-100,100]/[-100,-1]", myDiv, &interval_algebra::Div, &outward_interval_algebra::Div, {-100, 100},
+     {-100, -1}},
+    {"mod", "[0,1000]%[1,10]", fmod, &interval_algebra::Mod, &outward_interval_algebra::Mod, {0, 1000}, {1, 10}},
+    {"mod", "[0,10]%[5,20]", fmod, &interval_algebra::Mod, &outward_interval_algebra::Mod, {0, 10}, {5, 20}},
+    {"pow", "]0,10]^[-4,4]", pow, &interval_algebra::Pow, &outward_interval_algebra::Pow, {1e-3, 10}, {-4, 4}},
+    {"pow", "[-10,10]^[0,8]", myiPow, &interval_algebra::Pow, &outward_interval_algebra::Pow, {-10, 10}, {0, 8}},
+    {"and", "[-1000,1000]&[0,255]", myAnd, &interval_algebra::And, &outward_interval_algebra::And, {-1000, 1000},
+     {0, 255}},
+    {"or", "[-1000,1000]|[0,255]", myOr, &interval_algebra::Or, &outward_interval_algebra::Or, {-1000, 1000}, {0, 255}},
+};
+
+int main(int argc, char* argv[])
+{
+    bool                     csv     = false;
+    bool                     outward = false;
+    int                      E   = 1000;
+    int                      M   = 100;
+    std::vector<std::string> selected;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "-csv") == 0) {
+            csv = true;
+        } else if (std::strcmp(argv[i], "-outward") == 0) {
+            outward = true;
+        } else if ((std::strcmp(argv[i], "-E") == 0) && (i + 1 < argc)) {
+            E = std::atoi(argv[++i]);
+        } else if ((std::strcmp(argv[i], "-M") == 0) && (i + 1 < argc)) {
+            M = std::atoi(argv[++i]);
+        } else {
+            selected.emplace_back(argv[i]);
+        }
+    }
+
+    auto wanted = [&](const char* name) {
+        return selected.empty() || (std::find(selected.begin(), selected.end(), name) != selected.end());
+    };
+
+    printBenchHeader(std::cout, csv);
+    for (const auto& c : gUnary) {
+        if (!wanted(c.name)) continue;
+        printBenchResult(std::cout, benchUnaryMethod(c.name, c.input, c.f, c.m, c.D, E, M), csv);
+        if (outward) printBenchResult(std::cout, benchUnaryMethod(c.name, c.input, c.f, c.o, c.D, E, M), csv);
+    }
+    for (const auto& c : gBinary) {
+        if (!wanted(c.name)) continue;
+        printBenchResult(std::cout, benchBinaryMethod(c.name, c.input, c.f, c.m, c.Dx, c.Dy, E, M), csv);
+        if (outward) printBenchResult(std::cout, benchBinaryMethod(c.name, c.input, c.f, c.o, c.Dx, c.Dy, E, M), csv);
+    }
+    return 0;
+}
@@ -0,0 +1,121 @@
+/* Copyright 2023 Yann ORLAREY
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "interval/exhaustive.hh"
+#include "interval/interval_algebra.hh"
+
+// Exhaustive verification of the interval primitives.
+//
+// usage: VerifyInterval [-threads N] [-blocks B] [-bits b] [primitive...]
+//
+//  -threads N : number of threads (default: all hardware threads)
+//  -blocks B  : number of blocks of 2^16 float32 inputs to sweep (default: 65536, all float32)
+//  -bits b    : width of the integers for the bitwise primitives (default: 16)
+//
+// All the primitives are verified when none is given. The exit status is 1
+// when an unsound result is found.
+
+using namespace itv;
+
+struct unary_primitive {
+    const char* name;
+    ufun        f;
+    umth        m;
+};
+
+struct binary_primitive {
+    const char* name;
+    bfun        f;
+    bmth        m;
+};
+
+static double myAnd(double x, double y)
+{
+    return double(saturatedIntCast(x) & saturatedIntCast(y));
+}
+
+static double myOr(double x, double y)
+{
+    return double(saturatedIntCast(x) | saturatedIntCast(y));
+}
+
+static double myXor(double x, double y)
+{
+    return double(saturatedIntCast(x) ^ saturatedIntCast(y));
+}
+
+static const std::vector<unary_primitive> gUnary = {
+    {"abs", fabs, &interval_algebra::Abs},       {"acos", acos, &interval_algebra::Acos},
+    {"acosh", acosh, &interval_algebra::Acosh},  {"asin", asin, &interval_algebra::Asin},
+    {"asinh", asinh, &interval_algebra::Asinh},  {"atan", atan, &interval_algebra::Atan},
+    {"atanh", atanh, &interval_algebra::Atanh},  {"ceil", ceil, &interval_algebra::Ceil},
+    {"cos", cos, &interval_algebra::Cos},        {"cosh", cosh, &interval_algebra::Cosh},
+    {"exp", exp, &interval_algebra::Exp},        {"floor", floor, &interval_algebra::Floor},
+    {"log", log, &interval_algebra::Log},        {"log10", log10, &interval_algebra::Log10},
+    {"rint", rint, &interval_algebra::Rint},     {"sin", sin, &interval_algebra::Sin},
+    {"sinh", sinh, &interval_algebra::Sinh},     {"sqrt", sqrt, &interval_algebra::Sqrt},
+    {"tan", tan, &interval_algebra::Tan},        {"tanh", tanh, &interval_algebra::Tanh},
+};
+
+static const std::vector<binary_primitive> gBinary = {
+    {"and", myAnd, &interval_algebra::And},
+    {"or", myOr, &interval_algebra::Or},
+    {"xor", myXor, &interval_algebra::Xor},
+};
+
+int main(int argc, char* argv[])
+{
+    unsigned int             threads = 0;
+    unsigned int             blocks  = 65536;
+    int                      bits    = 16;
+    std::vector<std::string> selected;
+
+    for (int i = 1; i < argc; i++) {
+        if ((std::strcmp(argv[i], "-threads") == 0) && (i + 1 < argc)) {
+            threads = unsigned(std::atoi(argv[++i]));
+        } else if ((std::strcmp(argv[i], "-blocks") == 0) && (i + 1 < argc)) {
+            blocks = unsigned(std::atoi(argv[++i]));
+        } else if ((std::strcmp(argv[i], "-bits") == 0) && (i + 1 < argc)) {
+            bits = std::atoi(argv[++i]);
+        } else {
+            selected.emplace_back(argv[i]);
+        }
+    }
+
+    auto wanted = [&](const char* name) {
+        return selected.empty() || (std::find(selected.begin(), selected.end(), name) != selected.end());
+    };
+
+    bool sound = true;
+    for (const auto& p : gUnary) {
+        if (!wanted(p.name)) continue;
+        sweep_report r = sweepUnaryMethod(p.name, p.f, p.m, blocks, threads);
+        std::cout << r << std::endl;
+        sound = sound && (r.unsound == 0);
+    }
+    for (const auto& p : gBinary) {
+        if (!wanted(p.name)) continue;
+        sweep_report r = sweepBitwiseMethod(p.name, p.f, p.m, bits, threads);
+        std::cout << r << std::endl;
+        sound = sound && (r.unsound == 0);
+    }
+    return sound ? 0 : 1;
+}